@@ -0,0 +1,110 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   EqualizerBenchmark.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "BiquadCascade.h"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace
+{
+constexpr double SampleRate    = 48000.0;
+constexpr int    NumChannels   = 2;
+constexpr int    NumBands      = 30;
+constexpr int    SamplesPerRun = 1 << 20;
+constexpr int    NumRuns       = 7;
+
+//======================================================================================================================
+template<class SampleType>
+double measure(int numActiveBands, int blockSize)
+{
+    // Active bands are spread over the full set, so the compaction has to skip the gaps between them
+    std::vector<BiquadCoefficients> bands(NumBands);
+
+    for (int i = 0; i < numActiveBands; ++i)
+    {
+        const double frequency = 40.0 * std::pow(2.0, 9.0 * i / juce::jmax(1, numActiveBands - 1));
+        bands[static_cast<std::size_t>(i * NumBands / numActiveBands)]
+            = BiquadCoefficients::makePeak(SampleRate, frequency, 1.4, i % 2 == 0 ? 2.0 : 0.5);
+    }
+
+    BiquadCascade<SampleType> cascade;
+    cascade.prepare(blockSize);
+    cascade.setSections(bands.data(), NumBands);
+
+    std::vector<std::vector<SampleType>> channels(NumChannels, std::vector<SampleType>(
+                                                      static_cast<std::size_t>(blockSize)));
+    std::vector<SampleType*> pointers;
+
+    for (std::vector<SampleType> &channel : channels)
+    {
+        for (std::size_t i = 0; i < channel.size(); ++i)
+        {
+            channel[i] = static_cast<SampleType>((i * 7919 % 2000) / 1000.0 - 1.0);
+        }
+
+        pointers.emplace_back(channel.data());
+    }
+
+    // The best of a few runs, anything slower than that was the machine doing something else
+    const int num_blocks = SamplesPerRun / blockSize;
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < NumRuns; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_blocks; ++i)
+        {
+            cascade.process(pointers.data(), NumChannels, blockSize);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / (static_cast<double>(num_blocks) * blockSize));
+    }
+
+    return best;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    std::printf("EffectEqualizer cascade, %d channels, ns per sample frame\n\n", NumChannels);
+    std::printf("%-6s %-6s %10s %10s\n", "bands", "block", "float", "double");
+
+    for (const int num_bands : { 1, 10, 30 })
+    {
+        for (const int block_size : { 64, 1024 })
+        {
+            std::printf("%-6d %-6d %10.2f %10.2f\n", num_bands, block_size, measure<float>(num_bands, block_size),
+                        measure<double>(num_bands, block_size));
+        }
+    }
+
+    return 0;
+}
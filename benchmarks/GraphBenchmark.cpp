@@ -0,0 +1,172 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   GraphBenchmark.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "BiquadCascade.h"
+#include "ModuleGraph.h"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr double SampleRate    = 48000.0;
+constexpr int    NumChannels   = 2;
+constexpr int    BlockSize     = 256;
+constexpr int    NumBands      = 10;
+constexpr int    NumBranches   = 8;
+constexpr int    BranchDepth   = 4;
+constexpr int    SamplesPerRun = 1 << 17;
+constexpr int    NumRuns       = 7;
+
+//======================================================================================================================
+// Stands in for jaut::SfxUnit, calls go through the vtable just like they do for the real modules
+class BenchmarkModule
+{
+public:
+    virtual ~BenchmarkModule() = default;
+    virtual void processEffect(int index, juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiBuffer) = 0;
+};
+
+// Ten band equalizer instances, one per node as the graph may run any two nodes at the same time
+class EqualizerModule final : public BenchmarkModule
+{
+public:
+    explicit EqualizerModule(int numInstances)
+        : cascades(static_cast<std::size_t>(numInstances))
+    {
+        BiquadCoefficients bands[NumBands];
+
+        for (int i = 0; i < NumBands; ++i)
+        {
+            bands[i] = BiquadCoefficients::makePeak(SampleRate, 40.0 * std::pow(2.0, i), 1.4, i % 2 == 0 ? 2.0 : 0.5);
+        }
+
+        for (BiquadCascade<float> &cascade : cascades)
+        {
+            cascade.prepare(BlockSize);
+            cascade.setSections(bands, NumBands);
+        }
+    }
+
+    void processEffect(int index, juce::AudioBuffer<float> &buffer, juce::MidiBuffer&) override
+    {
+        cascades[static_cast<std::size_t>(index)].process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                          buffer.getNumSamples());
+    }
+
+private:
+    std::vector<BiquadCascade<float>> cascades;
+};
+
+//======================================================================================================================
+// NumBranches parallel chains of BranchDepth modules, split from the input and summed into one last module,
+// about what a multiband setup would look like
+double measure(int numWorkers)
+{
+    using Graph = ModuleGraph<float, BenchmarkModule>;
+
+    EqualizerModule module(NumBranches * BranchDepth + 1);
+    std::vector<Graph::Node> nodes;
+    std::vector<Graph::Edge> edges;
+
+    nodes.push_back({ nullptr, 0 });
+
+    for (int branch = 0; branch < NumBranches; ++branch)
+    {
+        for (int i = 0; i < BranchDepth; ++i)
+        {
+            const int node = static_cast<int>(nodes.size());
+            nodes.push_back({ &module, branch * BranchDepth + i });
+            edges.emplace_back(i == 0 ? 0 : node - 1, node);
+        }
+    }
+
+    const int sum = static_cast<int>(nodes.size());
+    nodes.push_back({ &module, NumBranches * BranchDepth });
+
+    for (int branch = 0; branch < NumBranches; ++branch)
+    {
+        edges.emplace_back(1 + branch * BranchDepth + BranchDepth - 1, sum);
+    }
+
+    Graph graph;
+    graph.setGraph(nodes, edges);
+    graph.prepare(NumChannels, BlockSize, 0, numWorkers);
+
+    juce::AudioBuffer<float> buffer(NumChannels, BlockSize);
+
+    // The best of a few runs, anything slower than that was the machine doing something else
+    const int num_blocks = SamplesPerRun / BlockSize;
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < NumRuns; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_blocks; ++i)
+        {
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                for (int s = 0; s < BlockSize; ++s)
+                {
+                    buffer.setSample(ch, s, static_cast<float>((s * 7919 % 2000) / 1000.0 - 1.0));
+                }
+            }
+
+            graph.process(buffer);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / (static_cast<double>(num_blocks) * BlockSize));
+    }
+
+    return best;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    const int max_workers = juce::jmax(GraphWorkerPool::getDefaultNumWorkers(), 1);
+
+    std::printf("ModuleGraph, %d branches of %d modules, %d channels, block of %d\n", NumBranches, BranchDepth,
+                NumChannels, BlockSize);
+    std::printf("ns per sample frame by the number of threads, the audio thread included\n\n");
+    std::printf("%-8s %10s %8s\n", "threads", "ns", "speedup");
+
+    const double single = measure(0);
+    std::printf("%-8d %10.2f %7.2fx\n", 1, single, 1.0);
+
+    for (int workers = 1; workers <= max_workers; ++workers)
+    {
+        const double time = measure(workers);
+        std::printf("%-8d %10.2f %7.2fx\n", workers + 1, time, single / time);
+    }
+
+    return 0;
+}
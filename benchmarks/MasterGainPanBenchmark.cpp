@@ -0,0 +1,145 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MasterGainPanBenchmark.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "MasterGainPan.h"
+#include "PanningLaws.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+constexpr double SampleRate    = 48000.0;
+constexpr int    NumChannels   = 2;
+constexpr int    SamplesPerRun = 1 << 20;
+constexpr int    NumRuns       = 7;
+
+//======================================================================================================================
+// The stage as it was before, one table lookup per channel and block and one linear ramp across the whole block
+class PerBlockGainPan
+{
+public:
+    void setTargets(float newGain, float newPanning, int newPanMode) noexcept
+    {
+        gain    = newGain;
+        panning = newPanning;
+        panMode = newPanMode;
+    }
+
+    void process(juce::AudioBuffer<float> &buffer) noexcept
+    {
+        for (int i = 0; i < buffer.getNumChannels(); ++i)
+        {
+            const float current_gain = gain * panlaw::getGain(panMode, i == 0 ? -1.0f : 1.0f, panning);
+
+            if (current_gain == previousGain[i])
+            {
+                buffer.applyGain(i, 0, buffer.getNumSamples(), current_gain);
+            }
+            else
+            {
+                buffer.applyGainRamp(i, 0, buffer.getNumSamples(), previousGain[i], current_gain);
+                previousGain[i] = current_gain;
+            }
+        }
+    }
+
+private:
+    float previousGain[NumChannels] { 0.0f, 0.0f };
+    float gain    { 1.0f };
+    float panning { 0.0f };
+    int   panMode { 0 };
+};
+
+//======================================================================================================================
+template<class Stage>
+double measure(Stage &stage, int blockSize, bool automated)
+{
+    juce::AudioBuffer<float> buffer(NumChannels, blockSize);
+
+    auto fill = [&buffer]()
+    {
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                buffer.setSample(ch, i, static_cast<float>((i * 7919 % 2000) / 1000.0 - 1.0));
+            }
+        }
+    };
+
+    // The best of a few runs, anything slower than that was the machine doing something else
+    const int num_blocks = SamplesPerRun / blockSize;
+    double best = 0.0;
+
+    for (int run = 0; run < NumRuns; ++run)
+    {
+        fill();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_blocks; ++i)
+        {
+            // Automation sweeps both targets with every block, the way hosts send heavily automated parameters
+            const float sweep = automated ? static_cast<float>(i % 64) / 63.0f : 0.5f;
+            stage.setTargets(0.25f + sweep * 0.5f, sweep * 2.0f - 1.0f, panlaw::ConstantPower);
+            stage.process(buffer);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, static_cast<double>(num_blocks) * blockSize * NumChannels / elapsed.count());
+    }
+
+    return best;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    std::printf("Master gain/pan, %d channels at %.0f Hz, samples per ns (higher is better)\n\n", NumChannels,
+                SampleRate);
+    std::printf("%-10s %-6s %12s %12s %9s\n", "targets", "block", "per block", "vectorised", "speed-up");
+
+    for (const bool automated : { false, true })
+    {
+        for (const int block_size : { 32, 256, 2048 })
+        {
+            PerBlockGainPan per_block;
+
+            MasterGainPan<float> vectorised;
+            vectorised.prepare(SampleRate, block_size, juce::AudioChannelSet::stereo());
+            vectorised.reset(0.5f, 0.0f, panlaw::ConstantPower);
+
+            const double per_block_rate  = measure(per_block,  block_size, automated);
+            const double vectorised_rate = measure(vectorised, block_size, automated);
+            std::printf("%-10s %-6d %12.3f %12.3f %8.2fx\n", automated ? "automated" : "static", block_size,
+                        per_block_rate, vectorised_rate, vectorised_rate / per_block_rate);
+        }
+    }
+
+    return 0;
+}
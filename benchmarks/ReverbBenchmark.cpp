@@ -0,0 +1,131 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ReverbBenchmark.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "FdnReverb.h"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr double SampleRate    = 48000.0;
+constexpr int    NumChannels   = 2;
+constexpr int    SamplesPerRun = 1 << 18;
+constexpr int    NumRuns       = 5;
+
+//======================================================================================================================
+template<class SampleType>
+double measure(int numInstances, int blockSize)
+{
+    // Every instance gets its own arena, as in a session; with many of them the lines stop fitting into the cache
+    std::vector<std::unique_ptr<FdnReverb<SampleType>>> reverbs;
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        FdnReverbParameters parameters;
+        parameters.size         = 0.3 + 0.7 * i / juce::jmax(1, numInstances - 1);
+        parameters.decaySeconds = 1.0 + i % 4;
+
+        auto &reverb = *reverbs.emplace_back(std::make_unique<FdnReverb<SampleType>>());
+        reverb.prepare(SampleRate);
+        reverb.setParameters(parameters);
+    }
+
+    std::vector<std::vector<SampleType>> channels(NumChannels, std::vector<SampleType>(
+                                                      static_cast<std::size_t>(blockSize)));
+    std::vector<SampleType*> pointers;
+
+    for (std::vector<SampleType> &channel : channels)
+    {
+        pointers.emplace_back(channel.data());
+    }
+
+    auto fill = [&channels]()
+    {
+        for (std::vector<SampleType> &channel : channels)
+        {
+            for (std::size_t i = 0; i < channel.size(); ++i)
+            {
+                channel[i] = static_cast<SampleType>((i * 7919 % 2000) / 1000.0 - 1.0);
+            }
+        }
+    };
+
+    // The best of a few runs, anything slower than that was the machine doing something else
+    const int num_blocks = SamplesPerRun / blockSize;
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < NumRuns; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_blocks; ++i)
+        {
+            // Each instance processes its own copy of the input, like parallel sends would
+            for (auto &reverb : reverbs)
+            {
+                fill();
+                reverb->process(pointers.data(), NumChannels, blockSize);
+            }
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / (static_cast<double>(num_blocks) * blockSize * numInstances));
+    }
+
+    return best;
+}
+
+/** The share of one core an instance takes to keep up with real time, in percent. */
+double getCorePercent(double nanosecondsPerFrame)
+{
+    return nanosecondsPerFrame * SampleRate / 1.0e9 * 100.0;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    std::printf("FdnReverb, %d lines, %d channels at %.0f Hz, ns per sample frame and instance "
+                "(%% of one core per instance)\n\n", FdnReverb<float>::NumLines, NumChannels, SampleRate);
+    std::printf("%-10s %-6s %18s %18s\n", "instances", "block", "float", "double");
+
+    for (const int num_instances : { 1, 8, 32 })
+    {
+        for (const int block_size : { 64, 1024 })
+        {
+            const double float_time  = measure<float> (num_instances, block_size);
+            const double double_time = measure<double>(num_instances, block_size);
+            std::printf("%-10d %-6d %9.2f (%5.2f%%) %9.2f (%5.2f%%)\n", num_instances, block_size,
+                        float_time, getCorePercent(float_time), double_time, getCorePercent(double_time));
+        }
+    }
+
+    return 0;
+}
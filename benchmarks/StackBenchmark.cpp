@@ -0,0 +1,158 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   StackBenchmark.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "BiquadCascade.h"
+#include "ModuleStack.h"
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr double SampleRate    = 48000.0;
+constexpr int    NumChannels   = 2;
+constexpr int    BlockSize     = 256;
+constexpr int    NumBands      = 10;
+constexpr int    SamplesPerRun = 1 << 18;
+constexpr int    NumRuns       = 7;
+
+//======================================================================================================================
+// Stands in for jaut::SfxUnit, calls go through the vtable just like they do for the real modules
+class BenchmarkModule
+{
+public:
+    virtual ~BenchmarkModule() = default;
+    virtual void processEffect(int index, juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiBuffer) = 0;
+};
+
+// A ten band equalizer instance, about what a typical light module costs
+class EqualizerModule final : public BenchmarkModule
+{
+public:
+    EqualizerModule()
+    {
+        BiquadCoefficients bands[NumBands];
+
+        for (int i = 0; i < NumBands; ++i)
+        {
+            bands[i] = BiquadCoefficients::makePeak(SampleRate, 40.0 * std::pow(2.0, i), 1.4, i % 2 == 0 ? 2.0 : 0.5);
+        }
+
+        cascade.prepare(BlockSize);
+        cascade.setSections(bands, NumBands);
+    }
+
+    void processEffect(int, juce::AudioBuffer<float> &buffer, juce::MidiBuffer&) override
+    {
+        cascade.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+    }
+
+private:
+    BiquadCascade<float> cascade;
+};
+
+//======================================================================================================================
+double measure(int depth, float mix)
+{
+    std::vector<std::unique_ptr<EqualizerModule>> modules;
+    std::vector<ModuleStack<float, BenchmarkModule>::Slot> slots;
+
+    for (int i = 0; i < depth; ++i)
+    {
+        modules.emplace_back(std::make_unique<EqualizerModule>());
+        slots.push_back({ modules.back().get(), 0 });
+    }
+
+    ModuleStack<float, BenchmarkModule> stack;
+    stack.setSlots(slots);
+
+    for (int i = 0; i < depth; ++i)
+    {
+        stack.setMix(i, mix);
+    }
+
+    stack.prepare(NumChannels, BlockSize, 0);
+
+    juce::AudioBuffer<float> buffer(NumChannels, BlockSize);
+
+    for (int ch = 0; ch < NumChannels; ++ch)
+    {
+        for (int i = 0; i < BlockSize; ++i)
+        {
+            buffer.setSample(ch, i, static_cast<float>((i * 7919 % 2000) / 1000.0 - 1.0));
+        }
+    }
+
+    // The best of a few runs, anything slower than that was the machine doing something else
+    const int num_blocks = SamplesPerRun / BlockSize;
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < NumRuns; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_blocks; ++i)
+        {
+            stack.process(buffer);
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / (static_cast<double>(num_blocks) * BlockSize));
+    }
+
+    return best;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    // One sample frame at 48kHz has to be done in this many nanoseconds for the stack to keep up in realtime
+    constexpr double budget = 1e9 / SampleRate;
+
+    std::printf("ModuleStack, %d band equalizer per module, %d channels, block of %d\n", NumBands, NumChannels,
+                BlockSize);
+    std::printf("ns per sample frame and share of one core at %.0fHz\n\n", SampleRate);
+    std::printf("%-6s %10s %8s %10s %8s\n", "depth", "wet", "core", "mixed", "core");
+
+    double wet_per_module = 0.0;
+
+    for (const int depth : { 1, 2, 4, 8, 16, 32, 64 })
+    {
+        const double wet   = measure(depth, 1.0f);
+        const double mixed = measure(depth, 0.5f);
+        wet_per_module     = wet / depth;
+
+        std::printf("%-6d %10.2f %7.2f%% %10.2f %7.2f%%\n", depth, wet, 100.0 * wet / budget, mixed,
+                    100.0 * mixed / budget);
+    }
+
+    std::printf("\nAbout %d fully wet modules of this weight fit into one core\n",
+                static_cast<int>(budget / wet_per_module));
+    return 0;
+}
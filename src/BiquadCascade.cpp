@@ -0,0 +1,505 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   BiquadCascade.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "BiquadCascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr double Pi = 3.14159265358979323846;
+
+//======================================================================================================================
+/**
+ *  Sine and cosine of an angle between 0 and pi.
+ *  The angle is folded into the first octant, where Taylor series to x^12 stay below 1e-11 absolute error and get
+ *  more precise the smaller the angle, which is what low frequency bands with their poles close to 1 depend on.
+ */
+void fastSinCos(double x, double &sine, double &cosine) noexcept
+{
+    const bool upper_half = x > Pi * 0.5;
+    x = upper_half ? Pi - x : x;
+
+    const bool upper_octant = x > Pi * 0.25;
+    x = upper_octant ? Pi * 0.5 - x : x;
+
+    const double x2 = x * x;
+    const double s  = x * (1.0 + x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0 + x2 * (1.0 / 362880.0
+                         + x2 * (-1.0 / 39916800.0))))));
+    const double c  = 1.0 + x2 * (-0.5 + x2 * (1.0 / 24.0 + x2 * (-1.0 / 720.0 + x2 * (1.0 / 40320.0
+                         + x2 * (-1.0 / 3628800.0 + x2 * (1.0 / 479001600.0))))));
+
+    sine   = upper_octant ? c : s;
+    cosine = upper_octant ? s : c;
+    cosine = upper_half ? -cosine : cosine;
+}
+}
+
+//======================================================================================================================
+BiquadCoefficients BiquadCoefficients::makePeak(double sampleRate, double frequency, double q, double gain) noexcept
+{
+    // Full cuts would leave a zero on the unit circle, no use to anyone mixing and bad for the filter's state
+    constexpr double min_gain = 0.031622776601683794;
+
+    double sin0, cos0;
+    fastSinCos(2.0 * Pi * std::clamp(frequency, 0.0, sampleRate * 0.49) / sampleRate, sin0, cos0);
+
+    const double a       = std::sqrt(std::max(gain, min_gain));
+    const double alpha   = sin0 / (2.0 * std::max(q, 1e-3));
+    const double inv_a0  = 1.0 / (1.0 + alpha / a);
+
+    BiquadCoefficients result;
+    result.b0 = (1.0 + alpha * a) * inv_a0;
+    result.b1 = -2.0 * cos0 * inv_a0;
+    result.b2 = (1.0 - alpha * a) * inv_a0;
+    result.a1 = result.b1;
+    result.a2 = (1.0 - alpha / a) * inv_a0;
+    return result;
+}
+
+int BiquadCoefficients::getTailSamples(double attenuationDb) const noexcept
+{
+    if (isIdentity())
+    {
+        return 0;
+    }
+
+    // Complex pole pairs both sit at a radius of sqrt(a2), real ones are found directly
+    const double discriminant = a1 * a1 - 4.0 * a2;
+    const double radius       = discriminant < 0.0
+                                    ? std::sqrt(a2)
+                                    : (std::abs(a1) + std::sqrt(discriminant)) * 0.5;
+
+    if (radius < 1e-9)
+    {
+        return 2;
+    }
+
+    if (radius >= 1.0)
+    {
+        return std::numeric_limits<int>::max();
+    }
+
+    const double samples = -attenuationDb / (20.0 * std::log10(radius));
+    return static_cast<int>(std::min(std::ceil(samples) + 2.0, static_cast<double>(std::numeric_limits<int>::max())));
+}
+
+//======================================================================================================================
+template<class SampleType>
+BiquadCascade<SampleType>::BiquadCascade()
+{
+    for (ChainState &chain : chains)
+    {
+        chain.coefficients.allocate(static_cast<std::size_t>(MaxSections * NumCoefficients * NumLanes));
+        chain.increments  .allocate(static_cast<std::size_t>(MaxSections * NumCoefficients * NumLanes));
+        chain.states      .allocate(static_cast<std::size_t>(MaxSections * NumGroups * 2 * NumLanes));
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void BiquadCascade<SampleType>::prepare(int maximumBlockSize)
+{
+    scratchSize = std::max(1, maximumBlockSize);
+    scratch.allocate(static_cast<std::size_t>(scratchSize * NumLanes));
+    reset();
+}
+
+template<class SampleType>
+void BiquadCascade<SampleType>::reset() noexcept
+{
+    SampleType *const states = chains[static_cast<std::size_t>(activeChain)].states.get();
+    std::fill(states, states + MaxSections * NumGroups * 2 * NumLanes, SampleType());
+}
+
+//======================================================================================================================
+template<class SampleType>
+void BiquadCascade<SampleType>::setSections(const BiquadCoefficients *bands, int newNumBands, int rampSamples) noexcept
+{
+    jassert(newNumBands <= MaxSections);
+
+    numBands = std::min(newNumBands, MaxSections);
+
+    // Any identity becomes the one without feedback, which bands fading out then leave with an empty state
+    std::transform(bands, bands + numBands, targets.begin(), [](const BiquadCoefficients &band)
+    {
+        return band.isIdentity() ? BiquadCoefficients() : band;
+    });
+
+    flushing = false;
+    rebuildChain(rampSamples, rampSamples > 0);
+}
+
+template<class SampleType>
+int BiquadCascade<SampleType>::rebuildChain(int rampSamples, bool keepFading) noexcept
+{
+    ChainState &old_chain  = chains[static_cast<std::size_t>(activeChain)];
+    ChainState &new_chain  = chains[static_cast<std::size_t>(activeChain ^ 1)];
+    const int old_sections = numSections;
+    const bool ramping     = rampSamples > 0;
+
+    int num_fading = 0;
+    numSections = 0;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const BiquadCoefficients &target = targets[static_cast<std::size_t>(band)];
+
+        const auto begin    = old_chain.bands.begin();
+        const auto found    = std::find(begin, begin + old_sections, band);
+        const int  previous = (found != begin + old_sections ? static_cast<int>(found - begin) : -1);
+
+        // A band on its way out stays in the chain until it has faded to an identity and its state ran out
+        if (target.isIdentity())
+        {
+            if (previous < 0 || !keepFading)
+            {
+                continue;
+            }
+
+            ++num_fading;
+        }
+
+        const int section = numSections++;
+        new_chain.bands[static_cast<std::size_t>(section)] = band;
+
+        SampleType *const current   = getCoefficients(new_chain, section);
+        SampleType *const increment = getIncrements(new_chain, section);
+
+        if (previous >= 0)
+        {
+            const SampleType *const old_current = getCoefficients(old_chain, previous);
+            std::copy(old_current, old_current + NumCoefficients * NumLanes, current);
+        }
+        else
+        {
+            // New bands fade in from an identity, or jump right to their target if there is no ramp
+            setCoefficients(current, ramping ? BiquadCoefficients() : target);
+        }
+
+        if (ramping)
+        {
+            const double values[NumCoefficients] { target.b0, target.b1, target.b2, target.a1, target.a2 };
+
+            // The stable region of a1 and a2 is convex, so every filter on the straight way between two stable
+            // filters is stable as well
+            for (int i = 0; i < NumCoefficients; ++i)
+            {
+                const auto step = static_cast<SampleType>((values[i] - static_cast<double>(current[i * NumLanes]))
+                                                          / rampSamples);
+                std::fill(increment + i * NumLanes, increment + (i + 1) * NumLanes, step);
+            }
+        }
+        else
+        {
+            setCoefficients(current, target);
+            std::fill(increment, increment + NumCoefficients * NumLanes, SampleType());
+        }
+
+        for (int group = 0; group < NumGroups; ++group)
+        {
+            SampleType *const states = getStates(new_chain, section, group);
+
+            if (previous >= 0)
+            {
+                const SampleType *const old_states = getStates(old_chain, previous, group);
+                std::copy(old_states, old_states + 2 * NumLanes, states);
+            }
+            else
+            {
+                std::fill(states, states + 2 * NumLanes, SampleType());
+            }
+        }
+    }
+
+    activeChain  ^= 1;
+    rampRemaining = (ramping && numSections > 0 ? rampSamples : 0);
+    return num_fading;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void BiquadCascade<SampleType>::process(SampleType *const *channels, int numChannels, int numSamples) noexcept
+{
+    jassert(numChannels <= MaxChannels);
+    jassert(scratchSize > 0);
+
+    if (scratchSize == 0)
+    {
+        return;
+    }
+
+    numChannels = std::min(numChannels, MaxChannels);
+
+    for (int start = 0; start < numSamples; start += scratchSize)
+    {
+        const int chunk_size = std::min(scratchSize, numSamples - start);
+        const int ramp_size  = std::min(rampRemaining, chunk_size);
+
+        // All groups have to go through the same stretch of the ramp before it can be advanced
+        if (ramp_size > 0)
+        {
+            for (int first_channel = 0; first_channel < numChannels; first_channel += NumLanes)
+            {
+                processGroup<true>(channels, first_channel, std::min(NumLanes, numChannels - first_channel), start,
+                                   ramp_size);
+            }
+
+            advanceRamp(ramp_size);
+        }
+
+        if (chunk_size > ramp_size && numSections > 0)
+        {
+            for (int first_channel = 0; first_channel < numChannels; first_channel += NumLanes)
+            {
+                processGroup<false>(channels, first_channel, std::min(NumLanes, numChannels - first_channel),
+                                    start + ramp_size, chunk_size - ramp_size);
+            }
+        }
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void BiquadCascade<SampleType>::setCoefficients(SampleType *destination, const BiquadCoefficients &source) noexcept
+{
+    const double values[NumCoefficients] { source.b0, source.b1, source.b2, source.a1, source.a2 };
+
+    // Stored pre-broadcast, so the kernel gets along with plain vector loads
+    for (int i = 0; i < NumCoefficients; ++i)
+    {
+        std::fill(destination + i * NumLanes, destination + (i + 1) * NumLanes, static_cast<SampleType>(values[i]));
+    }
+}
+
+template<class SampleType>
+void BiquadCascade<SampleType>::advanceRamp(int numSamples) noexcept
+{
+    rampRemaining -= numSamples;
+
+    if (rampRemaining <= 0)
+    {
+        // Lands exactly on the targets, bands that faded out have two more samples to run their state out to zero,
+        // after that they are dropped
+        if (!flushing && rebuildChain(0, true) > 0)
+        {
+            flushing      = true;
+            rampRemaining = 2;
+        }
+        else if (flushing)
+        {
+            flushing = false;
+            rebuildChain(0, false);
+        }
+
+        return;
+    }
+
+    ChainState &chain = chains[static_cast<std::size_t>(activeChain)];
+    const auto steps  = static_cast<SampleType>(numSamples);
+
+    for (int section = 0; section < numSections; ++section)
+    {
+        SampleType *const current         = getCoefficients(chain, section);
+        const SampleType *const increment = getIncrements(chain, section);
+
+        for (int i = 0; i < NumCoefficients * NumLanes; ++i)
+        {
+            current[i] += increment[i] * steps;
+        }
+    }
+}
+
+template<class SampleType>
+template<bool Ramping>
+void BiquadCascade<SampleType>::processGroup(SampleType *const *channels, int firstChannel, int numChannels,
+                                             int start, int numSamples) noexcept
+{
+    SampleType *const lanes = scratch.get();
+
+    // Unused lanes run on silence, they are cheaper to filter than to branch around
+    if (numChannels < NumLanes)
+    {
+        std::fill(lanes, lanes + numSamples * NumLanes, SampleType());
+    }
+
+    for (int lane = 0; lane < numChannels; ++lane)
+    {
+        const SampleType *const source = channels[firstChannel + lane] + start;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            lanes[i * NumLanes + lane] = source[i];
+        }
+    }
+
+    ChainState &chain = chains[static_cast<std::size_t>(activeChain)];
+    const int group = firstChannel / NumLanes;
+    int section = 0;
+
+    for (; section + PassSize <= numSections; section += PassSize)
+    {
+        processSections<Ramping>(chain, group, section, lanes, numSamples, std::make_integer_sequence<int, PassSize>());
+    }
+
+    switch (numSections - section)
+    {
+        case 3: processSections<Ramping>(chain, group, section, lanes, numSamples, std::make_integer_sequence<int, 3>());
+                break;
+        case 2: processSections<Ramping>(chain, group, section, lanes, numSamples, std::make_integer_sequence<int, 2>());
+                break;
+        case 1: processSections<Ramping>(chain, group, section, lanes, numSamples, std::make_integer_sequence<int, 1>());
+                break;
+        default: break;
+    }
+
+    for (int lane = 0; lane < numChannels; ++lane)
+    {
+        SampleType *const destination = channels[firstChannel + lane] + start;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            destination[i] = lanes[i * NumLanes + lane];
+        }
+    }
+}
+
+template<class SampleType>
+template<bool Ramping, int ...Stages>
+void BiquadCascade<SampleType>::processSections(ChainState &chain, int group, int firstSection, SampleType *lanes,
+                                                int numSamples, std::integer_sequence<int, Stages...>) noexcept
+{
+    constexpr int num_stages = static_cast<int>(sizeof...(Stages));
+
+    Vec b0[num_stages], b1[num_stages], b2[num_stages], a1[num_stages], a2[num_stages];
+    Vec db0[num_stages], db1[num_stages], db2[num_stages], da1[num_stages], da2[num_stages];
+    Vec s1[num_stages], s2[num_stages];
+    Vec carry[num_stages];
+
+    for (int k = 0; k < num_stages; ++k)
+    {
+        const SampleType *const c = getCoefficients(chain, firstSection + k);
+        b0[k] = Vec::load(c);
+        b1[k] = Vec::load(c + NumLanes);
+        b2[k] = Vec::load(c + 2 * NumLanes);
+        a1[k] = Vec::load(c + 3 * NumLanes);
+        a2[k] = Vec::load(c + 4 * NumLanes);
+
+        if constexpr (Ramping)
+        {
+            const SampleType *const d = getIncrements(chain, firstSection + k);
+            db0[k] = Vec::load(d);
+            db1[k] = Vec::load(d + NumLanes);
+            db2[k] = Vec::load(d + 2 * NumLanes);
+            da1[k] = Vec::load(d + 3 * NumLanes);
+            da2[k] = Vec::load(d + 4 * NumLanes);
+        }
+
+        const SampleType *const states = getStates(chain, firstSection + k, group);
+        s1[k] = Vec::load(states);
+        s2[k] = Vec::load(states + NumLanes);
+    }
+
+    // Stage k works on sample i - k, so the recurrences of the pass are independent of each other within a step.
+    // Stages are expanded at compile time so that all of their state can stay in registers.
+    const auto stage = [&](auto index, int i, bool checked) noexcept
+    {
+        constexpr int k = decltype(index)::value;
+        const int sample = i - k;
+
+        if (checked && (sample < 0 || sample >= numSamples))
+        {
+            return;
+        }
+
+        // Each stage steps its own coefficients, so that every sample sees those belonging to its own position
+        if constexpr (Ramping)
+        {
+            b0[k] = b0[k] + db0[k];
+            b1[k] = b1[k] + db1[k];
+            b2[k] = b2[k] + db2[k];
+            a1[k] = a1[k] + da1[k];
+            a2[k] = a2[k] + da2[k];
+        }
+
+        const Vec x = (k == 0 ? Vec::load(lanes + sample * NumLanes) : carry[juce::jmax(0, k - 1)]);
+        const Vec y = b0[k] * x + s1[k];
+        s1[k] = b1[k] * x - a1[k] * y + s2[k];
+        s2[k] = b2[k] * x - a2[k] * y;
+
+        if (k == num_stages - 1)
+        {
+            y.store(lanes + sample * NumLanes);
+        }
+        else
+        {
+            carry[k] = y;
+        }
+    };
+
+    // Later stages go first, each of them has to take its input before the stage in front overwrites it
+    const auto step = [&](int i, bool checked) noexcept
+    {
+        (stage(std::integral_constant<int, num_stages - 1 - Stages>(), i, checked), ...);
+    };
+
+    // Only the steps at either end of the block have stages without a sample, they alone check their range
+    for (int i = 0; i < numSamples + num_stages - 1; ++i)
+    {
+        step(i, i < num_stages - 1 || i >= numSamples);
+    }
+
+    for (int k = 0; k < num_stages; ++k)
+    {
+        SampleType *const states = getStates(chain, firstSection + k, group);
+        s1[k].store(states);
+        s2[k].store(states + NumLanes);
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+SampleType* BiquadCascade<SampleType>::getCoefficients(ChainState &chain, int section) noexcept
+{
+    return chain.coefficients.get() + section * NumCoefficients * NumLanes;
+}
+
+template<class SampleType>
+SampleType* BiquadCascade<SampleType>::getIncrements(ChainState &chain, int section) noexcept
+{
+    return chain.increments.get() + section * NumCoefficients * NumLanes;
+}
+
+template<class SampleType>
+SampleType* BiquadCascade<SampleType>::getStates(ChainState &chain, int section, int group) noexcept
+{
+    return chain.states.get() + (section * NumGroups + group) * 2 * NumLanes;
+}
+
+//======================================================================================================================
+template class BiquadCascade<float>;
+template class BiquadCascade<double>;
@@ -0,0 +1,161 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   BiquadCascade.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include "SimdOps.h"
+
+#include <array>
+#include <utility>
+
+/** The coefficients of a single biquad section, normalised so that a0 is 1. */
+struct BiquadCoefficients
+{
+    double b0 { 1.0 };
+    double b1 { 0.0 };
+    double b2 { 0.0 };
+    double a1 { 0.0 };
+    double a2 { 0.0 };
+
+    //==================================================================================================================
+    /**
+     *  Designs a peaking filter as in the RBJ audio EQ cookbook.
+     *
+     *  @param sampleRate The sample rate
+     *  @param frequency  The centre frequency in Hz
+     *  @param q          The quality of the bell
+     *  @param gain       The linear gain at the centre frequency
+     */
+    static BiquadCoefficients makePeak(double sampleRate, double frequency, double q, double gain) noexcept;
+
+    //==================================================================================================================
+    /** Determines whether this section passes the signal through unchanged. */
+    bool isIdentity() const noexcept { return b0 == 1.0 && b1 == a1 && b2 == a2; }
+
+    /**
+     *  Estimates how long the impulse response of this section rings, from the magnitude of its largest pole.
+     *
+     *  @param attenuationDb How far below its start the response has to have decayed, a positive number of dB
+     *  @return The number of samples until the response decayed that far
+     */
+    int getTailSamples(double attenuationDb = 120.0) const noexcept;
+};
+
+/**
+ *  A cascade of biquads in transposed direct form II, laid out as structure of arrays.
+ *
+ *  Every SIMD lane carries one channel, so a float vector filters four channels at once and a double vector two.
+ *  Channels are interleaved into lane order per block and then run through the sections four at a time, with each
+ *  section of a pass one sample behind the one before it. That way the four recurrences of a pass don't wait for each
+ *  other and the CPU can overlap them, instead of every section stalling on the output of the previous one.
+ *
+ *  Sections which are identities are compacted out of the chain when it is set, so the cost follows the number of bands
+ *  actually in use rather than the number of bands there are. Sections remember which band they came from, so a band
+ *  keeps its filter state while others come and go.
+ *
+ *  New coefficients can be ramped to linearly, sample by sample. Bands joining the chain then fade in from an identity
+ *  and bands leaving it fade out to one, and are only compacted out once the ramp is done.
+ *
+ *  Filter state and coefficients are allocated on construction and the interleaving scratch in prepare, after that
+ *  processing and changing sections are realtime safe.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class BiquadCascade final
+{
+public:
+    using Vec = simd::Vec<SampleType>;
+
+    static constexpr int MaxSections = 32;
+    static constexpr int MaxChannels = 16;
+    static constexpr int NumLanes    = Vec::Size;
+
+    //==================================================================================================================
+    BiquadCascade();
+
+    //==================================================================================================================
+    void prepare(int maximumBlockSize);
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /**
+     *  Replaces the chain by the given bands, leaving out those that are identities.
+     *  Bands that were in the chain before keep their state, new ones start from silence.
+     *
+     *  @param bands       The bands, at most MaxSections
+     *  @param numBands    The number of bands
+     *  @param rampSamples The number of samples to get from the current coefficients to the new ones, or 0 to jump
+     */
+    void setSections(const BiquadCoefficients *bands, int numBands, int rampSamples = 0) noexcept;
+
+    int getNumActiveSections() const noexcept { return numSections; }
+    bool isRamping() const noexcept { return rampRemaining > 0; }
+
+    //==================================================================================================================
+    void process(SampleType *const *channels, int numChannels, int numSamples) noexcept;
+
+private:
+    static constexpr int NumGroups       = (MaxChannels + NumLanes - 1) / NumLanes;
+    static constexpr int NumCoefficients = 5;
+    static constexpr int PassSize        = 4;
+
+    struct ChainState
+    {
+        std::array<int, MaxSections> bands {};
+        simd::AlignedBlock<SampleType> coefficients;
+        simd::AlignedBlock<SampleType> increments;
+        simd::AlignedBlock<SampleType> states;
+    };
+
+    //==================================================================================================================
+    std::array<BiquadCoefficients, MaxSections> targets;
+    std::array<ChainState, 2> chains;
+    simd::AlignedBlock<SampleType> scratch;
+    int numBands      { 0 };
+    int activeChain   { 0 };
+    int numSections   { 0 };
+    int scratchSize   { 0 };
+    int rampRemaining { 0 };
+    bool flushing     { false };
+
+    //==================================================================================================================
+    void setCoefficients(SampleType *destination, const BiquadCoefficients&) noexcept;
+    int  rebuildChain(int rampSamples, bool keepFading) noexcept;
+    void advanceRamp(int numSamples) noexcept;
+
+    template<bool Ramping>
+    void processGroup(SampleType *const*, int firstChannel, int numChannels, int start, int numSamples) noexcept;
+
+    template<bool Ramping, int ...Stages>
+    void processSections(ChainState&, int group, int firstSection, SampleType *lanes, int numSamples,
+                         std::integer_sequence<int, Stages...>) noexcept;
+
+    SampleType* getCoefficients(ChainState &chain, int section) noexcept;
+    SampleType* getIncrements(ChainState &chain, int section) noexcept;
+    SampleType* getStates(ChainState &chain, int section, int group) noexcept;
+};
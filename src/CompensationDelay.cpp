@@ -0,0 +1,144 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   CompensationDelay.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "CompensationDelay.h"
+
+//======================================================================================================================
+template<class SampleType>
+void CompensationDelay<SampleType>::prepare(int numChannels, int maximumDelay, int maximumBlockSize)
+{
+    maxDelay = juce::jmax(0, maximumDelay);
+
+    // Room for the longest delay plus one block, so that a block can be written before it's read back
+    const int delay_size = juce::nextPowerOfTwo(maxDelay + maximumBlockSize);
+    delayMask = delay_size - 1;
+
+    delayBuffer.setSize(numChannels, delay_size);
+    delay = juce::jmin(delay, maxDelay);
+    reset();
+}
+
+template<class SampleType>
+void CompensationDelay<SampleType>::release()
+{
+    delayBuffer.setSize(0, 0);
+    delayMask = 0;
+    maxDelay  = 0;
+    delay     = 0;
+}
+
+template<class SampleType>
+void CompensationDelay<SampleType>::reset() noexcept
+{
+    delayBuffer.clear();
+    writePosition = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void CompensationDelay<SampleType>::setDelay(int delayInSamples) noexcept
+{
+    jassert(delayInSamples <= maxDelay);
+    delay = juce::jlimit(0, maxDelay, delayInSamples);
+}
+
+//======================================================================================================================
+template<class SampleType>
+void CompensationDelay<SampleType>::process(const SampleType *const *input, SampleType *const *output,
+                                            int numChannels, int numSamples) noexcept
+{
+    processBlock<false>(input, output, numChannels, numSamples);
+}
+
+template<class SampleType>
+void CompensationDelay<SampleType>::processAdding(const SampleType *const *input, SampleType *const *output,
+                                                  int numChannels, int numSamples) noexcept
+{
+    processBlock<true>(input, output, numChannels, numSamples);
+}
+
+template<class SampleType>
+void CompensationDelay<SampleType>::processAddingWithRamp(const SampleType *const *input, SampleType *const *output,
+                                                          int numChannels, int numSamples, SampleType startGain,
+                                                          SampleType endGain) noexcept
+{
+    processBlock<true>(input, output, numChannels, numSamples, startGain, endGain);
+}
+
+template<class SampleType>
+template<bool Adding>
+void CompensationDelay<SampleType>::processBlock(const SampleType *const *input, SampleType *const *output,
+                                                 int numChannels, int numSamples, SampleType startGain,
+                                                 SampleType endGain) noexcept
+{
+    jassert(isPrepared() && numChannels <= delayBuffer.getNumChannels() && numSamples <= delayMask + 1 - maxDelay);
+
+    const int delay_size    = delayMask + 1;
+    const int read_position = (writePosition - delay) & delayMask;
+
+    // Both the written and the read block may wrap around the end of the delay line, hence two runs each
+    const int write_run = juce::jmin(numSamples, delay_size - writePosition);
+    const int read_run  = juce::jmin(numSamples, delay_size - read_position);
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        SampleType *const line = delayBuffer.getWritePointer(i);
+
+        juce::FloatVectorOperations::copy(line + writePosition, input[i], write_run);
+        juce::FloatVectorOperations::copy(line, input[i] + write_run, numSamples - write_run);
+
+        if constexpr (Adding)
+        {
+            if (startGain == SampleType(1) && endGain == SampleType(1))
+            {
+                juce::FloatVectorOperations::add(output[i], line + read_position, read_run);
+                juce::FloatVectorOperations::add(output[i] + read_run, line, numSamples - read_run);
+            }
+            else if (startGain != SampleType(0) || endGain != SampleType(0))
+            {
+                // The same ramp as juce::AudioBuffer::addFromWithRamp
+                const SampleType increment = (endGain - startGain) / static_cast<SampleType>(numSamples);
+                SampleType gain = startGain;
+
+                for (int s = 0; s < numSamples; ++s)
+                {
+                    output[i][s] += line[(read_position + s) & delayMask] * gain;
+                    gain += increment;
+                }
+            }
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(output[i], line + read_position, read_run);
+            juce::FloatVectorOperations::copy(output[i] + read_run, line, numSamples - read_run);
+        }
+    }
+
+    writePosition = (writePosition + numSamples) & delayMask;
+}
+
+//======================================================================================================================
+template class CompensationDelay<float>;
+template class CompensationDelay<double>;
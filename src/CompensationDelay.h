@@ -0,0 +1,86 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   CompensationDelay.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ *  A plain integer delay for lining up signals that took paths of different latency.
+ *
+ *  The delay line is allocated for the longest delay it will ever need in prepare, after that the delay can be
+ *  changed at any time without allocating. A change jumps straight to the new position, as latency changes do.
+ *
+ *  @tparam SampleType The sample type of the delayed signal, either float or double
+ */
+template<class SampleType>
+class CompensationDelay final
+{
+public:
+    void prepare(int numChannels, int maximumDelay, int maximumBlockSize);
+    void release();
+    void reset() noexcept;
+
+    //==================================================================================================================
+    void setDelay(int delayInSamples) noexcept;
+    int getDelay() const noexcept { return delay; }
+    int getMaximumDelay() const noexcept { return maxDelay; }
+    bool isPrepared() const noexcept { return delayMask > 0; }
+
+    //==================================================================================================================
+    /**
+     *  Writes a block into the delay line and reads the block from as many samples back as the delay is.
+     *
+     *  @param input       The channels to delay
+     *  @param output      The channels to write the delayed block to, may be the same as the input
+     *  @param numChannels The number of channels, at most as many as the delay was prepared for
+     *  @param numSamples  The size of the block, at most the maximum block size the delay was prepared for
+     */
+    void process(const SampleType *const *input, SampleType *const *output, int numChannels,
+                 int numSamples) noexcept;
+
+    /** Same as process(), but adds the delayed block onto the output instead of replacing it. */
+    void processAdding(const SampleType *const *input, SampleType *const *output, int numChannels,
+                       int numSamples) noexcept;
+
+    /**
+     *  Same as processAdding(), but scales the delayed block by a gain that ramps linearly over it. With a gain of 0
+     *  all along the block is only written into the delay line, the output is left alone.
+     */
+    void processAddingWithRamp(const SampleType *const *input, SampleType *const *output, int numChannels,
+                               int numSamples, SampleType startGain, SampleType endGain) noexcept;
+
+private:
+    juce::AudioBuffer<SampleType> delayBuffer;
+    int delayMask     { 0 };
+    int writePosition { 0 };
+    int delay         { 0 };
+    int maxDelay      { 0 };
+
+    //==================================================================================================================
+    template<bool Adding>
+    void processBlock(const SampleType *const*, SampleType *const*, int, int, SampleType = SampleType(1),
+                      SampleType = SampleType(1)) noexcept;
+};
@@ -0,0 +1,415 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ConvolutionEngine.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "ConvolutionEngine.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+void pauseSpin() noexcept
+{
+#if COSSIN_SIMD_SSE
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+}
+
+//======================================================================================================================
+ConvolutionEngine::ConvolutionEngine(std::shared_ptr<const PartitionedImpulse> impulseToUse)
+    : juce::Thread("Convolution worker"),
+      impulse(std::move(impulseToUse))
+{
+    jassert(impulse != nullptr);
+}
+
+ConvolutionEngine::~ConvolutionEngine()
+{
+    stopThread(1000);
+}
+
+//======================================================================================================================
+void ConvolutionEngine::prepare(int newNumChannels)
+{
+    stopThread(1000);
+
+    numChannels = juce::jlimit(1, MaxChannels, newNumChannels);
+    numStages   = 0;
+
+    // Stages run out of partitions only at the end, a short response leaves the larger ones empty
+    while (numStages < PartitionedImpulse::NumStages
+           && impulse->stages[static_cast<std::size_t>(numStages)].numPartitions > 0)
+    {
+        ++numStages;
+    }
+
+    int largest_block = PartitionedImpulse::HeadSize;
+
+    for (int s = 0; s < numStages; ++s)
+    {
+        Stage &stage = stages[static_cast<std::size_t>(s)];
+        const PartitionedImpulse::Stage &spectra = impulse->stages[static_cast<std::size_t>(s)];
+        const auto channel_bins = static_cast<std::size_t>(numChannels * spectra.numPartitions * spectra.numBins);
+
+        // With the worker stopped, a job it left behind would never run, and was for the old channels anyway
+        stage.state.store(Idle, std::memory_order_relaxed);
+        stage.spectra = &spectra;
+        stage.fft     = std::make_unique<juce::dsp::FFT>(spectra.blockOrder + 1);
+        stage.delayReal.allocate(channel_bins);
+        stage.delayImag.allocate(channel_bins);
+        stage.sumReal.allocate(static_cast<std::size_t>(spectra.numBins));
+        stage.sumImag.allocate(static_cast<std::size_t>(spectra.numBins));
+        stage.fftData.assign(static_cast<std::size_t>(spectra.blockSize) * 4, 0.0f);
+        stage.outputs.assign(static_cast<std::size_t>(numChannels * spectra.blockSize) * 2, 0.0f);
+
+        largest_block = spectra.blockSize;
+    }
+
+    // The worker reads the two blocks before the one the audio thread is writing
+    ringSize = static_cast<int>(juce::nextPowerOfTwo(largest_block * 3));
+    ringMask = ringSize - 1;
+    ring   .allocate(static_cast<std::size_t>(numChannels * ringSize));
+    history.allocate(static_cast<std::size_t>(numChannels * PartitionedImpulse::HeadSize * 2));
+
+    reset();
+
+    if (numStages > 1)
+    {
+        startThread(WorkerPriority);
+    }
+}
+
+void ConvolutionEngine::reset() noexcept
+{
+    for (int s = 0; s < numStages; ++s)
+    {
+        Stage &stage = stages[static_cast<std::size_t>(s)];
+        const auto channel_bins = static_cast<std::size_t>(numChannels * stage.spectra->numPartitions
+                                                           * stage.spectra->numBins);
+
+        waitForJob(stage);
+        std::fill(stage.delayReal.get(), stage.delayReal.get() + channel_bins, 0.0f);
+        std::fill(stage.delayImag.get(), stage.delayImag.get() + channel_bins, 0.0f);
+        std::fill(stage.outputs.begin(), stage.outputs.end(), 0.0f);
+        stage.delayPosition = 0;
+    }
+
+    std::fill(ring.get(), ring.get() + numChannels * ringSize, 0.0f);
+    std::fill(history.get(), history.get() + numChannels * PartitionedImpulse::HeadSize * 2, 0.0f);
+    time          = 0;
+    silentSamples = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+bool ConvolutionEngine::process(juce::AudioBuffer<SampleType> &buffer, bool isSilent) noexcept
+{
+    using simd::VecF;
+    constexpr int head_size = PartitionedImpulse::HeadSize;
+
+    const int num_channels = juce::jmin(buffer.getNumChannels(), numChannels);
+    const int num_samples  = buffer.getNumSamples();
+
+    for (int ch = num_channels; ch < buffer.getNumChannels(); ++ch)
+    {
+        buffer.clear(ch, 0, num_samples);
+    }
+
+    // Once the input was silent for longer than the response, everything in here is zero and stays so
+    if (isSilent)
+    {
+        const int tail = getTailSamples();
+
+        if (silentSamples >= tail)
+        {
+            buffer.clear();
+            return true;
+        }
+
+        silentSamples = static_cast<int>(std::min<std::int64_t>(std::int64_t(silentSamples) + num_samples, tail));
+    }
+    else
+    {
+        silentSamples = 0;
+    }
+
+    float output[head_size];
+
+    for (int start = 0; start < num_samples;)
+    {
+        const int position = static_cast<int>(time & (head_size - 1));
+
+        if (position == 0)
+        {
+            beginBlock(num_channels);
+        }
+
+        // A chunk never crosses a head block, and so it lies within a single block of every stage
+        const int count = juce::jmin(num_samples - start, head_size - position);
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            SampleType *const data = buffer.getWritePointer(ch, start);
+            float *const past      = getHistory(ch);
+            float *const input     = ring.get() + ch * ringSize;
+
+            for (int i = 0; i < count; ++i)
+            {
+                const auto sample = static_cast<float>(data[i]);
+                past[head_size + position + i]                 = sample;
+                input[static_cast<int>((time + i) & ringMask)] = sample;
+            }
+
+            // The head is reversed, so that the direct part is a dot product with the last head_size inputs
+            const float *const head = impulse->getHead(ch % impulse->numChannels);
+
+            for (int i = 0; i < count; ++i)
+            {
+                const float *const x = past + position + i + 1;
+                VecF sum = VecF::zero();
+
+                for (int j = 0; j < head_size; j += VecF::Size)
+                {
+                    sum = sum + VecF::load(head + j) * VecF::load(x + j);
+                }
+
+                output[i] = simd::sum(sum);
+            }
+
+            for (int s = 0; s < numStages; ++s)
+            {
+                const Stage &stage = stages[static_cast<std::size_t>(s)];
+                const int order    = stage.spectra->blockOrder;
+                const int size     = stage.spectra->blockSize;
+
+                // The first stage plays what it computed this block, the others what their worker did the last one
+                const int index = static_cast<int>(((time >> order) - (s == 0 ? 0 : 1)) & 1);
+                const float *const result = stage.outputs.data() + (index * numChannels + ch) * size
+                                            + static_cast<int>(time & (size - 1));
+
+                juce::FloatVectorOperations::add(output, result, count);
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                data[i] = static_cast<SampleType>(output[i]);
+            }
+        }
+
+        start += count;
+        time  += count;
+
+        if ((time & (head_size - 1)) == 0)
+        {
+            for (int ch = 0; ch < num_channels; ++ch)
+            {
+                float *const past = getHistory(ch);
+                std::copy(past + head_size, past + head_size * 2, past);
+            }
+        }
+    }
+
+    return false;
+}
+
+//======================================================================================================================
+int ConvolutionEngine::getTailSamples() const noexcept
+{
+    return impulse->length;
+}
+
+//======================================================================================================================
+void ConvolutionEngine::run()
+{
+    while (!threadShouldExit())
+    {
+        for (int s = 1; s < numStages; ++s)
+        {
+            Stage &stage = stages[static_cast<std::size_t>(s)];
+            int expected = Pending;
+
+            // The audio thread may have taken the job already, if it needed the result before we got to it
+            if (stage.state.compare_exchange_strong(expected, Running, std::memory_order_acquire))
+            {
+                runStage(stage, stage.jobTime, stage.jobChannels);
+                stage.state.store(Idle, std::memory_order_release);
+            }
+        }
+
+        wait(-1);
+    }
+}
+
+//======================================================================================================================
+void ConvolutionEngine::beginBlock(int numActiveChannels) noexcept
+{
+    if (numStages == 0)
+    {
+        return;
+    }
+
+    runStage(stages[0], time, numActiveChannels);
+
+    bool has_jobs = false;
+
+    for (int s = 1; s < numStages; ++s)
+    {
+        Stage &stage = stages[static_cast<std::size_t>(s)];
+
+        if ((time & (stage.spectra->blockSize - 1)) == 0)
+        {
+            // The last job's result is due now, and its input is about to be overwritten
+            waitForJob(stage);
+
+            stage.jobTime     = time;
+            stage.jobChannels = numActiveChannels;
+            stage.state.store(Pending, std::memory_order_release);
+            has_jobs = true;
+        }
+    }
+
+    if (has_jobs)
+    {
+        notify();
+    }
+}
+
+void ConvolutionEngine::runStage(Stage &stage, std::int64_t blockEnd, int numActiveChannels) noexcept
+{
+    using simd::VecF;
+
+    const PartitionedImpulse::Stage &spectra = *stage.spectra;
+    const int size           = spectra.blockSize;
+    const int num_partitions = spectra.numPartitions;
+    const int num_bins       = spectra.numBins;
+    const int vector_end     = num_bins - num_bins % VecF::Size;
+    float *const fft_data    = stage.fftData.data();
+
+    // Overlap-save over the last two blocks, which the ring still holds even while the audio thread runs ahead
+    const int window_start = static_cast<int>((blockEnd - size * 2) & ringMask);
+    const int first_part   = juce::jmin(size * 2, ringSize - window_start);
+
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        const float *const input = ring.get() + ch * ringSize;
+
+        std::copy(input + window_start, input + window_start + first_part, fft_data);
+        std::copy(input, input + size * 2 - first_part, fft_data + first_part);
+        std::fill(fft_data + size * 2, fft_data + size * 4, 0.0f);
+        stage.fft->performRealOnlyForwardTransform(fft_data, true);
+
+        const int offset = (ch * num_partitions + stage.delayPosition) * num_bins;
+
+        for (int bin = 0; bin < num_bins; ++bin)
+        {
+            stage.delayReal[static_cast<std::size_t>(offset + bin)] = fft_data[bin * 2];
+            stage.delayImag[static_cast<std::size_t>(offset + bin)] = fft_data[bin * 2 + 1];
+        }
+    }
+
+    const int output_index = static_cast<int>((blockEnd >> spectra.blockOrder) & 1);
+    float *const sum_real  = stage.sumReal.get();
+    float *const sum_imag  = stage.sumImag.get();
+
+    for (int ch = 0; ch < numActiveChannels; ++ch)
+    {
+        const int impulse_channel = ch % impulse->numChannels;
+
+        std::fill(sum_real, sum_real + num_bins, 0.0f);
+        std::fill(sum_imag, sum_imag + num_bins, 0.0f);
+
+        for (int partition = 0; partition < num_partitions; ++partition)
+        {
+            // The input from partition blocks ago meets the response partition as much delayed
+            const int slot = (stage.delayPosition - partition + num_partitions) % num_partitions;
+            const float *const x_real = stage.delayReal.get() + (ch * num_partitions + slot) * num_bins;
+            const float *const x_imag = stage.delayImag.get() + (ch * num_partitions + slot) * num_bins;
+            const float *const h_real = spectra.real.data() + (impulse_channel * num_partitions + partition) * num_bins;
+            const float *const h_imag = spectra.imag.data() + (impulse_channel * num_partitions + partition) * num_bins;
+
+            for (int i = 0; i < vector_end; i += VecF::Size)
+            {
+                const VecF xr = VecF::load(x_real + i);
+                const VecF xi = VecF::load(x_imag + i);
+                const VecF hr = VecF::load(h_real + i);
+                const VecF hi = VecF::load(h_imag + i);
+
+                (VecF::load(sum_real + i) + xr * hr - xi * hi).store(sum_real + i);
+                (VecF::load(sum_imag + i) + xr * hi + xi * hr).store(sum_imag + i);
+            }
+
+            for (int i = vector_end; i < num_bins; ++i)
+            {
+                sum_real[i] += x_real[i] * h_real[i] - x_imag[i] * h_imag[i];
+                sum_imag[i] += x_real[i] * h_imag[i] + x_imag[i] * h_real[i];
+            }
+        }
+
+        for (int bin = 0; bin < num_bins; ++bin)
+        {
+            fft_data[bin * 2]     = sum_real[bin];
+            fft_data[bin * 2 + 1] = sum_imag[bin];
+        }
+
+        stage.fft->performRealOnlyInverseTransform(fft_data);
+
+        // Only the second half is free of the wrap-around of the circular convolution
+        std::copy(fft_data + size, fft_data + size * 2,
+                  stage.outputs.data() + (output_index * numChannels + ch) * size);
+    }
+
+    stage.delayPosition = (stage.delayPosition + 1) % num_partitions;
+}
+
+void ConvolutionEngine::waitForJob(Stage &stage) noexcept
+{
+    int expected = Pending;
+
+    // Rather than waiting for the worker to get around to it, do the job right here
+    if (stage.state.compare_exchange_strong(expected, Running, std::memory_order_acquire))
+    {
+        runStage(stage, stage.jobTime, stage.jobChannels);
+        stage.state.store(Idle, std::memory_order_release);
+        return;
+    }
+
+    while (stage.state.load(std::memory_order_acquire) != Idle)
+    {
+        pauseSpin();
+    }
+}
+
+float* ConvolutionEngine::getHistory(int channel) const noexcept
+{
+    return history.get() + channel * PartitionedImpulse::HeadSize * 2;
+}
+
+//======================================================================================================================
+template bool ConvolutionEngine::process(juce::AudioBuffer<float>&, bool) noexcept;
+template bool ConvolutionEngine::process(juce::AudioBuffer<double>&, bool) noexcept;
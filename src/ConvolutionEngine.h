@@ -0,0 +1,148 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ConvolutionEngine.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include "ImpulseResponseCache.h"
+#include "SimdOps.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *  Convolves with an impulse response at zero latency, by non-uniformly partitioned convolution.
+ *
+ *  The head of the response is convolved directly, sample by sample, which is what makes the output come without any
+ *  delay. Behind it come the stages of PartitionedImpulse, uniformly partitioned overlap-save convolutions whose
+ *  partitions grow the further back into the response they are. The first stage has partitions as large as the head
+ *  and runs on the audio thread whenever a block of that size is complete. The larger stages only have to be done one
+ *  of their own blocks later, so they are handed to a worker thread; whenever the audio thread needs a result that the
+ *  worker didn't get to yet, it computes it itself instead of waiting, and offline renders come out exactly the same
+ *  as realtime ones.
+ *
+ *  The spectra of the response are shared and read-only, every engine only owns its input, its frequency-domain delay
+ *  lines and its outputs.
+ */
+class ConvolutionEngine final : private juce::Thread
+{
+public:
+    static constexpr int MaxChannels = PartitionedImpulse::MaxChannels;
+
+    /** The priority of the worker, the highest there is as it's as much on the clock as the audio thread. */
+    static constexpr int WorkerPriority = 10;
+
+    //==================================================================================================================
+    explicit ConvolutionEngine(std::shared_ptr<const PartitionedImpulse> impulse);
+    ~ConvolutionEngine() override;
+
+    //==================================================================================================================
+    /**
+     *  Sets the engine up and starts its worker, this allocates and must not be called while processing.
+     *  Channels cycle through the channels of the response, a mono response is used for all of them.
+     *
+     *  @param numChannels The number of channels to convolve, up to MaxChannels
+     */
+    void prepare(int numChannels);
+
+    /** Clears the signal held by the engine, must not be called while processing. */
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /**
+     *  Convolves a block in place, realtime safe. Channels beyond the prepared ones are cleared.
+     *
+     *  @param buffer   The block to convolve
+     *  @param isSilent Whether the block is known to be silent
+     *  @return True if the output is silent, because the input was for longer than the tail
+     */
+    template<class SampleType>
+    bool process(juce::AudioBuffer<SampleType> &buffer, bool isSilent) noexcept;
+
+    //==================================================================================================================
+    /** Gets for how long the engine keeps sounding once its input went silent. */
+    int getTailSamples() const noexcept;
+
+    const PartitionedImpulse& getImpulse() const noexcept { return *impulse; }
+
+private:
+    enum JobState
+    {
+        Idle,
+        Pending,
+        Running
+    };
+
+    struct Stage
+    {
+        const PartitionedImpulse::Stage *spectra { nullptr };
+        std::unique_ptr<juce::dsp::FFT> fft;
+        simd::AlignedBlock<float> delayReal;
+        simd::AlignedBlock<float> delayImag;
+        simd::AlignedBlock<float> sumReal;
+        simd::AlignedBlock<float> sumImag;
+        std::vector<float> fftData;
+
+        /** Two blocks per channel, one being played while the other is computed. */
+        std::vector<float> outputs;
+        int delayPosition { 0 };
+
+        /** The job as the audio thread handed it over, published through the state. */
+        std::int64_t jobTime { 0 };
+        int jobChannels { 0 };
+        alignas(64) std::atomic<int> state { Idle };
+    };
+
+    //==================================================================================================================
+    std::shared_ptr<const PartitionedImpulse> impulse;
+    std::array<Stage, PartitionedImpulse::NumStages> stages;
+    int numStages   { 0 };
+    int numChannels { 0 };
+
+    // The input of the last few largest blocks, which the worker reads while the audio thread writes ahead of it
+    simd::AlignedBlock<float> ring;
+    int ringSize { 0 };
+    int ringMask { 0 };
+
+    // Audio thread only from here on, the input of the current and the previous head block for the direct part
+    simd::AlignedBlock<float> history;
+    std::int64_t time { 0 };
+    int silentSamples { 0 };
+
+    //==================================================================================================================
+    void run() override;
+
+    //==================================================================================================================
+    void beginBlock(int numActiveChannels) noexcept;
+    void runStage(Stage&, std::int64_t blockEnd, int numActiveChannels) noexcept;
+    void waitForJob(Stage&) noexcept;
+
+    float* getHistory(int channel) const noexcept;
+};
@@ -218,6 +218,13 @@ void CossinPluginWrapper::createPlugin(bool loadInitialState)
     jassert(processor != nullptr);
 
     processor->disableNonMainBuses();
+    
+    // The sidechain stays available, any device inputs beyond the main bus are routed to it
+    if (juce::AudioProcessor::Bus *sidechain = processor->getBus(true, 1))
+    {
+        sidechain->enable();
+    }
+    
     processor->setRateAndBufferSizeDetails(44100, 512);
 
     int inChannels = (channelConfiguration.size() > 0 ? channelConfiguration[0].numIns
@@ -365,6 +372,9 @@ bool CossinPluginWrapper::askUserToLoadState(const juce::String &fileSuffix)
 //======================================================================================================================
 void CossinPluginWrapper::startPlaying()
 {
+    const bool use_double_precision = sharedData->Configuration().getProperty(res::Prop_StandaloneDoublePrecision,
+                                                                               res::Cfg_Standalone).getValue();
+    player.setDoublePrecisionProcessing(use_double_precision && processor->supportsDoublePrecisionProcessing());
     player.setProcessor(processor.get());
 
 #if JucePlugin_Enable_IAA && JUCE_IOS
@@ -405,7 +415,7 @@ bool CossinPluginWrapper::reloadAudioDeviceState(bool enableAudioInput, const ju
     shouldMuteInput.setValue(static_cast<bool>(config.getProperty("muteInput", res::Cfg_Standalone).getValue()));
 #endif
 
-    int totalInChannels  = processor->getMainBusNumInputChannels();
+    int totalInChannels  = processor->getTotalNumInputChannels();
     int totalOutChannels = processor->getMainBusNumOutputChannels();
 
     if (channelConfiguration.size() > 0)
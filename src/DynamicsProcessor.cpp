@@ -0,0 +1,305 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   DynamicsProcessor.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "DynamicsProcessor.h"
+#include "SimdOps.h"
+
+namespace
+{
+/** 20 * log10(2), the level difference of an octave of amplitude. */
+constexpr float decibelsPerOctave = 6.02059991f;
+
+/** How far below its threshold the limiter aims, more than the error of the approximated logarithm. */
+constexpr float limiterMarginDb = 0.001f;
+
+//======================================================================================================================
+// levels = max(levels, |key|)
+template<class SampleType>
+void rectifyMax(SampleType *levels, const SampleType *key, int numSamples) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        max(Vec::load(levels + i), abs(Vec::load(key + i))).store(levels + i);
+    }
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        levels[i] = std::max(levels[i], std::abs(key[i]));
+    }
+}
+
+float getSmoothingCoefficient(double sampleRate, float milliseconds) noexcept
+{
+    // The share of the distance to the target covered per sample, 1 being instant
+    const double samples = juce::jmax(1.0, static_cast<double>(milliseconds) * 0.001 * sampleRate);
+    return static_cast<float>(1.0 - std::exp(-1.0 / samples));
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void DynamicsProcessor<SampleType>::prepare(double newSampleRate, int newNumChannels, int maximumBlockSize)
+{
+    sampleRate   = newSampleRate;
+    numChannels  = newNumChannels;
+    scratchSize  = juce::jmax(1, maximumBlockSize);
+    maxLookahead = static_cast<int>(std::ceil(MaxLookaheadMs * 0.001 * sampleRate));
+    lookahead    = juce::jmin(lookahead, maxLookahead);
+
+    delay.prepare(numChannels, maxLookahead, scratchSize);
+    delay.setDelay(lookahead);
+    keyLevels.allocate(static_cast<std::size_t>(scratchSize), true);
+    gains    .allocate(static_cast<std::size_t>(simd::getAlignedSize<float>(scratchSize)), true);
+
+    // The deque holds one more level than the window for the moment between pushing and expiring
+    const auto window_size = static_cast<std::size_t>(juce::nextPowerOfTwo(maxLookahead + 2));
+    windowLevels  .assign(window_size, 0.0f);
+    windowTimes   .assign(window_size, 0);
+    averageHistory.assign(window_size, 0.0f);
+    windowMask = static_cast<std::uint32_t>(window_size - 1);
+
+    updateCoefficients();
+    reset();
+}
+
+template<class SampleType>
+void DynamicsProcessor<SampleType>::reset() noexcept
+{
+    delay.reset();
+    gain   = 0.0f;
+    makeup = parameters.makeup;
+    resetWindow();
+}
+
+//======================================================================================================================
+template<class SampleType>
+void DynamicsProcessor<SampleType>::setParameters(const DynamicsParameters &newParameters) noexcept
+{
+    parameters = newParameters;
+    updateCoefficients();
+}
+
+template<class SampleType>
+void DynamicsProcessor<SampleType>::setLookahead(int numSamples) noexcept
+{
+    numSamples = juce::jlimit(0, maxLookahead, numSamples);
+
+    if (numSamples != lookahead)
+    {
+        lookahead = numSamples;
+        delay.setDelay(lookahead);
+        resetWindow();
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void DynamicsProcessor<SampleType>::process(juce::AudioBuffer<SampleType> &buffer,
+                                            const juce::AudioBuffer<SampleType> *key) noexcept
+{
+    jassert(buffer.getNumChannels() <= numChannels);
+
+    for (int start = 0; start < buffer.getNumSamples(); start += scratchSize)
+    {
+        processChunk(buffer, key, start, juce::jmin(scratchSize, buffer.getNumSamples() - start));
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void DynamicsProcessor<SampleType>::updateCoefficients() noexcept
+{
+    const bool is_limiter = parameters.mode == DynamicsParameters::Mode::Limiter;
+
+    // A limiter is a compressor of infinite ratio and hard knee that attacks instantly
+    threshold    = is_limiter ? parameters.threshold - limiterMarginDb : parameters.threshold;
+    slope        = is_limiter ? 1.0f : 1.0f - 1.0f / juce::jmax(1.0f, parameters.ratio);
+    kneeWidth    = is_limiter ? 0.0f : juce::jmax(0.0f, parameters.knee);
+    attackCoeff  = is_limiter ? 1.0f : getSmoothingCoefficient(sampleRate, parameters.attack);
+    releaseCoeff = getSmoothingCoefficient(sampleRate, parameters.release);
+}
+
+template<class SampleType>
+void DynamicsProcessor<SampleType>::resetWindow() noexcept
+{
+    windowFront = 0;
+    windowBack  = 0;
+
+    // The average starts out where the gain is, so that a new lookahead doesn't dip or jump
+    std::fill(averageHistory.begin(), averageHistory.end(), gain);
+    averageSum      = static_cast<double>(gain) * (lookahead + 1);
+    averagePosition = 0;
+}
+
+template<class SampleType>
+void DynamicsProcessor<SampleType>::processChunk(juce::AudioBuffer<SampleType> &buffer,
+                                                 const juce::AudioBuffer<SampleType> *key, int start,
+                                                 int numSamples) noexcept
+{
+    using simd::VecF;
+
+    SampleType *const levels = keyLevels.get();
+    float *const chunk_gains = gains.get();
+
+    // The gains are padded to whole vectors, what the padding computes is never used
+    const int vector_end = simd::getAlignedSize<float>(numSamples);
+
+    // Linked detection: the loudest channel of the key decides, read before the delay in case the key is the buffer
+    std::fill(levels, levels + numSamples, SampleType(0));
+
+    if (key != nullptr)
+    {
+        jassert(key->getNumSamples() >= start + numSamples);
+
+        for (int ch = 0; ch < key->getNumChannels(); ++ch)
+        {
+            rectifyMax(levels, key->getReadPointer(ch, start), numSamples);
+        }
+    }
+
+    // The largest level within the lookahead window, the window ends at the sample that's just coming in
+    const auto window_length = static_cast<std::uint32_t>(lookahead + 1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto level = static_cast<float>(levels[i]);
+
+        while (windowBack != windowFront && windowLevels[(windowBack - 1) & windowMask] <= level)
+        {
+            --windowBack;
+        }
+
+        windowLevels[windowBack & windowMask] = level;
+        windowTimes [windowBack & windowMask] = time;
+        ++windowBack;
+
+        if (time - windowTimes[windowFront & windowMask] >= window_length)
+        {
+            ++windowFront;
+        }
+
+        chunk_gains[i] = windowLevels[windowFront & windowMask];
+        ++time;
+    }
+
+    // The gain computer, in dB with a quadratic knee: 0 below it, the slope times the overshoot above it
+    {
+        const VecF over_start   = VecF::broadcast(threshold);
+        const VecF half_knee    = VecF::broadcast(kneeWidth * 0.5f);
+        const VecF knee_width   = VecF::broadcast(kneeWidth);
+        const VecF knee_scale   = VecF::broadcast(kneeWidth > 0.0f ? 0.5f / kneeWidth : 0.0f);
+        const VecF gain_slope   = VecF::broadcast(-slope);
+        const VecF octave_to_db = VecF::broadcast(decibelsPerOctave);
+        const VecF zero         = VecF::zero();
+
+        for (int i = 0; i < vector_end; i += VecF::Size)
+        {
+            const VecF over    = simd::fastLog2(VecF::load(chunk_gains + i)) * octave_to_db - over_start;
+            const VecF in_knee = min(max(over + half_knee, zero), knee_width);
+            (gain_slope * (in_knee * in_knee * knee_scale + max(over - half_knee, zero))).store(chunk_gains + i);
+        }
+    }
+
+    // Ballistics, which depend on the sample before and can't be vectorised
+    if (parameters.mode == DynamicsParameters::Mode::Limiter)
+    {
+        const float average_scale = 1.0f / static_cast<float>(window_length);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float target = chunk_gains[i];
+            gain = target < gain ? target : gain + releaseCoeff * (target - gain);
+
+            const float oldest = averageHistory[(averagePosition - window_length) & windowMask];
+            averageHistory[averagePosition & windowMask] = gain;
+            averageSum += static_cast<double>(gain) - oldest;
+            ++averagePosition;
+
+            chunk_gains[i] = static_cast<float>(averageSum) * average_scale;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float target = chunk_gains[i];
+            gain += (target < gain ? attackCoeff : releaseCoeff) * (target - gain);
+            chunk_gains[i] = gain;
+        }
+    }
+
+    // Back to linear gains, with the makeup ramped over the chunk
+    {
+        const float makeup_step = (parameters.makeup - makeup) / static_cast<float>(numSamples);
+        const VecF db_to_octave = VecF::broadcast(1.0f / decibelsPerOctave);
+        const VecF ramp_step    = VecF::broadcast(makeup_step * VecF::Size);
+        float ramp_start[VecF::Size];
+
+        for (int lane = 0; lane < VecF::Size; ++lane)
+        {
+            ramp_start[lane] = makeup + makeup_step * static_cast<float>(lane + 1);
+        }
+
+        VecF ramp = VecF::load(ramp_start);
+
+        for (int i = 0; i < vector_end; i += VecF::Size)
+        {
+            simd::fastExp2((VecF::load(chunk_gains + i) + ramp) * db_to_octave).store(chunk_gains + i);
+            ramp = ramp + ramp_step;
+        }
+
+        makeup = parameters.makeup;
+    }
+
+    juce::AudioBuffer<SampleType> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples);
+    delay.process(chunk.getArrayOfReadPointers(), chunk.getArrayOfWritePointers(), chunk.getNumChannels(), numSamples);
+
+    for (int ch = 0; ch < chunk.getNumChannels(); ++ch)
+    {
+        SampleType *const data = chunk.getWritePointer(ch);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            juce::FloatVectorOperations::multiply(data, chunk_gains, numSamples);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                data[i] *= static_cast<SampleType>(chunk_gains[i]);
+            }
+        }
+    }
+}
+
+//======================================================================================================================
+template class DynamicsProcessor<float>;
+template class DynamicsProcessor<double>;
@@ -0,0 +1,133 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   DynamicsProcessor.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "CompensationDelay.h"
+
+#include <cstdint>
+#include <vector>
+
+/** The settings of the dynamics processor. */
+struct DynamicsParameters
+{
+    enum class Mode
+    {
+        Compressor,
+        Limiter
+    };
+
+    //==================================================================================================================
+    Mode  mode      { Mode::Compressor };
+    float threshold { -12.0f };  // in dB
+    float ratio     { 4.0f };    // compressor only
+    float knee      { 6.0f };    // in dB, compressor only
+    float attack    { 10.0f };   // in ms, compressor only
+    float release   { 100.0f };  // in ms
+    float makeup    { 0.0f };    // in dB
+};
+
+/**
+ *  A lookahead compressor and brickwall limiter, keyed from the signal itself or from any other one.
+ *
+ *  The key is rectified and linked across all of its channels, and the signal is delayed by the lookahead while the
+ *  key isn't. The largest key level within the lookahead window, found by a monotonic deque in constant time per
+ *  sample, goes through a soft-knee gain computer which is vectorised over the whole block in the log domain.
+ *
+ *  As a compressor, the gain follows the computer with separate attack and release times. As a limiter, it drops
+ *  instantly, releases smoothly and is then averaged over the lookahead window; as the window maximum held every
+ *  peak for at least that long, the average never lets one through above the threshold plus makeup.
+ *
+ *  The lookahead can be changed while processing, it jumps like a latency change does.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class DynamicsProcessor final
+{
+public:
+    static constexpr double MaxLookaheadMs = 20.0;
+
+    //==================================================================================================================
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+    void reset() noexcept;
+
+    //==================================================================================================================
+    void setParameters(const DynamicsParameters&) noexcept;
+
+    /** Sets the lookahead in samples, which is also the latency; clamped to MaxLookaheadMs. */
+    void setLookahead(int numSamples) noexcept;
+    int getLookahead() const noexcept { return lookahead; }
+
+    //==================================================================================================================
+    /**
+     *  Processes a block in place.
+     *
+     *  @param buffer The block to process
+     *  @param key    The key, which may be the block itself; nullptr or no channels leave the gain where the computer
+     *                has it for silence
+     */
+    void process(juce::AudioBuffer<SampleType> &buffer, const juce::AudioBuffer<SampleType> *key) noexcept;
+
+private:
+    DynamicsParameters parameters;
+    CompensationDelay<SampleType> delay;
+    juce::HeapBlock<SampleType> keyLevels;
+    juce::HeapBlock<float> gains;
+    double sampleRate { 44100.0 };
+    int numChannels   { 0 };
+    int scratchSize   { 0 };
+    int lookahead     { 0 };
+    int maxLookahead  { 0 };
+
+    // The largest level within the window, the deque holds the levels that may still become it in falling order
+    std::vector<float> windowLevels;
+    std::vector<std::uint32_t> windowTimes;
+    std::uint32_t windowFront { 0 };
+    std::uint32_t windowBack  { 0 };
+    std::uint32_t time        { 0 };
+
+    // The limiter's moving average over the window
+    std::vector<float> averageHistory;
+    double averageSum { 0.0 };
+    std::uint32_t averagePosition { 0 };
+    std::uint32_t windowMask      { 0 };
+
+    // The gain computer and ballistics, all gains are in dB
+    float gain         { 0.0f };
+    float makeup       { 0.0f };
+    float threshold    { 0.0f };
+    float attackCoeff  { 1.0f };
+    float releaseCoeff { 1.0f };
+    float slope        { 0.0f };
+    float kneeWidth    { 0.0f };
+
+    //==================================================================================================================
+    void updateCoefficients() noexcept;
+    void resetWindow() noexcept;
+    void processChunk(juce::AudioBuffer<SampleType>&, const juce::AudioBuffer<SampleType>*, int, int) noexcept;
+};
@@ -55,3 +55,111 @@ void EffectEqualizerGui::resized()
 }
 #pragma endregion EffectEqualizerGui
 #pragma endregion EffectModule::Equalizer
+#pragma region EffectModule::Reverb
+#pragma region EffectReverbGui
+/* ==================================================================================
+ * ================================= EffectReverbGui ================================
+ * ================================================================================== */
+EffectReverbGui::EffectReverbGui(EffectReverb &processor)
+    : DspGui(processor)
+{}
+
+//======================================================================================================================
+void EffectReverbGui::paint(Graphics &g)
+{
+    const LookAndFeel &lf = getLookAndFeel();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerForegroundId));
+    g.fillAll();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerBackgroundId));
+    g.fillRect(getLocalBounds().reduced(6));
+}
+
+void EffectReverbGui::resized()
+{
+
+}
+#pragma endregion EffectReverbGui
+#pragma endregion EffectModule::Reverb
+#pragma region EffectModule::Convolution
+#pragma region EffectConvolutionGui
+/* ==================================================================================
+ * ============================== EffectConvolutionGui ==============================
+ * ================================================================================== */
+EffectConvolutionGui::EffectConvolutionGui(EffectConvolution &processor)
+    : DspGui(processor)
+{}
+
+//======================================================================================================================
+void EffectConvolutionGui::paint(Graphics &g)
+{
+    const LookAndFeel &lf = getLookAndFeel();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerForegroundId));
+    g.fillAll();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerBackgroundId));
+    g.fillRect(getLocalBounds().reduced(6));
+}
+
+void EffectConvolutionGui::resized()
+{
+
+}
+#pragma endregion EffectConvolutionGui
+#pragma endregion EffectModule::Convolution
+#pragma region EffectModule::Dynamics
+#pragma region EffectDynamicsGui
+/* ==================================================================================
+ * =============================== EffectDynamicsGui ================================
+ * ================================================================================== */
+EffectDynamicsGui::EffectDynamicsGui(EffectDynamics &processor)
+    : DspGui(processor)
+{}
+
+//======================================================================================================================
+void EffectDynamicsGui::paint(Graphics &g)
+{
+    const LookAndFeel &lf = getLookAndFeel();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerForegroundId));
+    g.fillAll();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerBackgroundId));
+    g.fillRect(getLocalBounds().reduced(6));
+}
+
+void EffectDynamicsGui::resized()
+{
+
+}
+#pragma endregion EffectDynamicsGui
+#pragma endregion EffectModule::Dynamics
+#pragma region EffectModule::Delay
+#pragma region EffectDelayGui
+/* ==================================================================================
+ * ================================= EffectDelayGui =================================
+ * ================================================================================== */
+EffectDelayGui::EffectDelayGui(EffectDelay &processor)
+    : DspGui(processor)
+{}
+
+//======================================================================================================================
+void EffectDelayGui::paint(Graphics &g)
+{
+    const LookAndFeel &lf = getLookAndFeel();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerForegroundId));
+    g.fillAll();
+
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourContainerBackgroundId));
+    g.fillRect(getLocalBounds().reduced(6));
+}
+
+void EffectDelayGui::resized()
+{
+
+}
+#pragma endregion EffectDelayGui
+#pragma endregion EffectModule::Delay
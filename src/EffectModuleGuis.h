@@ -25,7 +25,13 @@
 
 #pragma once
 
+#include <jaut_audio/jaut_audio.h>
+
 class EffectEqualizer;
+class EffectReverb;
+class EffectConvolution;
+class EffectDynamics;
+class EffectDelay;
 
 class EffectEqualizerGui final : public jaut::DspGui
 {
@@ -39,3 +45,43 @@ public:
 private:
     
 };
+
+class EffectReverbGui final : public jaut::DspGui
+{
+public:
+    EffectReverbGui(EffectReverb&);
+
+    //==================================================================================================================
+    void paint(Graphics&) override;
+    void resized() override;
+};
+
+class EffectConvolutionGui final : public jaut::DspGui
+{
+public:
+    EffectConvolutionGui(EffectConvolution&);
+
+    //==================================================================================================================
+    void paint(Graphics&) override;
+    void resized() override;
+};
+
+class EffectDynamicsGui final : public jaut::DspGui
+{
+public:
+    EffectDynamicsGui(EffectDynamics&);
+
+    //==================================================================================================================
+    void paint(Graphics&) override;
+    void resized() override;
+};
+
+class EffectDelayGui final : public jaut::DspGui
+{
+public:
+    EffectDelayGui(EffectDelay&);
+
+    //==================================================================================================================
+    void paint(Graphics&) override;
+    void resized() override;
+};
@@ -25,7 +25,72 @@
 
 #include "EffectModules.h"
 #include "EffectModuleGuis.h"
+#include "SharedData.h"
 
+#pragma region EffectModule
+/* ==================================================================================
+ * ================================== EffectModule ==================================
+ * ================================================================================== */
+int EffectModule::getLatencySamples(int index) const noexcept
+{
+    const Oversampler<float> *oversampler = getOversampler<float>(index);
+    return oversampler ? oversampler->getLatencySamples() : 0;
+}
+
+int EffectModule::getTailSamples(int index) const noexcept
+{
+    // The oversampling filters ring about as long as they delay, on the way up and again on the way down
+    return getLatencySamples(index) * 2;
+}
+
+//======================================================================================================================
+void EffectModule::requestOversampling(int index, int numChannels, int maximumBlockSize, int factorLog2,
+                                       OversamplingFilter filterType)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    if (oversamplers.size() <= static_cast<std::size_t>(index))
+    {
+        oversamplers.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    const int previous_latency = getLatencySamples(index);
+    OversamplerPair &pair      = oversamplers[static_cast<std::size_t>(index)];
+
+    pair.floatOversampler  = std::make_unique<Oversampler<float>> (numChannels, factorLog2, filterType);
+    pair.doubleOversampler = std::make_unique<Oversampler<double>>(numChannels, factorLog2, filterType);
+    pair.floatOversampler ->prepare(maximumBlockSize);
+    pair.doubleOversampler->prepare(maximumBlockSize);
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+void EffectModule::releaseOversampling(int index)
+{
+    if (!isPositiveAndBelow(index, static_cast<int>(oversamplers.size())))
+    {
+        return;
+    }
+
+    const int previous_latency = getLatencySamples(index);
+    oversamplers[static_cast<std::size_t>(index)] = OversamplerPair();
+
+    if (onLatencyChanged && previous_latency != 0)
+    {
+        onLatencyChanged();
+    }
+}
+
+//======================================================================================================================
+RangedAudioParameter* EffectModule::getInstanceParameter(int index, const String &parameterId) const
+{
+    // Instance parameters are registered under the module and the instance index they belong to, ahead of their id
+    return valueTreeState.getParameter(getName().toLowerCase() + "_" + String(index) + "_" + parameterId);
+}
+#pragma endregion EffectModule
 #pragma region EffectModuleEqualizer
 #pragma region EffectEqualizerContext
 /* ==================================================================================
@@ -38,30 +103,152 @@ struct EffectEqualizerContext : public EffectEqualizer::DataContext {};
  * ================================= EffectEqualizer ================================
  * ================================================================================== */
 EffectEqualizer::EffectEqualizer(DspUnit &processor, AudioProcessorValueTreeState &vts, UndoManager *undoManager)
-    : EffectModule(processor, vts, undoManager)
+    : EffectModule(processor, vts, undoManager),
+      linearPhaseOptions(static_cast<std::size_t>(getMaxInstances()))
 {
     initialize();
 }
 
 //======================================================================================================================
-void EffectEqualizer::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer &midiBuffer)
+void EffectEqualizer::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer&)
 {
-
+    processInstance(index, buffer);
 }
 
-void EffectEqualizer::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer &midiBuffer)
+void EffectEqualizer::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer&)
 {
-
+    processInstance(index, buffer);
 }
 
 void EffectEqualizer::beginPlayback(int index, double sampleRate, int bufferSize)
 {
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    const int previous_latency = getLatencySamples(index);
+
+    if (instances.size() <= static_cast<std::size_t>(index))
+    {
+        instances.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    std::vector<RangedAudioParameter*> parameters;
+
+    for (int i = 0; i < getMaxBands(); ++i)
+    {
+        for (const char *id : { "_freq", "_gain", "_q" })
+        {
+            RangedAudioParameter *const parameter = getInstanceParameter(index, "band_" + String(i) + id);
+
+            if (parameter == nullptr)
+            {
+                // Without all of its parameters the instance passes the signal through untouched
+                jassertfalse;
+                instances[static_cast<std::size_t>(index)].reset();
+                return;
+            }
+
+            parameters.emplace_back(parameter);
+        }
+    }
+
+    const LinearPhaseOptions &options = linearPhaseOptions[static_cast<std::size_t>(index)];
+
+    auto instance = std::make_unique<Instance>();
+    instance->parameters = std::make_unique<ParameterStore>(std::move(parameters));
+    instance->sampleRate = sampleRate;
+    instance->floatCascade .prepare(bufferSize);
+    instance->doubleCascade.prepare(bufferSize);
+
+    // The convolver is always there, so that the mode can be switched without allocating while playing
+    instance->linearPhase.prepare(LinearPhaseConvolver::MaxChannels, options.kernelOrder, options.partitionOrder);
+    instance->linearPhaseEnabled.store(options.enabled, std::memory_order_relaxed);
+    instance->linearPhase.setActive(options.enabled);
 
+    // The first update sees every parameter as changed, so this designs all bands
+    instance->parameters->update();
+    instance->updateBands(0);
+
+    instances[static_cast<std::size_t>(index)] = std::move(instance);
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
 }
 
 void EffectEqualizer::finishPlayback(int index)
 {
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())))
+    {
+        return;
+    }
+
+    const int previous_latency = getLatencySamples(index);
+    instances[static_cast<std::size_t>(index)].reset();
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+//======================================================================================================================
+void EffectEqualizer::setLinearPhaseOptions(int index, const LinearPhaseOptions &options)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    const int previous_latency = getLatencySamples(index);
+    linearPhaseOptions[static_cast<std::size_t>(index)] = options;
+
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())) && instances[static_cast<std::size_t>(index)])
+    {
+        Instance &instance = *instances[static_cast<std::size_t>(index)];
+        instance.linearPhaseEnabled.store(options.enabled, std::memory_order_relaxed);
+        instance.linearPhase.setActive(options.enabled);
+    }
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+const EffectEqualizer::LinearPhaseOptions& EffectEqualizer::getLinearPhaseOptions(int index) const noexcept
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+    return linearPhaseOptions[static_cast<std::size_t>(index)];
+}
+
+int EffectEqualizer::getLatencySamples(int index) const noexcept
+{
+    const int latency = EffectModule::getLatencySamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return latency;
+    }
+
+    // The convolver's sizes are those from the last beginPlayback, which aren't necessarily the current options
+    const Instance &instance = *instances[static_cast<std::size_t>(index)];
+    return latency + (instance.linearPhaseEnabled.load(std::memory_order_relaxed)
+                          ? instance.linearPhase.getLatencySamples() : 0);
+}
+
+int EffectEqualizer::getTailSamples(int index) const noexcept
+{
+    const int tail = EffectModule::getTailSamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return tail;
+    }
 
+    // A linear-phase kernel rings for twice its latency, the partitioning adds its delay on the way in and out
+    const Instance &instance = *instances[static_cast<std::size_t>(index)];
+    const int own_tail = instance.linearPhaseEnabled.load(std::memory_order_relaxed)
+                             ? instance.linearPhase.getLatencySamples() * 2
+                             : instance.tailSamples.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<std::int64_t>(std::int64_t(tail) + own_tail, std::numeric_limits<int>::max()));
 }
 
 /*
@@ -102,6 +289,107 @@ std::vector<EffectEqualizer::SfxParameter> EffectEqualizer::createParameters() c
     return parameters;
 }
 
+//======================================================================================================================
+template<class SampleType>
+void EffectEqualizer::processInstance(int index, AudioBuffer<SampleType> &buffer)
+{
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return;
+    }
+
+    Instance &instance = *instances[static_cast<std::size_t>(index)];
+    instance.parameters->update();
+
+    const bool has_changes = instance.parameters->hasChanges();
+
+    // Changes are ramped to over the block they arrived with, which makes automation piecewise linear per sample
+    if (has_changes)
+    {
+        instance.updateBands(buffer.getNumSamples());
+    }
+
+    if (instance.linearPhaseEnabled.load(std::memory_order_relaxed))
+    {
+        const bool switched_on = !instance.linearPhaseRunning;
+
+        // Switched on, the convolver starts from silence and needs the current bands
+        if (switched_on)
+        {
+            instance.linearPhase.reset();
+            instance.linearPhaseRunning = true;
+        }
+
+        if (has_changes || switched_on)
+        {
+            instance.linearPhase.requestKernel(instance.bands.data(), static_cast<int>(instance.bands.size()));
+        }
+
+        instance.linearPhase.process(buffer);
+        return;
+    }
+
+    // Switched off again, the biquads' state is from whenever they last ran
+    if (instance.linearPhaseRunning)
+    {
+        instance.floatCascade .reset();
+        instance.doubleCascade.reset();
+        instance.linearPhaseRunning = false;
+    }
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        instance.floatCascade.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                      buffer.getNumSamples());
+    }
+    else
+    {
+        instance.doubleCascade.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                       buffer.getNumSamples());
+    }
+}
+
+void EffectEqualizer::Instance::updateBands(int rampSamples) noexcept
+{
+    const int num_bands = static_cast<int>(bands.size());
+
+    for (int i = 0; i < num_bands; ++i)
+    {
+        const int first = i * 3;
+
+        // Only bands with a parameter that moved are designed again
+        if (!parameters->isDirty(first) && !parameters->isDirty(first + 1) && !parameters->isDirty(first + 2))
+        {
+            continue;
+        }
+
+        const float gain = parameters->get(first + 1);
+
+        // Bands at unity gain are identities, which the cascades leave out of their chain
+        bands[static_cast<std::size_t>(i)] = (gain == 1.0f ? BiquadCoefficients()
+                                                           : BiquadCoefficients::makePeak(sampleRate,
+                                                                                          parameters->get(first),
+                                                                                          parameters->get(first + 2),
+                                                                                          gain));
+        bandTails[static_cast<std::size_t>(i)] = bands[static_cast<std::size_t>(i)].getTailSamples();
+    }
+
+    // The cascade can't ring longer than all of its sections one after the other
+    std::int64_t tail = 0;
+
+    for (const int band_tail : bandTails)
+    {
+        tail += band_tail;
+    }
+
+    tailSamples.store(static_cast<int>(std::min<std::int64_t>(tail, std::numeric_limits<int>::max())),
+                      std::memory_order_relaxed);
+
+    // Both precisions are kept in step, the host may switch between them without a new beginPlayback
+    floatCascade .setSections(bands.data(), num_bands, rampSamples);
+    doubleCascade.setSections(bands.data(), num_bands, rampSamples);
+}
+
 //======================================================================================================================
 EffectEqualizer::DataContext *EffectEqualizer::getNewContext() const
 {
@@ -114,3 +402,956 @@ jaut::DspGui *EffectEqualizer::getGuiType()
 }
 #pragma endregion EffectEqualizer
 #pragma endregion EffectModuleEqualizer
+#pragma region EffectModuleReverb
+#pragma region EffectReverbContext
+/* ==================================================================================
+ * ============================== EffectReverbContext ===============================
+ * ================================================================================== */
+struct EffectReverbContext : public EffectReverb::DataContext {};
+#pragma endregion EffectReverbContext
+#pragma region EffectReverb
+/* ==================================================================================
+ * ================================== EffectReverb ==================================
+ * ================================================================================== */
+EffectReverb::EffectReverb(DspUnit &processor, AudioProcessorValueTreeState &vts, UndoManager *undoManager)
+    : EffectModule(processor, vts, undoManager)
+{
+    initialize();
+}
+
+//======================================================================================================================
+void EffectReverb::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectReverb::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectReverb::beginPlayback(int index, double sampleRate, int)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    if (instances.size() <= static_cast<std::size_t>(index))
+    {
+        instances.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    std::vector<RangedAudioParameter*> parameters;
+
+    for (const char *id : parameterIds)
+    {
+        RangedAudioParameter *const parameter = getInstanceParameter(index, id);
+
+        if (parameter == nullptr)
+        {
+            // Without all of its parameters the instance is silent, it only ever adds a wet signal
+            jassertfalse;
+            instances[static_cast<std::size_t>(index)].reset();
+            return;
+        }
+
+        parameters.emplace_back(parameter);
+    }
+
+    auto instance = std::make_unique<Instance>();
+    instance->parameters = std::make_unique<ParameterStore>(std::move(parameters));
+
+    // The delay lines of both precisions come out of one arena each, allocated here once for the sample rate
+    instance->floatReverb .prepare(sampleRate);
+    instance->doubleReverb.prepare(sampleRate);
+
+    instance->parameters->update();
+    instance->updateReverbs(0);
+
+    instances[static_cast<std::size_t>(index)] = std::move(instance);
+}
+
+void EffectReverb::finishPlayback(int index)
+{
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())))
+    {
+        instances[static_cast<std::size_t>(index)].reset();
+    }
+}
+
+//======================================================================================================================
+int EffectReverb::getTailSamples(int index) const noexcept
+{
+    const int tail = EffectModule::getTailSamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return tail;
+    }
+
+    const int own_tail = instances[static_cast<std::size_t>(index)]->tailSamples.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<std::int64_t>(std::int64_t(tail) + own_tail, std::numeric_limits<int>::max()));
+}
+
+//======================================================================================================================
+std::vector<EffectReverb::SfxParameter> EffectReverb::createParameters() const
+{
+    std::vector<SfxParameter> parameters;
+
+    auto percent_value_to_text = [](float value) -> String
+    {
+        return String(roundToInt(value * 100.0f)) + " %";
+    };
+
+    auto seconds_value_to_text = [](float value) -> String
+    {
+        return String(value, 2) + " s";
+    };
+
+    auto milliseconds_value_to_text = [](float value) -> String
+    {
+        return String(value, 2) + " ms";
+    };
+
+    auto frequency_value_to_text = [](float value) -> String
+    {
+        return String(value, 2) + " Hz";
+    };
+
+    // Must stay in the order of the Parameter enum, that's the order the store indexes them by
+    parameters.emplace_back(SfxParameter(parameterIds[Size], "Size", "", {0.0f, 1.0f}, 0.5f,
+                                         percent_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Decay], "Decay", "", {0.1f, 20.0f, 0.0f, 0.3f}, 2.0f,
+                                         seconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Damping], "Damping", "", {0.0f, 1.0f}, 0.5f,
+                                         percent_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[ModulationDepth], "Modulation Depth", "",
+                                         {0.0f, static_cast<float>(FdnReverb<float>::MaxModulationDepthMs)}, 0.5f,
+                                         milliseconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[ModulationRate], "Modulation Rate", "",
+                                         {0.05f, 5.0f, 0.0f, 0.5f}, 0.5f, frequency_value_to_text, nullptr));
+
+    return parameters;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void EffectReverb::processInstance(int index, AudioBuffer<SampleType> &buffer)
+{
+    // Only ever blended in as a wet signal, so whatever isn't processed must not pass through dry
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        buffer.clear();
+        return;
+    }
+
+    Instance &instance = *instances[static_cast<std::size_t>(index)];
+    instance.parameters->update();
+
+    if (instance.parameters->hasChanges())
+    {
+        instance.updateReverbs(buffer.getNumSamples());
+    }
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        instance.floatReverb.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                     buffer.getNumSamples());
+    }
+    else
+    {
+        instance.doubleReverb.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                      buffer.getNumSamples());
+    }
+
+    for (int ch = MaxChannels; ch < buffer.getNumChannels(); ++ch)
+    {
+        buffer.clear(ch, 0, buffer.getNumSamples());
+    }
+}
+
+void EffectReverb::Instance::updateReverbs(int rampSamples) noexcept
+{
+    FdnReverbParameters settings;
+    settings.size              = parameters->get(Size);
+    settings.decaySeconds      = parameters->get(Decay);
+    settings.damping           = parameters->get(Damping);
+    settings.modulationDepthMs = parameters->get(ModulationDepth);
+    settings.modulationRate    = parameters->get(ModulationRate);
+
+    // Both precisions are kept in step, the host may switch between them without a new beginPlayback
+    floatReverb .setParameters(settings, rampSamples);
+    doubleReverb.setParameters(settings, rampSamples);
+
+    tailSamples.store(floatReverb.getTailSamples(), std::memory_order_relaxed);
+}
+
+//======================================================================================================================
+EffectReverb::DataContext *EffectReverb::getNewContext() const
+{
+    return new EffectReverbContext();
+}
+
+jaut::DspGui *EffectReverb::getGuiType()
+{
+    return new EffectReverbGui(*this);
+}
+#pragma endregion EffectReverb
+#pragma endregion EffectModuleReverb
+#pragma region EffectModuleConvolution
+#pragma region EffectConvolutionContext
+/* ==================================================================================
+ * ============================ EffectConvolutionContext ============================
+ * ================================================================================== */
+struct EffectConvolutionContext : public EffectConvolution::DataContext {};
+#pragma endregion EffectConvolutionContext
+#pragma region EffectConvolution
+/* ==================================================================================
+ * =============================== EffectConvolution ================================
+ * ================================================================================== */
+EffectConvolution::EffectConvolution(DspUnit &processor, AudioProcessorValueTreeState &vts, UndoManager *undoManager)
+    : EffectModule(processor, vts, undoManager),
+      impulseFiles(static_cast<std::size_t>(getMaxInstances()))
+{
+    initialize();
+}
+
+//======================================================================================================================
+void EffectConvolution::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectConvolution::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectConvolution::beginPlayback(int index, double sampleRate, int bufferSize)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    if (instances.size() <= static_cast<std::size_t>(index))
+    {
+        instances.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    std::vector<RangedAudioParameter*> parameters;
+
+    for (const char *id : parameterIds)
+    {
+        RangedAudioParameter *const parameter = getInstanceParameter(index, id);
+
+        if (parameter == nullptr)
+        {
+            // Without all of its parameters the instance is silent, it only ever adds a wet signal
+            jassertfalse;
+            instances[static_cast<std::size_t>(index)].reset();
+            return;
+        }
+
+        parameters.emplace_back(parameter);
+    }
+
+    reclaimer.start();
+
+    auto instance = std::make_unique<Instance>(reclaimer);
+    instance->parameters = std::make_unique<ParameterStore>(std::move(parameters));
+    instance->sampleRate = sampleRate;
+    instance->floatEngine .prepare(sampleRate, MaxChannels, bufferSize);
+    instance->doubleEngine.prepare(sampleRate, MaxChannels, bufferSize);
+
+    // Without a response there's no engine, and the instance is silent
+    if (const File &file = impulseFiles[static_cast<std::size_t>(index)]; file != File())
+    {
+        std::shared_ptr<const PartitionedImpulse> impulse;
+
+        if (impulseCache->load(file, sampleRate, impulse).wasOk())
+        {
+            instance->publishEngines(impulse);
+        }
+    }
+
+    instance->parameters->update();
+    instance->currentGain = instance->parameters->get(Gain);
+
+    instances[static_cast<std::size_t>(index)] = std::move(instance);
+}
+
+void EffectConvolution::finishPlayback(int index)
+{
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())))
+    {
+        instances[static_cast<std::size_t>(index)].reset();
+    }
+}
+
+//======================================================================================================================
+Result EffectConvolution::loadImpulseResponse(int index, const File &file)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())) && instances[static_cast<std::size_t>(index)])
+    {
+        Instance &instance = *instances[static_cast<std::size_t>(index)];
+        std::shared_ptr<const PartitionedImpulse> impulse;
+
+        if (const Result result = impulseCache->load(file, instance.sampleRate, impulse); result.failed())
+        {
+            return result;
+        }
+
+        instance.publishEngines(impulse);
+    }
+    else if (!file.existsAsFile())
+    {
+        return Result::fail("Impulse response not found: " + file.getFullPathName());
+    }
+
+    impulseFiles[static_cast<std::size_t>(index)] = file;
+    return Result::ok();
+}
+
+const File& EffectConvolution::getImpulseResponse(int index) const noexcept
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+    return impulseFiles[static_cast<std::size_t>(index)];
+}
+
+File EffectConvolution::getImpulseResponseDirectory()
+{
+    return SharedData::getInstance()->AppData().dirImpulses;
+}
+
+Array<File> EffectConvolution::findImpulseResponses()
+{
+    AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    return getImpulseResponseDirectory().findChildFiles(File::findFiles, true, formats.getWildcardForAllFormats());
+}
+
+//======================================================================================================================
+int EffectConvolution::getTailSamples(int index) const noexcept
+{
+    const int tail = EffectModule::getTailSamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return tail;
+    }
+
+    const int own_tail = instances[static_cast<std::size_t>(index)]->tailSamples.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<std::int64_t>(std::int64_t(tail) + own_tail, std::numeric_limits<int>::max()));
+}
+
+//======================================================================================================================
+std::vector<EffectConvolution::SfxParameter> EffectConvolution::createParameters() const
+{
+    std::vector<SfxParameter> parameters;
+
+    auto gain_value_to_text = [](float value) -> String
+    {
+        return String(Decibels::gainToDecibels(value, -60.0f), 1) + " dB";
+    };
+
+    // Must stay in the order of the Parameter enum, that's the order the store indexes them by
+    parameters.emplace_back(SfxParameter(parameterIds[Gain], "Gain", "", {0.0f, 3.98107f}, 1.0f,
+                                         gain_value_to_text, nullptr));
+
+    return parameters;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void EffectConvolution::processInstance(int index, AudioBuffer<SampleType> &buffer)
+{
+    // Only ever blended in as a wet signal, so whatever isn't processed must not pass through dry
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        buffer.clear();
+        return;
+    }
+
+    Instance &instance = *instances[static_cast<std::size_t>(index)];
+    instance.parameters->update();
+
+    // The precision not in use lets go of its engines, so that swapped out ones can be freed; without an engine there
+    // is no response yet, which is silence rather than the dry signal
+    const auto run_engine = [&buffer](auto &engine, auto &other)
+    {
+        other.leave();
+        engine.enter();
+
+        if (engine.getCurrent() != nullptr)
+        {
+            engine.process(buffer, false);
+        }
+        else
+        {
+            buffer.clear();
+        }
+    };
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        run_engine(instance.floatEngine, instance.doubleEngine);
+    }
+    else
+    {
+        run_engine(instance.doubleEngine, instance.floatEngine);
+    }
+
+    const float gain = instance.parameters->get(Gain);
+    buffer.applyGainRamp(0, buffer.getNumSamples(), static_cast<SampleType>(instance.currentGain),
+                         static_cast<SampleType>(gain));
+    instance.currentGain = gain;
+}
+
+void EffectConvolution::Instance::publishEngines(const std::shared_ptr<const PartitionedImpulse> &impulse)
+{
+    // Both precisions share the spectra, each has an engine of its own for its delay lines
+    auto float_engine  = std::make_unique<ConvolutionEngine>(impulse);
+    auto double_engine = std::make_unique<ConvolutionEngine>(impulse);
+    float_engine ->prepare(MaxChannels);
+    double_engine->prepare(MaxChannels);
+
+    floatEngine .publish(std::move(float_engine));
+    doubleEngine.publish(std::move(double_engine));
+
+    tailSamples.store(impulse->length, std::memory_order_relaxed);
+}
+
+//======================================================================================================================
+EffectConvolution::DataContext *EffectConvolution::getNewContext() const
+{
+    return new EffectConvolutionContext();
+}
+
+jaut::DspGui *EffectConvolution::getGuiType()
+{
+    return new EffectConvolutionGui(*this);
+}
+#pragma endregion EffectConvolution
+#pragma endregion EffectModuleConvolution
+#pragma region EffectModuleDynamics
+#pragma region EffectDynamicsContext
+/* ==================================================================================
+ * ============================= EffectDynamicsContext ==============================
+ * ================================================================================== */
+struct EffectDynamicsContext : public EffectDynamics::DataContext {};
+#pragma endregion EffectDynamicsContext
+#pragma region EffectDynamics
+/* ==================================================================================
+ * ================================= EffectDynamics =================================
+ * ================================================================================== */
+EffectDynamics::EffectDynamics(DspUnit &processor, AudioProcessorValueTreeState &vts, UndoManager *undoManager)
+    : EffectModule(processor, vts, undoManager),
+      lookaheadMs(static_cast<std::size_t>(getMaxInstances()), DefaultLookaheadMs)
+{
+    initialize();
+}
+
+//======================================================================================================================
+void EffectDynamics::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectDynamics::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectDynamics::beginPlayback(int index, double sampleRate, int bufferSize)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    const int previous_latency = getLatencySamples(index);
+
+    if (instances.size() <= static_cast<std::size_t>(index))
+    {
+        instances.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    std::vector<RangedAudioParameter*> parameters;
+
+    for (const char *id : parameterIds)
+    {
+        RangedAudioParameter *const parameter = getInstanceParameter(index, id);
+
+        if (parameter == nullptr)
+        {
+            // Without all of its parameters the instance passes the signal through untouched
+            jassertfalse;
+            instances[static_cast<std::size_t>(index)].reset();
+            return;
+        }
+
+        parameters.emplace_back(parameter);
+    }
+
+    auto instance = std::make_unique<Instance>();
+    instance->parameters = std::make_unique<ParameterStore>(std::move(parameters));
+    instance->sampleRate = sampleRate;
+    instance->lookaheadSamples.store(roundToInt(lookaheadMs[static_cast<std::size_t>(index)] * 0.001 * sampleRate),
+                                     std::memory_order_relaxed);
+
+    // The first update sees every parameter as changed, so the processors start out on the current settings
+    instance->parameters->update();
+    instance->updateDynamics();
+
+    // The delay lines are allocated for the longest lookahead, so that it can change without allocating
+    instance->numChannels = numChannels;
+    instance->floatDynamics .prepare(sampleRate, numChannels, bufferSize);
+    instance->doubleDynamics.prepare(sampleRate, numChannels, bufferSize);
+    instance->floatDynamics .setLookahead(instance->lookaheadSamples.load(std::memory_order_relaxed));
+    instance->doubleDynamics.setLookahead(instance->lookaheadSamples.load(std::memory_order_relaxed));
+
+    instances[static_cast<std::size_t>(index)] = std::move(instance);
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+void EffectDynamics::finishPlayback(int index)
+{
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())))
+    {
+        return;
+    }
+
+    const int previous_latency = getLatencySamples(index);
+    instances[static_cast<std::size_t>(index)].reset();
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+//======================================================================================================================
+void EffectDynamics::setLookahead(int index, float milliseconds)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    const int previous_latency = getLatencySamples(index);
+    milliseconds = jlimit(0.0f, static_cast<float>(DynamicsProcessor<float>::MaxLookaheadMs), milliseconds);
+    lookaheadMs[static_cast<std::size_t>(index)] = milliseconds;
+
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())) && instances[static_cast<std::size_t>(index)])
+    {
+        // The audio thread picks this up with its next block
+        Instance &instance = *instances[static_cast<std::size_t>(index)];
+        instance.lookaheadSamples.store(roundToInt(milliseconds * 0.001 * instance.sampleRate),
+                                        std::memory_order_relaxed);
+    }
+
+    if (onLatencyChanged && previous_latency != getLatencySamples(index))
+    {
+        onLatencyChanged();
+    }
+}
+
+float EffectDynamics::getLookahead(int index) const noexcept
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+    return lookaheadMs[static_cast<std::size_t>(index)];
+}
+
+int EffectDynamics::getLatencySamples(int index) const noexcept
+{
+    const int latency = EffectModule::getLatencySamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return latency;
+    }
+
+    return latency + instances[static_cast<std::size_t>(index)]->lookaheadSamples.load(std::memory_order_relaxed);
+}
+
+int EffectDynamics::getTailSamples(int index) const noexcept
+{
+    const int tail = EffectModule::getTailSamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return tail;
+    }
+
+    // Silence in is silence out whatever the gain, once the lookahead delay let go of what it still held
+    const int own_tail = instances[static_cast<std::size_t>(index)]->lookaheadSamples.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<std::int64_t>(std::int64_t(tail) + own_tail, std::numeric_limits<int>::max()));
+}
+
+//======================================================================================================================
+std::vector<EffectDynamics::SfxParameter> EffectDynamics::createParameters() const
+{
+    std::vector<SfxParameter> parameters;
+
+    auto mode_value_to_text = [](float value) -> String
+    {
+        return value < 0.5f ? "Compressor" : "Limiter";
+    };
+
+    auto key_value_to_text = [](float value) -> String
+    {
+        return value < 0.5f ? "Main" : "Sidechain";
+    };
+
+    auto decibels_value_to_text = [](float value) -> String
+    {
+        return String(value, 1) + " dB";
+    };
+
+    auto ratio_value_to_text = [](float value) -> String
+    {
+        return String(value, 1) + ":1";
+    };
+
+    auto milliseconds_value_to_text = [](float value) -> String
+    {
+        return String(value, 1) + " ms";
+    };
+
+    // Must stay in the order of the Parameter enum, that's the order the store indexes them by
+    parameters.emplace_back(SfxParameter(parameterIds[Mode], "Mode", "", {0.0f, 1.0f, 1.0f}, 0.0f,
+                                         mode_value_to_text, nullptr, false, true, true));
+    parameters.emplace_back(SfxParameter(parameterIds[Key], "Key", "", {0.0f, 1.0f, 1.0f}, 0.0f,
+                                         key_value_to_text, nullptr, false, true, true));
+    parameters.emplace_back(SfxParameter(parameterIds[Threshold], "Threshold", "", {-60.0f, 0.0f}, -12.0f,
+                                         decibels_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Ratio], "Ratio", "", {1.0f, 20.0f, 0.0f, 0.4f}, 4.0f,
+                                         ratio_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Knee], "Knee", "", {0.0f, 24.0f}, 6.0f,
+                                         decibels_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Attack], "Attack", "", {0.1f, 100.0f, 0.0f, 0.4f}, 10.0f,
+                                         milliseconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Release], "Release", "", {5.0f, 2000.0f, 0.0f, 0.3f}, 100.0f,
+                                         milliseconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Makeup], "Makeup", "", {0.0f, 24.0f}, 0.0f,
+                                         decibels_value_to_text, nullptr));
+
+    return parameters;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void EffectDynamics::processInstance(int index, AudioBuffer<SampleType> &buffer)
+{
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return;
+    }
+
+    Instance &instance = *instances[static_cast<std::size_t>(index)];
+    instance.parameters->update();
+
+    if (instance.parameters->hasChanges())
+    {
+        instance.updateDynamics();
+    }
+
+    // More channels than the instance was started with only come with a layout change that hasn't restarted it yet,
+    // those pass through as they are
+    jassert(buffer.getNumChannels() <= instance.numChannels);
+    const int num_channels = jmin(buffer.getNumChannels(), instance.numChannels);
+
+    // The key is read before the buffer is touched, so the main signal keys itself from all of its channels
+    const bool keyed_from_sidechain = instance.parameters->get(Key) >= 0.5f;
+    const AudioBuffer<SampleType> *key = &buffer;
+
+    if (keyed_from_sidechain)
+    {
+        key = sidechainKey != nullptr ? sidechainKey->get<SampleType>() : nullptr;
+    }
+
+    AudioBuffer<SampleType> channels(buffer.getArrayOfWritePointers(), num_channels, buffer.getNumSamples());
+    const int lookahead = instance.lookaheadSamples.load(std::memory_order_relaxed);
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        instance.floatDynamics.setLookahead(lookahead);
+        instance.floatDynamics.process(channels, key);
+    }
+    else
+    {
+        instance.doubleDynamics.setLookahead(lookahead);
+        instance.doubleDynamics.process(channels, key);
+    }
+}
+
+void EffectDynamics::Instance::updateDynamics() noexcept
+{
+    DynamicsParameters settings;
+    settings.mode      = parameters->get(Mode) >= 0.5f ? DynamicsParameters::Mode::Limiter
+                                                       : DynamicsParameters::Mode::Compressor;
+    settings.threshold = parameters->get(Threshold);
+    settings.ratio     = parameters->get(Ratio);
+    settings.knee      = parameters->get(Knee);
+    settings.attack    = parameters->get(Attack);
+    settings.release   = parameters->get(Release);
+    settings.makeup    = parameters->get(Makeup);
+
+    // Both precisions are kept in step, the host may switch between them without a new beginPlayback
+    floatDynamics .setParameters(settings);
+    doubleDynamics.setParameters(settings);
+}
+
+//======================================================================================================================
+EffectDynamics::DataContext *EffectDynamics::getNewContext() const
+{
+    return new EffectDynamicsContext();
+}
+
+jaut::DspGui *EffectDynamics::getGuiType()
+{
+    return new EffectDynamicsGui(*this);
+}
+#pragma endregion EffectDynamics
+#pragma endregion EffectModuleDynamics
+#pragma region EffectModuleDelay
+#pragma region EffectDelayContext
+/* ==================================================================================
+ * =============================== EffectDelayContext ===============================
+ * ================================================================================== */
+struct EffectDelayContext : public EffectDelay::DataContext {};
+#pragma endregion EffectDelayContext
+#pragma region EffectDelay
+/* ==================================================================================
+ * ================================== EffectDelay ===================================
+ * ================================================================================== */
+EffectDelay::EffectDelay(DspUnit &processor, AudioProcessorValueTreeState &vts, UndoManager *undoManager)
+    : EffectModule(processor, vts, undoManager),
+      compactStorage(static_cast<std::size_t>(getMaxInstances()), false)
+{
+    initialize();
+}
+
+//======================================================================================================================
+void EffectDelay::processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectDelay::processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer&)
+{
+    processInstance(index, buffer);
+}
+
+void EffectDelay::beginPlayback(int index, double sampleRate, int bufferSize)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+
+    if (instances.size() <= static_cast<std::size_t>(index))
+    {
+        instances.resize(static_cast<std::size_t>(index) + 1);
+    }
+
+    std::vector<RangedAudioParameter*> parameters;
+
+    for (const char *id : parameterIds)
+    {
+        RangedAudioParameter *const parameter = getInstanceParameter(index, id);
+
+        if (parameter == nullptr)
+        {
+            // Without all of its parameters the instance is silent, it only ever adds a wet signal
+            jassertfalse;
+            instances[static_cast<std::size_t>(index)].reset();
+            return;
+        }
+
+        parameters.emplace_back(parameter);
+    }
+
+    auto instance = std::make_unique<Instance>();
+    instance->parameters = std::make_unique<ParameterStore>(std::move(parameters));
+
+    // The first update sees every parameter as changed, so the delays start out on the current settings
+    instance->parameters->update();
+    instance->updateDelays(getTimeMs(*instance));
+
+    // The lines are allocated for the longest delay here once, changing the time later only crossfades
+    const bool is_compact = compactStorage[static_cast<std::size_t>(index)];
+    instance->floatDelay .prepare(sampleRate, bufferSize, is_compact);
+    instance->doubleDelay.prepare(sampleRate, bufferSize, is_compact);
+    instance->tailSamples.store(instance->floatDelay.getTailSamples(), std::memory_order_relaxed);
+
+    instances[static_cast<std::size_t>(index)] = std::move(instance);
+}
+
+void EffectDelay::finishPlayback(int index)
+{
+    if (isPositiveAndBelow(index, static_cast<int>(instances.size())))
+    {
+        instances[static_cast<std::size_t>(index)].reset();
+    }
+}
+
+//======================================================================================================================
+void EffectDelay::setCompactStorage(int index, bool isCompact)
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+    compactStorage[static_cast<std::size_t>(index)] = isCompact;
+}
+
+bool EffectDelay::isCompactStorage(int index) const noexcept
+{
+    jassert(isPositiveAndBelow(index, getMaxInstances()));
+    return compactStorage[static_cast<std::size_t>(index)];
+}
+
+int EffectDelay::getTailSamples(int index) const noexcept
+{
+    const int tail = EffectModule::getTailSamples(index);
+
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        return tail;
+    }
+
+    const int own_tail = instances[static_cast<std::size_t>(index)]->tailSamples.load(std::memory_order_relaxed);
+    return static_cast<int>(std::min<std::int64_t>(std::int64_t(tail) + own_tail, std::numeric_limits<int>::max()));
+}
+
+//======================================================================================================================
+std::vector<EffectDelay::SfxParameter> EffectDelay::createParameters() const
+{
+    std::vector<SfxParameter> parameters;
+
+    auto switch_value_to_text = [](float value) -> String
+    {
+        return value < 0.5f ? "Off" : "On";
+    };
+
+    auto division_value_to_text = [](float value) -> String
+    {
+        return divisionNames[static_cast<std::size_t>(jlimit(0, NumDivisions - 1, roundToInt(value)))];
+    };
+
+    auto percent_value_to_text = [](float value) -> String
+    {
+        return String(roundToInt(value * 100.0f)) + " %";
+    };
+
+    auto milliseconds_value_to_text = [](float value) -> String
+    {
+        return String(value, 1) + " ms";
+    };
+
+    auto frequency_value_to_text = [](float value) -> String
+    {
+        return String(value, 2) + " Hz";
+    };
+
+    const auto max_time  = static_cast<float>(ModulatedDelay<float>::MaxDelayMs);
+    const auto max_depth = static_cast<float>(ModulatedDelay<float>::MaxModulationDepthMs);
+
+    // Must stay in the order of the Parameter enum, that's the order the store indexes them by
+    parameters.emplace_back(SfxParameter(parameterIds[Time], "Time", "", {1.0f, max_time, 0.0f, 0.3f}, 350.0f,
+                                         milliseconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[Sync], "Sync", "", {0.0f, 1.0f, 1.0f}, 0.0f,
+                                         switch_value_to_text, nullptr, false, true, true));
+    parameters.emplace_back(SfxParameter(parameterIds[Division], "Division", "",
+                                         {0.0f, static_cast<float>(NumDivisions - 1), 1.0f}, 10.0f,
+                                         division_value_to_text, nullptr, false, true, true));
+    parameters.emplace_back(SfxParameter(parameterIds[Feedback], "Feedback", "", {0.0f, 0.95f}, 0.4f,
+                                         percent_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[PingPong], "Ping-Pong", "", {0.0f, 1.0f, 1.0f}, 0.0f,
+                                         switch_value_to_text, nullptr, false, true, true));
+    parameters.emplace_back(SfxParameter(parameterIds[LowCut], "Low Cut", "", {20.0f, 2000.0f, 0.0f, 0.3f}, 80.0f,
+                                         frequency_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[HighCut], "High Cut", "", {1000.0f, 20000.0f, 0.0f, 0.3f},
+                                         12000.0f, frequency_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[ModulationDepth], "Modulation Depth", "", {0.0f, max_depth},
+                                         0.0f, milliseconds_value_to_text, nullptr));
+    parameters.emplace_back(SfxParameter(parameterIds[ModulationRate], "Modulation Rate", "",
+                                         {0.05f, 5.0f, 0.0f, 0.5f}, 0.5f, frequency_value_to_text, nullptr));
+
+    return parameters;
+}
+
+//======================================================================================================================
+double EffectDelay::getTimeMs(const Instance &instance) const noexcept
+{
+    if (instance.parameters->get(Sync) < 0.5f)
+    {
+        return instance.parameters->get(Time);
+    }
+
+    const int division = jlimit(0, NumDivisions - 1, roundToInt(instance.parameters->get(Division)));
+    const double bpm   = hostTempo != nullptr ? hostTempo->getBpm() : HostTempo::DefaultBpm;
+    return divisionQuarterNotes[static_cast<std::size_t>(division)] * 60000.0 / bpm;
+}
+
+template<class SampleType>
+void EffectDelay::processInstance(int index, AudioBuffer<SampleType> &buffer)
+{
+    // Only ever blended in as a wet signal, so whatever isn't processed must not pass through dry
+    if (!isPositiveAndBelow(index, static_cast<int>(instances.size())) || !instances[static_cast<std::size_t>(index)])
+    {
+        buffer.clear();
+        return;
+    }
+
+    Instance &instance = *instances[static_cast<std::size_t>(index)];
+    instance.parameters->update();
+
+    // Synced, the time also changes with the tempo when no parameter did
+    const double time_ms = getTimeMs(instance);
+
+    if (instance.parameters->hasChanges() || time_ms != instance.timeMs)
+    {
+        instance.updateDelays(time_ms);
+    }
+
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        instance.floatDelay.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                    buffer.getNumSamples());
+    }
+    else
+    {
+        instance.doubleDelay.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                     buffer.getNumSamples());
+    }
+
+    for (int ch = MaxChannels; ch < buffer.getNumChannels(); ++ch)
+    {
+        buffer.clear(ch, 0, buffer.getNumSamples());
+    }
+}
+
+void EffectDelay::Instance::updateDelays(double newTimeMs) noexcept
+{
+    ModulatedDelayParameters settings;
+    settings.timeMs            = newTimeMs;
+    settings.feedback          = parameters->get(Feedback);
+    settings.pingPong          = parameters->get(PingPong) >= 0.5f;
+    settings.lowCutHz          = parameters->get(LowCut);
+    settings.highCutHz         = parameters->get(HighCut);
+    settings.modulationDepthMs = parameters->get(ModulationDepth);
+    settings.modulationRate    = parameters->get(ModulationRate);
+
+    // Both precisions are kept in step, the host may switch between them without a new beginPlayback
+    floatDelay .setParameters(settings);
+    doubleDelay.setParameters(settings);
+
+    timeMs = newTimeMs;
+    tailSamples.store(floatDelay.getTailSamples(), std::memory_order_relaxed);
+}
+
+//======================================================================================================================
+EffectDelay::DataContext *EffectDelay::getNewContext() const
+{
+    return new EffectDelayContext();
+}
+
+jaut::DspGui *EffectDelay::getGuiType()
+{
+    return new EffectDelayGui(*this);
+}
+#pragma endregion EffectDelay
+#pragma endregion EffectModuleDelay
@@ -28,25 +28,130 @@
 #include <jaut_audio/jaut_audio.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 
+#include "BiquadCascade.h"
+#include "ConvolutionEngine.h"
+#include "DynamicsProcessor.h"
+#include "FdnReverb.h"
+#include "HostTempo.h"
+#include "ImpulseResponseCache.h"
+#include "LinearPhaseConvolver.h"
+#include "LiveChain.h"
+#include "ModulatedDelay.h"
+#include "ModuleRegistry.h"
+#include "Oversampler.h"
+#include "ParameterStore.h"
+#include "SidechainKey.h"
+
 class EffectModule : public jaut::SfxUnit
 {
 public:
     EffectModule(DspUnit &unit, AudioProcessorValueTreeState &vts, UndoManager *undoManager = nullptr)
-        : SfxUnit(unit, vts, undoManager)
+        : SfxUnit(unit, vts, undoManager),
+          valueTreeState(vts)
     {}
 
     //==================================================================================================================
     virtual Rectangle<int> getIconCoordinates() const = 0;
     virtual Colour getColour() const = 0;
+
+    //==================================================================================================================
+    /** Gets the latency in samples the instance at the given index adds to the signal. */
+    virtual int getLatencySamples(int index) const noexcept;
+
+    /**
+     *  Gets for how many samples the output of the instance at the given index can keep sounding once its input went
+     *  silent, its latency included.
+     *  Hosts put instances to sleep once they saw that many silent samples in a row.
+     */
+    virtual int getTailSamples(int index) const noexcept;
+
+    /**
+     *  Called whenever the latency of any instance changed,
+     *  so that the processor can re-report its total latency to the host through setLatencySamples.
+     */
+    std::function<void()> onLatencyChanged;
+
+protected:
+    /**
+     *  Sets up oversampling for an instance, this may only be called from beginPlayback.
+     *  Oversamplers for both precisions are created, as the host may switch precision without a new beginPlayback.
+     *
+     *  @param index            The index of the instance
+     *  @param numChannels      The number of channels to oversample
+     *  @param maximumBlockSize The maximum block size as passed to beginPlayback
+     *  @param factorLog2       The oversampling factor as a power of two, from 1 (2x) to 3 (8x)
+     *  @param filterType       The filter family of the half-band stages
+     */
+    void requestOversampling(int index, int numChannels, int maximumBlockSize, int factorLog2,
+                             OversamplingFilter filterType);
+
+    /** Frees the oversamplers of an instance again, usually from finishPlayback. */
+    void releaseOversampling(int index);
+
+    /**
+     *  Gets the parameter of an instance by the id it was given in createParameters.
+     *
+     *  @param index       The index of the instance
+     *  @param parameterId The id of the parameter as in createParameters
+     *  @return The parameter or nullptr if there is none with this id
+     */
+    RangedAudioParameter* getInstanceParameter(int index, const String &parameterId) const;
+
+    /** Gets the oversampler of an instance, or nullptr if the instance didn't request oversampling. */
+    template<class SampleType>
+    Oversampler<SampleType>* getOversampler(int index) const noexcept
+    {
+        if (!isPositiveAndBelow(index, static_cast<int>(oversamplers.size())))
+        {
+            return nullptr;
+        }
+
+        const OversamplerPair &pair = oversamplers[static_cast<std::size_t>(index)];
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            return pair.floatOversampler.get();
+        }
+        else
+        {
+            return pair.doubleOversampler.get();
+        }
+    }
+
+private:
+    struct OversamplerPair
+    {
+        std::unique_ptr<Oversampler<float>>  floatOversampler;
+        std::unique_ptr<Oversampler<double>> doubleOversampler;
+    };
+
+    //==================================================================================================================
+    AudioProcessorValueTreeState &valueTreeState;
+    std::vector<OversamplerPair> oversamplers;
 };
 
 class EffectEqualizer final : public EffectModule
 {
 public:
+    struct LinearPhaseOptions
+    {
+        /** Whether the instance runs as linear-phase FIR instead of its minimum-phase biquads. */
+        bool enabled { false };
+
+        /** The kernel size as a power of two, the latency is half the kernel. */
+        int kernelOrder { LinearPhaseConvolver::DefaultKernelOrder };
+
+        /** The partition size as a power of two, which adds one partition of latency. */
+        int partitionOrder { LinearPhaseConvolver::DefaultPartitionOrder };
+    };
+
+    static constexpr const char *ModuleId = "Equalizer";
+
+    //==================================================================================================================
     EffectEqualizer(DspUnit&, AudioProcessorValueTreeState&, UndoManager*);
 
     //==================================================================================================================
-    const String getName() const override { return "Equalizer"; }
+    const String getName() const override { return ModuleId; }
     bool hasEditor() const override { return true; }
 
     //==================================================================================================================
@@ -60,11 +165,466 @@ public:
     int getMaxInstances() const override { return 5; }
     DataContext *getNewContext() const override;
 
+    //==================================================================================================================
+    /**
+     *  Sets the linear-phase options of an instance, call this from the message thread.
+     *  Switching the mode takes effect right away, the sizes only with the next beginPlayback.
+     *
+     *  @param index   The index of the instance
+     *  @param options The new options
+     */
+    void setLinearPhaseOptions(int index, const LinearPhaseOptions &options);
+    const LinearPhaseOptions& getLinearPhaseOptions(int index) const noexcept;
+
+    int getLatencySamples(int index) const noexcept override;
+    int getTailSamples(int index) const noexcept override;
+
     //==================================================================================================================
     int getMaxBands() const noexcept { return 30; }
     Rectangle<int> getIconCoordinates() const override { return {128, 0, 32, 32}; }
     Colour getColour() const override { return Colour(255, 123, 59); }
 
 private:
+    template<class> friend class ModuleRegistry;
+
+    struct Instance
+    {
+        std::unique_ptr<ParameterStore> parameters;
+        std::array<BiquadCoefficients, 30> bands;
+        std::array<int, 30> bandTails {};
+        BiquadCascade<float>  floatCascade;
+        BiquadCascade<double> doubleCascade;
+        LinearPhaseConvolver linearPhase;
+        std::atomic<bool> linearPhaseEnabled { false };
+        std::atomic<int> tailSamples { 0 };
+        bool linearPhaseRunning { false };
+        double sampleRate { 44100.0 };
+
+        //==============================================================================================================
+        void updateBands(int rampSamples) noexcept;
+    };
+
+    //==================================================================================================================
+    std::vector<std::unique_ptr<Instance>> instances;
+    std::vector<LinearPhaseOptions> linearPhaseOptions;
+
+    //==================================================================================================================
+    jaut::DspGui *getGuiType() override;
+
+    //==================================================================================================================
+    template<class SampleType>
+    void processInstance(int, AudioBuffer<SampleType>&);
+};
+
+class EffectReverb final : public EffectModule
+{
+public:
+    static constexpr const char *ModuleId = "Reverb";
+
+    /** The largest number of channels an instance reverberates, any further ones are muted. */
+    static constexpr int MaxChannels = FdnReverb<float>::MaxChannels;
+
+    //==================================================================================================================
+    EffectReverb(DspUnit&, AudioProcessorValueTreeState&, UndoManager*);
+
+    //==================================================================================================================
+    const String getName() const override { return ModuleId; }
+    bool hasEditor() const override { return true; }
+
+    //==================================================================================================================
+    void processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer &midiBuffer) override;
+    void processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer &midiBuffer) override;
+    void beginPlayback(int index, double sampleRate, int bufferSize) override;
+    void finishPlayback(int index) override;
+
+    //==================================================================================================================
+    std::vector<SfxParameter> createParameters() const override;
+    int getMaxInstances() const override { return 5; }
+    DataContext *getNewContext() const override;
+
+    //==================================================================================================================
+    int getTailSamples(int index) const noexcept override;
+
+    //==================================================================================================================
+    Rectangle<int> getIconCoordinates() const override { return {0, 0, 32, 32}; }
+    Colour getColour() const override { return Colour(0, 210, 54); }
+
+private:
+    template<class> friend class ModuleRegistry;
+
+    /** The indices of the parameters in the store of an instance, in the order of createParameters. */
+    enum Parameter
+    {
+        Size,
+        Decay,
+        Damping,
+        ModulationDepth,
+        ModulationRate,
+        NumParameters
+    };
+
+    struct Instance
+    {
+        std::unique_ptr<ParameterStore> parameters;
+        FdnReverb<float>  floatReverb;
+        FdnReverb<double> doubleReverb;
+        std::atomic<int> tailSamples { 0 };
+
+        //==============================================================================================================
+        void updateReverbs(int rampSamples) noexcept;
+    };
+
+    //==================================================================================================================
+    static constexpr std::array<const char*, NumParameters> parameterIds {
+        "size", "decay", "damping", "mod_depth", "mod_rate"
+    };
+
+    //==================================================================================================================
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    //==================================================================================================================
+    jaut::DspGui *getGuiType() override;
+
+    //==================================================================================================================
+    template<class SampleType>
+    void processInstance(int, AudioBuffer<SampleType>&);
+};
+
+class EffectConvolution final : public EffectModule
+{
+public:
+    static constexpr const char *ModuleId = "Convolution";
+
+    /** The largest number of channels an instance convolves, any further ones are muted. */
+    static constexpr int MaxChannels = ConvolutionEngine::MaxChannels;
+
+    //==================================================================================================================
+    EffectConvolution(DspUnit&, AudioProcessorValueTreeState&, UndoManager*);
+
+    //==================================================================================================================
+    const String getName() const override { return ModuleId; }
+    bool hasEditor() const override { return true; }
+
+    //==================================================================================================================
+    void processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer &midiBuffer) override;
+    void processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer &midiBuffer) override;
+    void beginPlayback(int index, double sampleRate, int bufferSize) override;
+    void finishPlayback(int index) override;
+
+    //==================================================================================================================
+    std::vector<SfxParameter> createParameters() const override;
+    int getMaxInstances() const override { return 4; }
+    DataContext *getNewContext() const override;
+
+    //==================================================================================================================
+    /**
+     *  Sets the impulse response of an instance, call this from the message thread.
+     *  While playing, the response is loaded and partitioned right away and crossfaded to without interrupting the
+     *  audio; otherwise it's loaded with the next beginPlayback.
+     *
+     *  @param index The index of the instance
+     *  @param file  The file to load
+     *  @return Whether the file could be loaded, with the reason if not
+     */
+    Result loadImpulseResponse(int index, const File &file);
+
+    /** Gets the impulse response file of an instance, which is no file at all if it has none. */
+    const File& getImpulseResponse(int index) const noexcept;
+
+    /** Gets the directory in the user's application data the impulse responses are looked for in. */
+    static File getImpulseResponseDirectory();
+
+    /** Lists all impulse responses in the impulse response directory and its subdirectories. */
+    static Array<File> findImpulseResponses();
+
+    //==================================================================================================================
+    int getTailSamples(int index) const noexcept override;
+
+    //==================================================================================================================
+    Rectangle<int> getIconCoordinates() const override { return {32, 0, 32, 32}; }
+    Colour getColour() const override { return Colour(0, 152, 210); }
+
+private:
+    template<class> friend class ModuleRegistry;
+
+    /** The indices of the parameters in the store of an instance, in the order of createParameters. */
+    enum Parameter
+    {
+        Gain,
+        NumParameters
+    };
+
+    struct Instance
+    {
+        explicit Instance(EpochReclaimer &reclaimer)
+            : floatEngine(reclaimer),
+              doubleEngine(reclaimer)
+        {}
+
+        //==============================================================================================================
+        std::unique_ptr<ParameterStore> parameters;
+        LiveChain<float,  ConvolutionEngine> floatEngine;
+        LiveChain<double, ConvolutionEngine> doubleEngine;
+        std::atomic<int> tailSamples { 0 };
+        double sampleRate { 0.0 };
+
+        // Audio thread only, the gain the last block ended on
+        float currentGain { 1.0f };
+
+        //==============================================================================================================
+        void publishEngines(const std::shared_ptr<const PartitionedImpulse> &impulse);
+    };
+
+    //==================================================================================================================
+    static constexpr std::array<const char*, NumParameters> parameterIds {
+        "gain"
+    };
+
+    //==================================================================================================================
+    // Declared before the instances, so that it's still there when they retire their last engines
+    EpochReclaimer reclaimer;
+    SharedResourcePointer<ImpulseResponseCache> impulseCache;
+    std::vector<File> impulseFiles;
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    //==================================================================================================================
+    jaut::DspGui *getGuiType() override;
+
+    //==================================================================================================================
+    template<class SampleType>
+    void processInstance(int, AudioBuffer<SampleType>&);
+};
+
+class EffectDynamics final : public EffectModule
+{
+public:
+    static constexpr const char *ModuleId = "Dynamics";
+
+    /** The lookahead instances start out with, in milliseconds. */
+    static constexpr float DefaultLookaheadMs = 5.0f;
+
+    //==================================================================================================================
+    EffectDynamics(DspUnit&, AudioProcessorValueTreeState&, UndoManager*);
+
+    //==================================================================================================================
+    const String getName() const override { return ModuleId; }
+    bool hasEditor() const override { return true; }
+
+    //==================================================================================================================
+    void processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer &midiBuffer) override;
+    void processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer &midiBuffer) override;
+    void beginPlayback(int index, double sampleRate, int bufferSize) override;
+    void finishPlayback(int index) override;
+
+    //==================================================================================================================
+    std::vector<SfxParameter> createParameters() const override;
+    int getMaxInstances() const override { return 4; }
+    DataContext *getNewContext() const override;
+
+    //==================================================================================================================
+    /**
+     *  Sets where the instances keyed from the sidechain find it, usually the processor's; call this before playback.
+     *  Without one, these instances have nothing to react to and leave the signal as it is.
+     */
+    void setSidechainKey(const SidechainKey *key) noexcept { sidechainKey = key; }
+
+    /**
+     *  Sets how many channels the instances process, usually as many as the processor's main bus has; call this before
+     *  playback, it takes effect with the next beginPlayback. Any further channels are passed through untouched.
+     */
+    void setNumChannels(int newNumChannels) noexcept { numChannels = jmax(1, newNumChannels); }
+
+    /**
+     *  Sets the lookahead of an instance, call this from the message thread.
+     *  The lookahead is also the latency of the instance, the change is reported through onLatencyChanged.
+     *
+     *  @param index        The index of the instance
+     *  @param milliseconds The new lookahead, up to DynamicsProcessor::MaxLookaheadMs
+     */
+    void setLookahead(int index, float milliseconds);
+    float getLookahead(int index) const noexcept;
+
+    int getLatencySamples(int index) const noexcept override;
+    int getTailSamples(int index) const noexcept override;
+
+    //==================================================================================================================
+    Rectangle<int> getIconCoordinates() const override { return {64, 0, 32, 32}; }
+    Colour getColour() const override { return Colour(226, 58, 88); }
+
+private:
+    template<class> friend class ModuleRegistry;
+
+    /** The indices of the parameters in the store of an instance, in the order of createParameters. */
+    enum Parameter
+    {
+        Mode,
+        Key,
+        Threshold,
+        Ratio,
+        Knee,
+        Attack,
+        Release,
+        Makeup,
+        NumParameters
+    };
+
+    struct Instance
+    {
+        std::unique_ptr<ParameterStore> parameters;
+        DynamicsProcessor<float>  floatDynamics;
+        DynamicsProcessor<double> doubleDynamics;
+        std::atomic<int> lookaheadSamples { 0 };
+        double sampleRate { 44100.0 };
+        int numChannels   { 0 };
+
+        //==============================================================================================================
+        void updateDynamics() noexcept;
+    };
+
+    //==================================================================================================================
+    static constexpr std::array<const char*, NumParameters> parameterIds {
+        "mode", "key", "threshold", "ratio", "knee", "attack", "release", "makeup"
+    };
+
+    //==================================================================================================================
+    const SidechainKey *sidechainKey { nullptr };
+    int numChannels { 2 };
+    std::vector<float> lookaheadMs;
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    //==================================================================================================================
     jaut::DspGui *getGuiType() override;
+
+    //==================================================================================================================
+    template<class SampleType>
+    void processInstance(int, AudioBuffer<SampleType>&);
 };
+
+class EffectDelay final : public EffectModule
+{
+public:
+    static constexpr const char *ModuleId = "Delay";
+
+    /** The largest number of channels an instance delays, any further ones are muted. */
+    static constexpr int MaxChannels = ModulatedDelay<float>::MaxChannels;
+
+    //==================================================================================================================
+    EffectDelay(DspUnit&, AudioProcessorValueTreeState&, UndoManager*);
+
+    //==================================================================================================================
+    const String getName() const override { return ModuleId; }
+    bool hasEditor() const override { return true; }
+
+    //==================================================================================================================
+    void processEffect(int index, AudioBuffer<float> &buffer,  MidiBuffer &midiBuffer) override;
+    void processEffect(int index, AudioBuffer<double> &buffer, MidiBuffer &midiBuffer) override;
+    void beginPlayback(int index, double sampleRate, int bufferSize) override;
+    void finishPlayback(int index) override;
+
+    //==================================================================================================================
+    std::vector<SfxParameter> createParameters() const override;
+    int getMaxInstances() const override { return 4; }
+    DataContext *getNewContext() const override;
+
+    //==================================================================================================================
+    /**
+     *  Sets where the instances synced to the host find its tempo, usually the processor's; call this before playback.
+     *  Without one, they sync to HostTempo::DefaultBpm.
+     */
+    void setHostTempo(const HostTempo *tempo) noexcept { hostTempo = tempo; }
+
+    /**
+     *  Sets whether an instance keeps its delay lines as 16-bit integers, which halves their memory or better for a
+     *  noise floor around -84 dB; call this from the message thread. Takes effect with the next beginPlayback.
+     *
+     *  @param index     The index of the instance
+     *  @param isCompact Whether the lines are stored compactly
+     */
+    void setCompactStorage(int index, bool isCompact);
+    bool isCompactStorage(int index) const noexcept;
+
+    int getTailSamples(int index) const noexcept override;
+
+    //==================================================================================================================
+    Rectangle<int> getIconCoordinates() const override { return {96, 0, 32, 32}; }
+    Colour getColour() const override { return Colour(164, 92, 255); }
+
+private:
+    template<class> friend class ModuleRegistry;
+
+    /** The indices of the parameters in the store of an instance, in the order of createParameters. */
+    enum Parameter
+    {
+        Time,
+        Sync,
+        Division,
+        Feedback,
+        PingPong,
+        LowCut,
+        HighCut,
+        ModulationDepth,
+        ModulationRate,
+        NumParameters
+    };
+
+    static constexpr int NumDivisions = 16;
+
+    struct Instance
+    {
+        std::unique_ptr<ParameterStore> parameters;
+        ModulatedDelay<float>  floatDelay;
+        ModulatedDelay<double> doubleDelay;
+        std::atomic<int> tailSamples { 0 };
+
+        // Audio thread only, the time the delays were last set to, which follows the tempo when synced
+        double timeMs { 0.0 };
+
+        //==============================================================================================================
+        void updateDelays(double newTimeMs) noexcept;
+    };
+
+    //==================================================================================================================
+    static constexpr std::array<const char*, NumParameters> parameterIds {
+        "time", "sync", "division", "feedback", "ping_pong", "low_cut", "high_cut", "mod_depth", "mod_rate"
+    };
+
+    /** The note values the time syncs to, from a sixty-fourth to a whole note. */
+    static constexpr std::array<const char*, NumDivisions> divisionNames {
+        "1/64", "1/32T", "1/32", "1/16T", "1/16", "1/16D", "1/8T", "1/8",
+        "1/8D", "1/4T",  "1/4",  "1/4D",  "1/2T", "1/2",   "1/2D", "1/1"
+    };
+
+    /** The lengths of the note values in quarter notes. */
+    static constexpr std::array<double, NumDivisions> divisionQuarterNotes {
+        1.0 / 16.0, 1.0 / 12.0, 1.0 / 8.0, 1.0 / 6.0, 1.0 / 4.0, 3.0 / 8.0, 1.0 / 3.0, 1.0 / 2.0,
+        3.0 / 4.0,  2.0 / 3.0,  1.0,       3.0 / 2.0, 4.0 / 3.0, 2.0,       3.0,       4.0
+    };
+
+    //==================================================================================================================
+    const HostTempo *hostTempo { nullptr };
+    std::vector<bool> compactStorage;
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    //==================================================================================================================
+    jaut::DspGui *getGuiType() override;
+
+    //==================================================================================================================
+    double getTimeMs(const Instance&) const noexcept;
+
+    template<class SampleType>
+    void processInstance(int, AudioBuffer<SampleType>&);
+};
+
+//======================================================================================================================
+/**
+ *  All effect modules there are, in the order of their type indices; new modules go at the end.
+ *  Hosts keep modules in EffectModuleRegistry::Slot arrays, so that the audio thread calls them statically.
+ */
+using EffectModuleList     = jaut::TypeArray<
+    EffectEqualizer,
+    EffectReverb,
+    EffectConvolution,
+    EffectDynamics,
+    EffectDelay
+>;
+using EffectModuleRegistry = ModuleRegistry<EffectModuleList>;
@@ -0,0 +1,169 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   EpochReclaimer.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "EpochReclaimer.h"
+
+#include <algorithm>
+
+//======================================================================================================================
+EpochReclaimer::ReadGuard::ReadGuard(EpochReclaimer &owner) noexcept
+    : reclaimer(owner)
+{
+    // Only ever runs out with more threads reading at once than there are slots, then it's a matter of waiting
+    while ((reader = reclaimer.registerReader()) < 0)
+    {
+        juce::Thread::yield();
+    }
+
+    reclaimer.pin(reader, reclaimer.getEpoch());
+}
+
+EpochReclaimer::ReadGuard::~ReadGuard()
+{
+    reclaimer.unpin(reader);
+    reclaimer.unregisterReader(reader);
+}
+
+//======================================================================================================================
+EpochReclaimer::EpochReclaimer()
+    : juce::Thread("Cossin Chain Reclaimer")
+{
+    for (std::atomic<std::uint64_t> &slot : pins)
+    {
+        slot.store(Unclaimed, std::memory_order_relaxed);
+    }
+}
+
+EpochReclaimer::~EpochReclaimer()
+{
+    stop();
+}
+
+//======================================================================================================================
+void EpochReclaimer::start()
+{
+    startThread();
+}
+
+void EpochReclaimer::stop()
+{
+    stopThread(-1);
+    freeAll();
+}
+
+//======================================================================================================================
+int EpochReclaimer::registerReader() noexcept
+{
+    for (int i = 0; i < MaxReaders; ++i)
+    {
+        std::uint64_t expected = Unclaimed;
+
+        if (pins[static_cast<std::size_t>(i)].compare_exchange_strong(expected, NotPinned, std::memory_order_acq_rel))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void EpochReclaimer::unregisterReader(int reader) noexcept
+{
+    jassert(juce::isPositiveAndBelow(reader, MaxReaders));
+    jassert(pins[static_cast<std::size_t>(reader)].load(std::memory_order_relaxed) == NotPinned);
+    pins[static_cast<std::size_t>(reader)].store(Unclaimed, std::memory_order_release);
+}
+
+void EpochReclaimer::pin(int reader, std::uint64_t pinnedEpoch) noexcept
+{
+    jassert(juce::isPositiveAndBelow(reader, MaxReaders));
+
+    // Sequentially consistent, the pin has to be visible before the reader loads what it protects
+    pins[static_cast<std::size_t>(reader)].store(pinnedEpoch, std::memory_order_seq_cst);
+}
+
+//======================================================================================================================
+void EpochReclaimer::retire(void *object, void (*deleter)(void*))
+{
+    {
+        const juce::ScopedLock lock(retiredLock);
+        retired.push_back({ object, deleter, epoch.load(std::memory_order_seq_cst) });
+    }
+
+    epoch.fetch_add(1, std::memory_order_seq_cst);
+    notify();
+}
+
+void EpochReclaimer::reclaim()
+{
+    // Unclaimed and NotPinned are larger than any real epoch, so they never hold anything back
+    std::uint64_t oldest_pin = NotPinned;
+
+    for (const std::atomic<std::uint64_t> &slot : pins)
+    {
+        oldest_pin = std::min(oldest_pin, slot.load(std::memory_order_seq_cst));
+    }
+
+    std::vector<Retired> expired;
+
+    {
+        const juce::ScopedLock lock(retiredLock);
+        const auto first_expired = std::stable_partition(retired.begin(), retired.end(), [oldest_pin](const Retired &r)
+        {
+            return r.epoch >= oldest_pin;
+        });
+
+        expired.assign(first_expired, retired.end());
+        retired.erase(first_expired, retired.end());
+    }
+
+    // Freeing may take its time, chains stop threads of their own, so it happens outside the lock
+    for (const Retired &object : expired)
+    {
+        object.deleter(object.object);
+    }
+}
+
+//======================================================================================================================
+void EpochReclaimer::run()
+{
+    while (!threadShouldExit())
+    {
+        reclaim();
+        wait(ReclaimIntervalMs);
+    }
+}
+
+void EpochReclaimer::freeAll()
+{
+    const juce::ScopedLock lock(retiredLock);
+
+    for (const Retired &object : retired)
+    {
+        object.deleter(object.object);
+    }
+
+    retired.clear();
+}
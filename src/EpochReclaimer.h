@@ -0,0 +1,139 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   EpochReclaimer.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ *  Frees objects that were swapped out from under lock-free readers, once no reader can still be looking at them.
+ *
+ *  Epoch-based reclamation: there is a global epoch, and every reader pins the epoch it read before it loads any
+ *  pointer it is going to use. The writer swaps a pointer first and retires the old object afterwards, tagged with
+ *  the epoch at that moment, then moves the epoch on. A reader that pinned a later epoch can only have seen the new
+ *  pointer, so an object is freed once every pinned reader is past the epoch it was retired in.
+ *
+ *  Readers pin and unpin with a single atomic store, they never lock, allocate or free anything. A reader may also
+ *  keep an older pin for as long as it holds on to the objects it loaded then.
+ *  Retiring and freeing happen off the audio thread, the freeing on a background thread of its own which runs between
+ *  start() and stop().
+ */
+class EpochReclaimer final : private juce::Thread
+{
+public:
+    static constexpr int MaxReaders          = 16;
+    static constexpr int ReclaimIntervalMs   = 50;
+    static constexpr std::uint64_t NotPinned = std::numeric_limits<std::uint64_t>::max() - 1;
+
+    //==================================================================================================================
+    /** Pins the current epoch for as long as it exists, for short reads from any thread. */
+    class ReadGuard final
+    {
+    public:
+        explicit ReadGuard(EpochReclaimer &reclaimer) noexcept;
+        ~ReadGuard();
+
+    private:
+        EpochReclaimer &reclaimer;
+        int reader;
+
+        JUCE_DECLARE_NON_COPYABLE(ReadGuard)
+    };
+
+    //==================================================================================================================
+    EpochReclaimer();
+    ~EpochReclaimer() override;
+
+    //==================================================================================================================
+    /** Starts the background thread. */
+    void start();
+
+    /** Stops the background thread and frees everything that was retired, no reader may be pinned anymore. */
+    void stop();
+
+    //==================================================================================================================
+    /** Claims a reader slot that stays unpinned until pin() is called, or returns -1 if all are taken. */
+    int registerReader() noexcept;
+
+    /** Gives a reader slot back, it must not be pinned anymore. */
+    void unregisterReader(int reader) noexcept;
+
+    /** Gets the current epoch, for a reader to pin before it loads anything. */
+    std::uint64_t getEpoch() const noexcept { return epoch.load(std::memory_order_seq_cst); }
+
+    /** Pins an epoch for a reader, the current one or one it pinned before. */
+    void pin(int reader, std::uint64_t pinnedEpoch) noexcept;
+
+    /** Marks a reader as not holding anything. */
+    void unpin(int reader) noexcept { pin(reader, NotPinned); }
+
+    //==================================================================================================================
+    /**
+     *  Hands over an object that was just swapped out, it gets freed once no reader can see it anymore.
+     *  Must be called after the swap and never from the audio thread.
+     */
+    template<class Object>
+    void retire(std::unique_ptr<Object> object)
+    {
+        if (object)
+        {
+            retire(object.release(), [](void *pointer) { delete static_cast<Object*>(pointer); });
+        }
+    }
+
+    /** Frees everything that was retired and can't be seen anymore, the background thread does this regularly. */
+    void reclaim();
+
+private:
+    static constexpr std::uint64_t Unclaimed = std::numeric_limits<std::uint64_t>::max();
+
+    struct Retired
+    {
+        void *object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    //==================================================================================================================
+    std::array<std::atomic<std::uint64_t>, MaxReaders> pins;
+    std::atomic<std::uint64_t> epoch { 0 };
+
+    juce::CriticalSection retiredLock;
+    std::vector<Retired> retired;
+
+    //==================================================================================================================
+    void run() override;
+    void retire(void *object, void (*deleter)(void*));
+    void freeAll();
+
+    JUCE_DECLARE_NON_COPYABLE(EpochReclaimer)
+};
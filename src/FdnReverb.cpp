@@ -0,0 +1,388 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   FdnReverb.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "FdnReverb.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/** The lengths of the delay lines at the largest size in milliseconds, spread so that their echoes don't line up. */
+constexpr std::array<double, 8> lineLengthsMs { 37.3, 41.9, 46.7, 51.1, 56.9, 61.3, 67.1, 73.7 };
+
+/** How much the lines shrink at the smallest size, relative to the largest. */
+constexpr double minimumSizeScale = 0.2;
+
+/** How much the modulation rates of the lines spread around the rate that was set, so that they never lock. */
+constexpr double modulationRateSpread = 0.4;
+
+//======================================================================================================================
+/** The sign of an entry of a Hadamard matrix in Sylvester's construction. */
+constexpr int getHadamardSign(int row, int column) noexcept
+{
+    int bits = row & column;
+    int sign = 1;
+
+    while (bits != 0)
+    {
+        sign   = -sign;
+        bits &= bits - 1;
+    }
+
+    return sign;
+}
+
+/** The gain a line has to apply per pass so that the signal decays by 60 dB after the given time. */
+double getDecayGain(double lineSamples, double decaySamples) noexcept
+{
+    return std::pow(10.0, -3.0 * lineSamples / decaySamples);
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void FdnReverb<SampleType>::prepare(double newSampleRate)
+{
+    static_assert(NumLines == static_cast<int>(lineLengthsMs.size()));
+    static_assert((NumLines / 2) % NumLanes == 0, "Each half of the lines has to fill whole vectors");
+
+    sampleRate = newSampleRate;
+
+    // Every line gets its own power of two with room for its longest length and the deepest modulation, so that
+    // reading and writing wraps with a mask
+    const double samples_per_ms = sampleRate / 1000.0;
+    int arena_size = 0;
+
+    for (int i = 0; i < NumLines; ++i)
+    {
+        const double longest = lineLengthsMs[static_cast<std::size_t>(i)] * samples_per_ms
+                               + MaxModulationDepthMs * samples_per_ms + 2.0;
+        const int line_size  = juce::nextPowerOfTwo(static_cast<int>(std::ceil(longest)));
+
+        lineOffsets[static_cast<std::size_t>(i)] = arena_size;
+        lineMasks  [static_cast<std::size_t>(i)] = line_size - 1;
+        arena_size += simd::getAlignedSize<SampleType>(line_size);
+    }
+
+    arena.allocate(static_cast<std::size_t>(arena_size));
+    arenaSize = arena_size;
+
+    // Keeping every channel's energy about the same whichever row of signs it goes through the lines with
+    const SampleType tap_gain = static_cast<SampleType>(1.0 / std::sqrt(static_cast<double>(NumLines)));
+
+    for (int ch = 0; ch < MaxChannels; ++ch)
+    {
+        for (int i = 0; i < NumLines; ++i)
+        {
+            const SampleType tap = tap_gain * static_cast<SampleType>(getHadamardSign(ch % NumLines, i));
+            inputTaps [static_cast<std::size_t>(ch)][static_cast<std::size_t>(i)] = tap;
+            outputTaps[static_cast<std::size_t>(ch)][static_cast<std::size_t>(i)] = tap;
+        }
+    }
+
+    setParameters(currentParameters, 0);
+    reset();
+}
+
+template<class SampleType>
+void FdnReverb<SampleType>::release()
+{
+    arena     = simd::AlignedBlock<SampleType>();
+    arenaSize = 0;
+}
+
+template<class SampleType>
+void FdnReverb<SampleType>::reset() noexcept
+{
+    if (isPrepared())
+    {
+        std::fill(arena.get(), arena.get() + arenaSize, SampleType(0));
+    }
+
+    filterStates .fill(SampleType(0));
+    allpassStates.fill(SampleType(0));
+    writePosition = 0;
+    resetModulation();
+}
+
+//======================================================================================================================
+template<class SampleType>
+void FdnReverb<SampleType>::setParameters(const Parameters &parameters, int rampSamples) noexcept
+{
+    currentParameters = parameters;
+
+    const double samples_per_ms = sampleRate / 1000.0;
+    const double size_scale     = minimumSizeScale + (1.0 - minimumSizeScale) * juce::jlimit(0.0, 1.0, parameters.size);
+    const double decay_samples  = juce::jmax(0.01, parameters.decaySeconds) * sampleRate;
+    const double high_decay     = decay_samples / (1.0 + 19.0 * juce::jlimit(0.0, 1.0, parameters.damping));
+    const double depth          = juce::jlimit(0.0, MaxModulationDepthMs, parameters.modulationDepthMs)
+                                  * samples_per_ms;
+    double longest_line = 0.0;
+
+    for (int i = 0; i < NumLines; ++i)
+    {
+        const auto line = static_cast<std::size_t>(i);
+        const double line_samples = lineLengthsMs[line] * size_scale * samples_per_ms;
+
+        // A one-pole lowpass y = b * x + p * y, with its gain at DC and Nyquist chosen for the two decay times
+        const double low_gain  = getDecayGain(line_samples, decay_samples);
+        const double high_gain = getDecayGain(line_samples, high_decay);
+        const double ratio     = high_gain / low_gain;
+        const double pole      = (1.0 - ratio) / (1.0 + ratio);
+
+        targets[Delay][line] = static_cast<SampleType>(line_samples);
+        targets[Gain] [line] = static_cast<SampleType>(low_gain * (1.0 - pole));
+        targets[Pole] [line] = static_cast<SampleType>(pole);
+        longest_line         = juce::jmax(longest_line, line_samples);
+
+        // The rates don't ramp, the oscillators just keep turning from wherever they are at the new speed
+        const double rate  = parameters.modulationRate
+                             * (1.0 - modulationRateSpread / 2.0 + modulationRateSpread * i / (NumLines - 1));
+        const double angle = juce::MathConstants<double>::twoPi * rate / sampleRate;
+        lfoRotationCos[line] = static_cast<SampleType>(std::cos(angle));
+        lfoRotationSin[line] = static_cast<SampleType>(std::sin(angle));
+    }
+
+    targetDepth = static_cast<SampleType>(depth);
+
+    // Decaying by 120 dB takes twice as long as by 60, plus the time the last echo takes to come out of the lines
+    const double tail = decay_samples * 2.0 + longest_line + depth;
+    tailSamples = static_cast<int>(std::min(std::ceil(tail), static_cast<double>(std::numeric_limits<int>::max())));
+
+    if (rampSamples <= 0)
+    {
+        current       = targets;
+        currentDepth  = targetDepth;
+        rampRemaining = 0;
+        return;
+    }
+
+    const SampleType step = SampleType(1) / static_cast<SampleType>(rampSamples);
+
+    for (int ramped = 0; ramped < NumRamped; ++ramped)
+    {
+        for (int i = 0; i < NumLines; ++i)
+        {
+            increments[ramped][i] = (targets[ramped][i] - current[ramped][i]) * step;
+        }
+    }
+
+    depthIncrement = (targetDepth - currentDepth) * step;
+    rampRemaining  = rampSamples;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void FdnReverb<SampleType>::process(SampleType *const *channels, int numChannels, int numSamples) noexcept
+{
+    jassert(isPrepared());
+
+    const int num_channels = juce::jmin(numChannels, MaxChannels);
+    const int write_mask   = *std::max_element(lineMasks.begin(), lineMasks.end());
+
+    alignas(simd::Alignment) LineArray lines;
+    alignas(simd::Alignment) LineArray delays;
+    std::array<SampleType, MaxChannels> inputs;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        if (rampRemaining > 0)
+        {
+            advanceRamp();
+        }
+
+        // The oscillators are phasors, turned one step further by a complex multiplication
+        const Vec depth = Vec::broadcast(currentDepth);
+
+        for (int i = 0; i < NumLines; i += NumLanes)
+        {
+            const Vec cos = Vec::load(lfoCos.data() + i);
+            const Vec sin = Vec::load(lfoSin.data() + i);
+            const Vec rotation_cos = Vec::load(lfoRotationCos.data() + i);
+            const Vec rotation_sin = Vec::load(lfoRotationSin.data() + i);
+            const Vec next_sin     = cos * rotation_sin + sin * rotation_cos;
+
+            (cos * rotation_cos - sin * rotation_sin).store(lfoCos.data() + i);
+            next_sin.store(lfoSin.data() + i);
+            (Vec::load(current[Delay].data() + i) + depth * next_sin).store(delays.data() + i);
+        }
+
+        // The taps, through a first-order allpass for the fraction of a sample; unlike linear interpolation that
+        // doesn't lowpass the lines, which would make them decay faster than they should whenever they're modulated.
+        // The fraction is kept between 0.5 and 1.5, where the pole of the allpass stays well inside the unit circle.
+        for (int i = 0; i < NumLines; ++i)
+        {
+            const auto line          = static_cast<std::size_t>(i);
+            const SampleType *data   = arena.get() + lineOffsets[line];
+            const int mask           = lineMasks[line];
+            const int whole          = static_cast<int>(delays[line] - SampleType(0.5));
+            const SampleType frac    = delays[line] - static_cast<SampleType>(whole);
+            const SampleType allpass = (SampleType(1) - frac) / (SampleType(1) + frac);
+            const SampleType later   = data[(writePosition - whole)     & mask];
+            const SampleType earlier = data[(writePosition - whole - 1) & mask];
+            lines[line] = allpass * (later - allpassStates[line]) + earlier;
+            allpassStates[line] = lines[line];
+        }
+
+        // Damping and decay
+        for (int i = 0; i < NumLines; i += NumLanes)
+        {
+            const Vec state = Vec::load(current[Gain].data() + i) * Vec::load(lines.data() + i)
+                              + Vec::load(current[Pole].data() + i) * Vec::load(filterStates.data() + i);
+            state.store(filterStates.data() + i);
+            state.store(lines.data() + i);
+        }
+
+        // The block is processed in place, so all inputs of this sample are read before any output is written
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            inputs[static_cast<std::size_t>(ch)] = channels[ch][n];
+        }
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            const SampleType *taps = outputTaps[static_cast<std::size_t>(ch)].data();
+            Vec sum = Vec::zero();
+
+            for (int i = 0; i < NumLines; i += NumLanes)
+            {
+                sum = sum + Vec::load(lines.data() + i) * Vec::load(taps + i);
+            }
+
+            channels[ch][n] = simd::sum(sum);
+        }
+
+        mix(lines.data());
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            const SampleType *taps = inputTaps[static_cast<std::size_t>(ch)].data();
+            const Vec input        = Vec::broadcast(inputs[static_cast<std::size_t>(ch)]);
+
+            for (int i = 0; i < NumLines; i += NumLanes)
+            {
+                (Vec::load(lines.data() + i) + input * Vec::load(taps + i)).store(lines.data() + i);
+            }
+        }
+
+        for (int i = 0; i < NumLines; ++i)
+        {
+            const auto line = static_cast<std::size_t>(i);
+            arena[static_cast<std::size_t>(lineOffsets[line] + (writePosition & lineMasks[line]))] = lines[line];
+        }
+
+        // All line sizes are powers of two up to the largest one, so wrapping by it keeps every line's position
+        writePosition = (writePosition + 1) & write_mask;
+    }
+
+    // The phasors drift off the unit circle by a rounding error per sample, one Newton step per block pulls them back
+    for (int i = 0; i < NumLines; i += NumLanes)
+    {
+        const Vec cos = Vec::load(lfoCos.data() + i);
+        const Vec sin = Vec::load(lfoSin.data() + i);
+        const Vec scale = Vec::broadcast(SampleType(1.5))
+                          - Vec::broadcast(SampleType(0.5)) * (cos * cos + sin * sin);
+        (cos * scale).store(lfoCos.data() + i);
+        (sin * scale).store(lfoSin.data() + i);
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void FdnReverb<SampleType>::resetModulation() noexcept
+{
+    // Spread evenly around the circle, so that the lines never wander in step
+    for (int i = 0; i < NumLines; ++i)
+    {
+        const double phase = juce::MathConstants<double>::twoPi * i / NumLines;
+        lfoCos[static_cast<std::size_t>(i)] = static_cast<SampleType>(std::cos(phase));
+        lfoSin[static_cast<std::size_t>(i)] = static_cast<SampleType>(std::sin(phase));
+    }
+}
+
+template<class SampleType>
+void FdnReverb<SampleType>::advanceRamp() noexcept
+{
+    if (--rampRemaining == 0)
+    {
+        // Landing exactly on the targets, rather than wherever the rounding errors of the increments add up to
+        current      = targets;
+        currentDepth = targetDepth;
+        return;
+    }
+
+    for (int ramped = 0; ramped < NumRamped; ++ramped)
+    {
+        for (int i = 0; i < NumLines; i += NumLanes)
+        {
+            (Vec::load(current[ramped].data() + i) + Vec::load(increments[ramped].data() + i))
+                .store(current[ramped].data() + i);
+        }
+    }
+
+    currentDepth += depthIncrement;
+}
+
+template<class SampleType>
+void FdnReverb<SampleType>::mix(SampleType *lines) const noexcept
+{
+    constexpr int half = NumLines / 2;
+
+    // Hadamard butterfly between the two halves
+    const Vec norm = Vec::broadcast(static_cast<SampleType>(1.0 / juce::MathConstants<double>::sqrt2));
+
+    for (int i = 0; i < half; i += NumLanes)
+    {
+        const Vec first  = Vec::load(lines + i);
+        const Vec second = Vec::load(lines + half + i);
+        ((first + second) * norm).store(lines + i);
+        ((first - second) * norm).store(lines + half + i);
+    }
+
+    // Householder reflection within each half, x - 2 / n * sum(x)
+    for (int start = 0; start < NumLines; start += half)
+    {
+        Vec sum = Vec::zero();
+
+        for (int i = start; i < start + half; i += NumLanes)
+        {
+            sum = sum + Vec::load(lines + i);
+        }
+
+        const Vec reflection = Vec::broadcast(simd::sum(sum) * static_cast<SampleType>(2.0 / half));
+
+        for (int i = start; i < start + half; i += NumLanes)
+        {
+            (Vec::load(lines + i) - reflection).store(lines + i);
+        }
+    }
+}
+
+//======================================================================================================================
+template class FdnReverb<float>;
+template class FdnReverb<double>;
@@ -0,0 +1,168 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   FdnReverb.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include "SimdOps.h"
+
+#include <array>
+
+/** The settings of an FdnReverb, the same for both precisions. */
+struct FdnReverbParameters
+{
+    /** The size of the room from 0 to 1, which scales the lengths of the delay lines. */
+    double size { 0.5 };
+
+    /** The time in seconds low frequencies take to decay by 60 dB. */
+    double decaySeconds { 2.0 };
+
+    /** How much faster high frequencies decay, from 0 for just as fast as low frequencies to 1 for twenty times. */
+    double damping { 0.5 };
+
+    /** How far the delay taps wander in milliseconds, up to FdnReverb::MaxModulationDepthMs. */
+    double modulationDepthMs { 0.5 };
+
+    /** How fast the delay taps wander in Hz. */
+    double modulationRate { 0.5 };
+};
+
+/**
+ *  A feedback delay network reverb, eight delay lines fed back into each other through a unitary mixing matrix.
+ *
+ *  The lines are processed as structure of arrays, so that everything that happens to all lines at once, the damping
+ *  filters, the modulation and the mixing, runs on SIMD vectors of lines. Only the reads and writes of the delay
+ *  lines themselves are scalar, as every line sits at a different position of its buffer.
+ *
+ *  The feedback matrix is a Hadamard butterfly between the two halves of the lines followed by a Householder
+ *  reflection within each half. Both are unitary, so is their product, and every entry of it has the same magnitude;
+ *  every line feeds every other one equally, for the cost of a few vector adds and one horizontal sum per half.
+ *
+ *  Every line reads through a modulated, allpass interpolated tap and then through its own damping filter, a one-pole
+ *  lowpass that also applies the line's decay. Its gain at DC and Nyquist is set so that low and high frequencies
+ *  decay by 60 dB after their own decay time no matter the length of the line, which keeps the decay even across lines.
+ *
+ *  Channels are fed into and read from the lines with the rows of a Hadamard matrix as signs, a different row for each
+ *  of the first eight channels, which decorrelates their outputs from each other. The output is wet only.
+ *
+ *  All delay lines live in one arena allocated in prepare, after that processing and changing parameters is realtime
+ *  safe. Parameter changes are ramped to linearly, sample by sample.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class FdnReverb final
+{
+public:
+    using Vec = simd::Vec<SampleType>;
+
+    static constexpr int NumLines    = 8;
+    static constexpr int NumLanes    = Vec::Size;
+    static constexpr int MaxChannels = 16;
+
+    /** The longest modulation depth in milliseconds, the delay lines are allocated with room for it. */
+    static constexpr double MaxModulationDepthMs = 2.0;
+
+    using Parameters = FdnReverbParameters;
+
+
+    //==================================================================================================================
+    void prepare(double sampleRate);
+    void release();
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /**
+     *  Sets new parameters, changes to them are ramped to.
+     *
+     *  @param parameters  The new parameters
+     *  @param rampSamples The number of samples to get from the current parameters to the new ones, or 0 to jump
+     */
+    void setParameters(const Parameters &parameters, int rampSamples = 0) noexcept;
+    const Parameters& getParameters() const noexcept { return currentParameters; }
+
+    /** Gets for how many samples the reverb keeps sounding after its input went silent, until it decayed by 120 dB. */
+    int getTailSamples() const noexcept { return tailSamples; }
+
+    bool isPrepared() const noexcept { return arena.get() != nullptr; }
+
+    //==================================================================================================================
+    /**
+     *  Replaces a block by the reverb of it.
+     *
+     *  @param channels    The channels to process in place
+     *  @param numChannels The number of channels, channels from MaxChannels on are passed through untouched
+     *  @param numSamples  The number of samples per channel
+     */
+    void process(SampleType *const *channels, int numChannels, int numSamples) noexcept;
+
+private:
+    /** The values that are ramped to sample by sample, one of each per line. */
+    enum Ramped
+    {
+        Delay,
+        Gain,
+        Pole,
+        NumRamped
+    };
+
+    using LineArray = std::array<SampleType, NumLines>;
+
+    //==================================================================================================================
+    simd::AlignedBlock<SampleType> arena;
+    std::array<int, NumLines> lineOffsets {};
+    std::array<int, NumLines> lineMasks {};
+    int arenaSize     { 0 };
+    int writePosition { 0 };
+
+    alignas(simd::Alignment) std::array<LineArray, NumRamped> current {};
+    alignas(simd::Alignment) std::array<LineArray, NumRamped> increments {};
+    alignas(simd::Alignment) std::array<LineArray, NumRamped> targets {};
+    SampleType currentDepth   { 0 };
+    SampleType depthIncrement { 0 };
+    SampleType targetDepth    { 0 };
+    int rampRemaining { 0 };
+
+    alignas(simd::Alignment) LineArray filterStates {};
+    LineArray allpassStates {};
+    alignas(simd::Alignment) LineArray lfoCos {};
+    alignas(simd::Alignment) LineArray lfoSin {};
+    alignas(simd::Alignment) LineArray lfoRotationCos {};
+    alignas(simd::Alignment) LineArray lfoRotationSin {};
+
+    alignas(simd::Alignment) std::array<LineArray, MaxChannels> inputTaps {};
+    alignas(simd::Alignment) std::array<LineArray, MaxChannels> outputTaps {};
+
+    Parameters currentParameters;
+    double sampleRate { 44100.0 };
+    int tailSamples { 0 };
+
+    //==================================================================================================================
+    void resetModulation() noexcept;
+    void advanceRamp() noexcept;
+    void mix(SampleType *lines) const noexcept;
+};
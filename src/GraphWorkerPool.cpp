@@ -0,0 +1,405 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   GraphWorkerPool.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "GraphWorkerPool.h"
+
+#include "SimdOps.h"
+
+#include <thread>
+
+namespace
+{
+void pauseSpin() noexcept
+{
+#if COSSIN_SIMD_SSE
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+}
+
+//======================================================================================================================
+bool GraphSchedule::build(int numNodes, const std::vector<std::pair<int, int>> &edges)
+{
+    const auto num_nodes = static_cast<std::size_t>(numNodes);
+    std::vector<int> predecessor_counts(num_nodes, 0);
+    std::vector<int> successor_start(num_nodes + 1, 0);
+
+    for (const auto &[from, to] : edges)
+    {
+        if (!juce::isPositiveAndBelow(from, numNodes) || !juce::isPositiveAndBelow(to, numNodes) || from == to)
+        {
+            return false;
+        }
+
+        ++predecessor_counts[static_cast<std::size_t>(to)];
+        ++successor_start[static_cast<std::size_t>(from) + 1];
+    }
+
+    for (std::size_t i = 0; i < num_nodes; ++i)
+    {
+        successor_start[i + 1] += successor_start[i];
+    }
+
+    std::vector<int> successor_list(edges.size());
+    std::vector<int> fill_position(successor_start.begin(), successor_start.end() - 1);
+
+    for (const auto &[from, to] : edges)
+    {
+        successor_list[static_cast<std::size_t>(fill_position[static_cast<std::size_t>(from)]++)] = to;
+    }
+
+    // Kahn's algorithm, if anything is left with pending predecessors at the end it sits on a cycle
+    std::vector<int> sorted;
+    std::vector<int> root_nodes;
+    std::vector<int> pending = predecessor_counts;
+    sorted.reserve(num_nodes);
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        if (pending[static_cast<std::size_t>(i)] == 0)
+        {
+            sorted.emplace_back(i);
+            root_nodes.emplace_back(i);
+        }
+    }
+
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        const auto node = static_cast<std::size_t>(sorted[i]);
+
+        for (int s = successor_start[node]; s < successor_start[node + 1]; ++s)
+        {
+            const int successor = successor_list[static_cast<std::size_t>(s)];
+
+            if (--pending[static_cast<std::size_t>(successor)] == 0)
+            {
+                sorted.emplace_back(successor);
+            }
+        }
+    }
+
+    if (sorted.size() != num_nodes)
+    {
+        return false;
+    }
+
+    order           = std::move(sorted);
+    roots           = std::move(root_nodes);
+    numPredecessors = std::move(predecessor_counts);
+    successorStart  = std::move(successor_start);
+    successors      = std::move(successor_list);
+    return true;
+}
+
+//======================================================================================================================
+class GraphWorkerPool::Worker final : public juce::Thread
+{
+public:
+    Worker(GraphWorkerPool &parentPool, int index)
+        : juce::Thread("Graph Worker " + juce::String(index)),
+          pool(parentPool),
+          threadIndex(index)
+    {}
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wakeUp.signal();
+        stopThread(1000);
+    }
+
+    //==================================================================================================================
+    void wake() noexcept { wakeUp.signal(); }
+
+private:
+    GraphWorkerPool &pool;
+    juce::WaitableEvent wakeUp;
+    int threadIndex;
+
+    //==================================================================================================================
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wakeUp.wait(-1);
+
+            if (threadShouldExit())
+            {
+                return;
+            }
+
+            // A wake-up left over from a block this worker already helped with finds nothing to do here
+            pool.runUntilDone(threadIndex);
+        }
+    }
+};
+
+//======================================================================================================================
+void GraphWorkerPool::WorkDeque::allocate(int capacity)
+{
+    const int size = juce::nextPowerOfTwo(juce::jmax(1, capacity));
+    items = std::make_unique<std::atomic<int>[]>(static_cast<std::size_t>(size));
+    mask  = size - 1;
+    top   .store(0, std::memory_order_relaxed);
+    bottom.store(0, std::memory_order_relaxed);
+}
+
+void GraphWorkerPool::WorkDeque::push(int node) noexcept
+{
+    const std::int64_t b = bottom.load(std::memory_order_relaxed);
+    jassert(b - top.load(std::memory_order_acquire) <= mask);
+
+    items[static_cast<std::size_t>(b & mask)].store(node, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+bool GraphWorkerPool::WorkDeque::pop(int &node) noexcept
+{
+    const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    node = items[static_cast<std::size_t>(b & mask)].load(std::memory_order_relaxed);
+
+    if (t < b)
+    {
+        return true;
+    }
+
+    // The last item, a thief might be after it as well
+    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+bool GraphWorkerPool::WorkDeque::steal(int &node) noexcept
+{
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+    {
+        return false;
+    }
+
+    node = items[static_cast<std::size_t>(t & mask)].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+//======================================================================================================================
+int GraphWorkerPool::getDefaultNumWorkers() noexcept
+{
+    return juce::jlimit(0, MaxWorkers, juce::SystemStats::getNumPhysicalCpus() - 1);
+}
+
+//======================================================================================================================
+GraphWorkerPool::GraphWorkerPool() = default;
+
+GraphWorkerPool::~GraphWorkerPool()
+{
+    release();
+}
+
+//======================================================================================================================
+void GraphWorkerPool::prepare(const GraphSchedule &newSchedule, int numWorkers)
+{
+    release();
+
+    schedule = newSchedule;
+
+    // Deques for as many threads as there may ever be, so that workers can come and go without allocating them
+    const int num_nodes   = schedule.getNumNodes();
+    const int max_threads = MaxWorkers + 1;
+    pendingPredecessors   = std::make_unique<std::atomic<int>[]>(static_cast<std::size_t>(num_nodes));
+    deques                = std::make_unique<WorkDeque[]>(static_cast<std::size_t>(max_threads));
+
+    // Every node is pushed once per block and all deques are empty at the end of it, so no deque can overflow
+    for (int i = 0; i < max_threads; ++i)
+    {
+        deques[static_cast<std::size_t>(i)].allocate(num_nodes);
+    }
+
+    remainingNodes.store(0, std::memory_order_relaxed);
+    setNumWorkers(numWorkers);
+}
+
+void GraphWorkerPool::release()
+{
+    setNumWorkers(0);
+}
+
+void GraphWorkerPool::setNumWorkers(int numWorkers)
+{
+    numWorkers = juce::jlimit(0, MaxWorkers, numWorkers);
+
+    // With a single chain there's nothing to run in parallel, the workers would only ever spin
+    if (schedule.getNumNodes() < 2)
+    {
+        numWorkers = 0;
+    }
+
+    if (numWorkers == static_cast<int>(workers.size()))
+    {
+        return;
+    }
+
+    // Blocks starting from here on run without workers, one that already started with them is waited for
+    activeWorkers.store(0, std::memory_order_seq_cst);
+
+    while (isRunningWorkers.load(std::memory_order_seq_cst))
+    {
+        std::this_thread::yield();
+    }
+
+    // Worker destructors stop their threads
+    workers.clear();
+
+    for (int i = 1; i <= numWorkers; ++i)
+    {
+        workers.emplace_back(std::make_unique<Worker>(*this, i));
+        workers.back()->startThread(RealtimePriority);
+    }
+
+    activeWorkers.store(numWorkers, std::memory_order_seq_cst);
+}
+
+//======================================================================================================================
+void GraphWorkerPool::run(NodeRunner &runner) noexcept
+{
+    const int num_nodes = schedule.getNumNodes();
+
+    // Flagged before looking at the workers, so that whoever stops them either sees the flag or this sees none
+    isRunningWorkers.store(true, std::memory_order_seq_cst);
+    const int num_workers = activeWorkers.load(std::memory_order_seq_cst);
+
+    if (num_workers == 0)
+    {
+        isRunningWorkers.store(false, std::memory_order_release);
+
+        for (const int node : schedule.order)
+        {
+            runner.runNode(node);
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < num_nodes; ++i)
+    {
+        pendingPredecessors[static_cast<std::size_t>(i)].store(schedule.numPredecessors[static_cast<std::size_t>(i)],
+                                                               std::memory_order_relaxed);
+    }
+
+    // A worker still on its way out of the last block may already steal from this one, so everything it could
+    // touch has to be set before the first node is up for grabs
+    activeRunner.store(&runner, std::memory_order_relaxed);
+    numThreads.store(num_workers + 1, std::memory_order_relaxed);
+    remainingNodes.store(num_nodes, std::memory_order_release);
+
+    WorkDeque &own_deque = deques[0];
+
+    for (const int node : schedule.roots)
+    {
+        own_deque.push(node);
+    }
+
+    for (int i = 0; i < num_workers; ++i)
+    {
+        workers[static_cast<std::size_t>(i)]->wake();
+    }
+
+    runUntilDone(0);
+    isRunningWorkers.store(false, std::memory_order_release);
+}
+
+//======================================================================================================================
+void GraphWorkerPool::runUntilDone(int threadIndex) noexcept
+{
+    while (remainingNodes.load(std::memory_order_acquire) > 0)
+    {
+        int node = 0;
+
+        if (findWork(threadIndex, node))
+        {
+            activeRunner.load(std::memory_order_relaxed)->runNode(node);
+            completeNode(threadIndex, node);
+        }
+        else
+        {
+            // Everything ready is taken, but whatever is running may still free up successors
+            pauseSpin();
+        }
+    }
+}
+
+bool GraphWorkerPool::findWork(int threadIndex, int &node) noexcept
+{
+    if (deques[static_cast<std::size_t>(threadIndex)].pop(node))
+    {
+        return true;
+    }
+
+    const int num_threads = numThreads.load(std::memory_order_relaxed);
+
+    for (int i = 1; i < num_threads; ++i)
+    {
+        if (deques[static_cast<std::size_t>((threadIndex + i) % num_threads)].steal(node))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void GraphWorkerPool::completeNode(int threadIndex, int node) noexcept
+{
+    const auto index = static_cast<std::size_t>(node);
+    WorkDeque &own_deque = deques[static_cast<std::size_t>(threadIndex)];
+
+    for (int s = schedule.successorStart[index]; s < schedule.successorStart[index + 1]; ++s)
+    {
+        const int successor = schedule.successors[static_cast<std::size_t>(s)];
+
+        // Whoever finishes the last predecessor gets to run the successor, it sees all their output through this
+        if (pendingPredecessors[static_cast<std::size_t>(successor)].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            own_deque.push(successor);
+        }
+    }
+
+    remainingNodes.fetch_sub(1, std::memory_order_acq_rel);
+}
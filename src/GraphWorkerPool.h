@@ -0,0 +1,173 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   GraphWorkerPool.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ *  The order and dependencies of the nodes of a directed acyclic graph, as the worker pool needs them.
+ *  Building one allocates and is meant for the message thread.
+ */
+struct GraphSchedule
+{
+    /** All nodes, every node after all of its predecessors. */
+    std::vector<int> order;
+
+    /** The nodes without predecessors, they are ready as soon as a block starts. */
+    std::vector<int> roots;
+
+    /** The number of predecessors of each node. */
+    std::vector<int> numPredecessors;
+
+    /** The successors of node i are successors[successorStart[i]] up to successors[successorStart[i + 1]]. */
+    std::vector<int> successorStart;
+    std::vector<int> successors;
+
+    //==================================================================================================================
+    /**
+     *  Sorts a graph topologically.
+     *
+     *  @param numNodes The number of nodes
+     *  @param edges    The edges as pairs of node indices, from the first to the second
+     *  @return True if the graph was valid and acyclic, false if not in which case the schedule is left as it was
+     */
+    bool build(int numNodes, const std::vector<std::pair<int, int>> &edges);
+
+    int getNumNodes() const noexcept { return static_cast<int>(order.size()); }
+};
+
+//======================================================================================================================
+/**
+ *  Runs the nodes of a graph in dependency order on a few realtime priority threads, the audio thread included.
+ *
+ *  Every thread has a bounded work-stealing deque (Chase-Lev) of ready nodes. Finishing a node counts down the
+ *  pending predecessors of each of its successors; whoever finishes the last predecessor pushes the successor onto
+ *  its own deque, and threads that run dry steal from the others. None of this takes a lock or allocates.
+ *  The only blocking primitive are the events the workers sleep on between blocks, the audio thread signals them
+ *  once per block but never waits on them.
+ *
+ *  The audio thread takes part in every block and returns only once all nodes are done, so with no workers at all
+ *  the pool degrades into running the nodes one after the other in topological order on the audio thread; this is
+ *  the deterministic fallback for hosts that don't want plugins to spawn threads.
+ *
+ *  The workers can be started and stopped while the pool is running blocks on another thread. Each block runs with
+ *  the workers there were when it started; stopping them only waits for a block that uses them to finish, the audio
+ *  thread never waits for anything.
+ */
+class GraphWorkerPool final
+{
+public:
+    /** Runs a single node, which may happen on any of the pool's threads. */
+    struct NodeRunner
+    {
+        virtual ~NodeRunner() = default;
+        virtual void runNode(int node) noexcept = 0;
+    };
+
+    //==================================================================================================================
+    static constexpr int MaxWorkers = 7;
+
+    /** The highest thread priority, which JUCE maps to a time-constraint thread on macOS. */
+    static constexpr int RealtimePriority = 10;
+
+    /** A worker for every physical core but the one the audio thread is on, within MaxWorkers. */
+    static int getDefaultNumWorkers() noexcept;
+
+    //==================================================================================================================
+    GraphWorkerPool();
+    ~GraphWorkerPool();
+
+    //==================================================================================================================
+    /**
+     *  Takes a schedule over and starts the workers, this allocates and must not be called while running.
+     *
+     *  @param schedule   The schedule to run
+     *  @param numWorkers The number of threads to start besides the audio thread, 0 to run everything on the latter
+     */
+    void prepare(const GraphSchedule &schedule, int numWorkers);
+
+    /** Stops the workers. */
+    void release();
+
+    /**
+     *  Starts or stops workers so that there are as many as given, which may be done while running; call this from
+     *  the thread that prepares the pool, it blocks until a block using the workers that are stopped is done.
+     *
+     *  @param numWorkers The number of threads to run besides the audio thread, 0 to run everything on the latter
+     */
+    void setNumWorkers(int numWorkers);
+
+    //==================================================================================================================
+    /** Runs all nodes once, returning when the last one finished, realtime safe. */
+    void run(NodeRunner &runner) noexcept;
+
+    int getNumWorkers() const noexcept { return activeWorkers.load(std::memory_order_relaxed); }
+
+private:
+    class Worker;
+
+    /** A fixed-capacity Chase-Lev deque, the owner pushes and pops at the bottom and thieves steal from the top. */
+    class alignas(64) WorkDeque
+    {
+    public:
+        void allocate(int capacity);
+
+        void push(int node) noexcept;
+        bool pop(int &node) noexcept;
+        bool steal(int &node) noexcept;
+
+    private:
+        std::unique_ptr<std::atomic<int>[]> items;
+        std::int64_t mask { 0 };
+        std::atomic<std::int64_t> top    { 0 };
+        std::atomic<std::int64_t> bottom { 0 };
+    };
+
+    //==================================================================================================================
+    GraphSchedule schedule;
+    std::unique_ptr<std::atomic<int>[]> pendingPredecessors;
+    std::unique_ptr<WorkDeque[]> deques;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::atomic<NodeRunner*> activeRunner { nullptr };
+    alignas(64) std::atomic<int> remainingNodes { 0 };
+
+    // How many of the workers blocks may use, whether the block at hand uses them and how many threads it runs on
+    std::atomic<int> activeWorkers { 0 };
+    std::atomic<bool> isRunningWorkers { false };
+    std::atomic<int> numThreads { 1 };
+
+    //==================================================================================================================
+    void runUntilDone(int threadIndex) noexcept;
+    bool findWork(int threadIndex, int &node) noexcept;
+    void completeNode(int threadIndex, int node) noexcept;
+};
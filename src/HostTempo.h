@@ -0,0 +1,61 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   HostTempo.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <atomic>
+
+/**
+ *  Hands the tempo of the host's play head to the modules that sync to it.
+ *
+ *  The processor sets it at the start of every block from the play head. Whenever the host doesn't know a tempo, the
+ *  last one it reported stays, or 120 bpm if it never reported one. There is one per processor, shared by both
+ *  precisions; reading it is safe from any thread.
+ */
+class HostTempo final
+{
+public:
+    static constexpr double DefaultBpm = 120.0;
+
+    //==================================================================================================================
+    /** Takes the tempo over from a play head, if it has one; audio thread only. */
+    void update(juce::AudioPlayHead *playHead) noexcept
+    {
+        juce::AudioPlayHead::CurrentPositionInfo position;
+
+        if (playHead != nullptr && playHead->getCurrentPosition(position) && position.bpm > 0.0)
+        {
+            bpm.store(position.bpm, std::memory_order_relaxed);
+        }
+    }
+
+    double getBpm() const noexcept { return bpm.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> bpm { DefaultBpm };
+};
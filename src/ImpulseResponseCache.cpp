@@ -0,0 +1,358 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ImpulseResponseCache.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "ImpulseResponseCache.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/** The number of zero crossings of the resampling kernel on either side of its centre, at the input rate. */
+constexpr int resamplerZeroCrossings = 32;
+
+/** The number of kernel values per zero crossing in the lookup table, the kernel is interpolated in between. */
+constexpr int resamplerTableResolution = 512;
+
+/** How far below the lower of the two Nyquist frequencies the kernel cuts off. */
+constexpr double resamplerCutoff = 0.95;
+
+//======================================================================================================================
+/** Resamples every channel of a buffer by a ratio of output to input rate with a Blackman-windowed sinc. */
+juce::AudioBuffer<float> resample(const juce::AudioBuffer<float> &input, double ratio)
+{
+    const int num_inputs  = input.getNumSamples();
+    const int num_outputs = static_cast<int>(std::ceil(num_inputs * ratio));
+
+    // Downsampling has to cut off below the output's Nyquist, which widens the kernel by as much in input samples
+    const double cutoff     = resamplerCutoff * std::min(1.0, ratio);
+    const double half_width = resamplerZeroCrossings / cutoff;
+    const int table_size    = static_cast<int>(std::ceil(half_width * resamplerTableResolution)) + 2;
+
+    std::vector<float> table(static_cast<std::size_t>(table_size));
+
+    for (int i = 0; i < table_size; ++i)
+    {
+        const double distance = static_cast<double>(i) / resamplerTableResolution;
+        const double position = juce::jmin(1.0, distance / half_width);
+        const double window   = 0.42 + 0.5 * std::cos(juce::MathConstants<double>::pi * position)
+                                + 0.08 * std::cos(juce::MathConstants<double>::twoPi * position);
+        const double argument = juce::MathConstants<double>::pi * cutoff * distance;
+        const double sinc     = distance == 0.0 ? 1.0 : std::sin(argument) / argument;
+        table[static_cast<std::size_t>(i)] = static_cast<float>(cutoff * sinc * window);
+    }
+
+    juce::AudioBuffer<float> output(input.getNumChannels(), num_outputs);
+    const int reach = static_cast<int>(std::ceil(half_width));
+
+    for (int ch = 0; ch < input.getNumChannels(); ++ch)
+    {
+        const float *const source = input.getReadPointer(ch);
+        float *const destination  = output.getWritePointer(ch);
+
+        for (int i = 0; i < num_outputs; ++i)
+        {
+            const double centre = i / ratio;
+            const int first     = juce::jmax(0, static_cast<int>(std::floor(centre)) - reach + 1);
+            const int last      = juce::jmin(num_inputs - 1, static_cast<int>(std::floor(centre)) + reach);
+            double sum = 0.0;
+
+            for (int k = first; k <= last; ++k)
+            {
+                const double index = std::abs(centre - k) * resamplerTableResolution;
+                const auto   whole = static_cast<std::size_t>(index);
+                const double frac  = index - static_cast<double>(whole);
+
+                if (whole + 1 < table.size())
+                {
+                    sum += source[k] * (table[whole] + frac * (table[whole + 1] - table[whole]));
+                }
+            }
+
+            destination[i] = static_cast<float>(sum);
+        }
+    }
+
+    return output;
+}
+
+/** Cuts off the end of a response once every channel decayed below the trim threshold, and normalises it. */
+void trimAndNormalise(juce::AudioBuffer<float> &impulse)
+{
+    const int num_channels = impulse.getNumChannels();
+    const float threshold  = impulse.getMagnitude(0, impulse.getNumSamples())
+                             * juce::Decibels::decibelsToGain(ImpulseResponseCache::TrimThresholdDb);
+    int length = 0;
+
+    for (int ch = 0; ch < num_channels; ++ch)
+    {
+        const float *const data = impulse.getReadPointer(ch);
+
+        for (int i = impulse.getNumSamples(); i > length; --i)
+        {
+            if (std::abs(data[i - 1]) > threshold)
+            {
+                length = i;
+                break;
+            }
+        }
+    }
+
+    impulse.setSize(num_channels, juce::jmax(1, length), true);
+
+    double energy = 0.0;
+
+    for (int ch = 0; ch < num_channels; ++ch)
+    {
+        const float *const data = impulse.getReadPointer(ch);
+
+        for (int i = 0; i < impulse.getNumSamples(); ++i)
+        {
+            energy += static_cast<double>(data[i]) * data[i];
+        }
+    }
+
+    if (energy > 0.0)
+    {
+        impulse.applyGain(static_cast<float>(1.0 / std::sqrt(energy / num_channels)));
+    }
+}
+}
+
+//======================================================================================================================
+std::unique_ptr<PartitionedImpulse> PartitionedImpulse::build(const juce::AudioBuffer<float> &impulse,
+                                                              double sampleRate)
+{
+    auto result = std::make_unique<PartitionedImpulse>();
+    result->numChannels = juce::jlimit(1, MaxChannels, impulse.getNumChannels());
+    result->length      = impulse.getNumSamples();
+    result->sampleRate  = sampleRate;
+    result->head.assign(static_cast<std::size_t>(result->numChannels * HeadSize), 0.0f);
+
+    const int num_channels = juce::jmin(result->numChannels, impulse.getNumChannels());
+
+    for (int ch = 0; ch < num_channels; ++ch)
+    {
+        const float *const data = impulse.getReadPointer(ch);
+        float *const head       = result->head.data() + ch * HeadSize;
+
+        for (int i = 0; i < juce::jmin(HeadSize, result->length); ++i)
+        {
+            head[HeadSize - 1 - i] = data[i];
+        }
+    }
+
+    for (int s = 0; s < NumStages; ++s)
+    {
+        Stage &stage = result->stages[static_cast<std::size_t>(s)];
+        stage.blockOrder = HeadOrder + s * StageGrowthOrder;
+        stage.blockSize  = 1 << stage.blockOrder;
+        stage.offset     = s == 0 ? stage.blockSize : stage.blockSize * 2;
+        stage.numBins    = stage.blockSize + 1;
+
+        const int end     = s + 1 < NumStages ? (stage.blockSize << StageGrowthOrder) * 2 : result->length;
+        const int covered = juce::jmax(0, juce::jmin(end, result->length) - stage.offset);
+        stage.numPartitions = (covered + stage.blockSize - 1) / stage.blockSize;
+
+        if (stage.numPartitions == 0)
+        {
+            continue;
+        }
+
+        const auto num_bins = static_cast<std::size_t>(result->numChannels * stage.numPartitions * stage.numBins);
+        stage.real.assign(num_bins, 0.0f);
+        stage.imag.assign(num_bins, 0.0f);
+
+        juce::dsp::FFT fft(stage.blockOrder + 1);
+        std::vector<float> scratch(static_cast<std::size_t>(stage.blockSize) * 4);
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            const float *const data = impulse.getReadPointer(ch);
+
+            for (int partition = 0; partition < stage.numPartitions; ++partition)
+            {
+                const int start = stage.offset + partition * stage.blockSize;
+                const int count = juce::jmin(stage.blockSize, result->length - start);
+
+                std::fill(scratch.begin(), scratch.end(), 0.0f);
+                std::copy(data + start, data + start + count, scratch.begin());
+                fft.performRealOnlyForwardTransform(scratch.data(), true);
+
+                const int offset = (ch * stage.numPartitions + partition) * stage.numBins;
+
+                for (int bin = 0; bin < stage.numBins; ++bin)
+                {
+                    stage.real[static_cast<std::size_t>(offset + bin)] = scratch[static_cast<std::size_t>(bin) * 2];
+                    stage.imag[static_cast<std::size_t>(offset + bin)] = scratch[static_cast<std::size_t>(bin) * 2 + 1];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+//======================================================================================================================
+juce::Result ImpulseResponseCache::load(const juce::File &file, double sampleRate,
+                                        std::shared_ptr<const PartitionedImpulse> &impulse)
+{
+    // The modification time is part of the key, a file that was overwritten is a different response
+    const juce::String key = file.getFullPathName() + "|"
+                             + juce::String(file.getLastModificationTime().toMilliseconds()) + "|"
+                             + juce::String(sampleRate);
+
+    {
+        const juce::ScopedLock lock(cacheLock);
+
+        if (const auto it = impulses.find(key); it != impulses.end())
+        {
+            if (std::shared_ptr<const PartitionedImpulse> cached = it->second.lock())
+            {
+                impulse = std::move(cached);
+                return juce::Result::ok();
+            }
+        }
+    }
+
+    // Loading happens outside the lock, so that instances loading different responses don't wait for each other
+    juce::AudioBuffer<float> buffer;
+    double file_sample_rate = 0.0;
+
+    if (const juce::Result result = readFile(file, buffer, file_sample_rate); result.failed())
+    {
+        return result;
+    }
+
+    if (sampleRate > 0.0 && std::abs(file_sample_rate - sampleRate) > 1.0e-6)
+    {
+        buffer = resample(buffer, sampleRate / file_sample_rate);
+    }
+
+    trimAndNormalise(buffer);
+    std::shared_ptr<const PartitionedImpulse> loaded = PartitionedImpulse::build(buffer, sampleRate);
+
+    const juce::ScopedLock lock(cacheLock);
+
+    // Whoever loaded the same response in the meantime wins, so that there's only ever one copy of it
+    std::weak_ptr<const PartitionedImpulse> &entry = impulses[key];
+
+    if (std::shared_ptr<const PartitionedImpulse> cached = entry.lock())
+    {
+        impulse = std::move(cached);
+    }
+    else
+    {
+        entry   = loaded;
+        impulse = std::move(loaded);
+    }
+
+    // Responses nobody uses anymore are gone already, this only drops their entries
+    for (auto it = impulses.begin(); it != impulses.end();)
+    {
+        it = it->second.expired() ? impulses.erase(it) : std::next(it);
+    }
+
+    return juce::Result::ok();
+}
+
+int ImpulseResponseCache::getNumCached() const
+{
+    const juce::ScopedLock lock(cacheLock);
+    return static_cast<int>(std::count_if(impulses.begin(), impulses.end(),
+                                          [](const auto &entry) { return !entry.second.expired(); }));
+}
+
+//======================================================================================================================
+juce::Result ImpulseResponseCache::readFile(const juce::File &file, juce::AudioBuffer<float> &buffer,
+                                            double &fileSampleRate)
+{
+    if (!file.existsAsFile())
+    {
+        return juce::Result::fail("Impulse response not found: " + file.getFullPathName());
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::WavAudioFormat  wav_format;
+    juce::AiffAudioFormat aiff_format;
+    juce::AudioFormat *const mappable_formats[] { &wav_format, &aiff_format };
+
+    // Mapped, the samples are converted straight from the page cache instead of being read through a stream first
+    for (juce::AudioFormat *format : mappable_formats)
+    {
+        if (format->canHandleFile(file))
+        {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+            if (mapped != nullptr && mapped->mapEntireFile())
+            {
+                reader = std::move(mapped);
+            }
+
+            break;
+        }
+    }
+
+    if (reader == nullptr)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        reader.reset(formats.createReaderFor(file));
+    }
+
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->numChannels <= 0 || reader->sampleRate <= 0.0)
+    {
+        return juce::Result::fail("Unsupported or empty impulse response: " + file.getFullPathName());
+    }
+
+    const auto max_length  = static_cast<juce::int64>(MaxLengthSeconds * reader->sampleRate);
+    const int num_samples  = static_cast<int>(juce::jmin(reader->lengthInSamples, max_length));
+    const int num_channels = juce::jmin(static_cast<int>(reader->numChannels), PartitionedImpulse::MaxChannels);
+
+    buffer.setSize(num_channels, num_samples);
+    fileSampleRate = reader->sampleRate;
+
+    // Fixed point formats come out as integers in the float buffer, converted in place like AudioFormatReader does
+    if (!reader->read(reinterpret_cast<int* const*>(buffer.getArrayOfWritePointers()), num_channels, 0, num_samples,
+                      false))
+    {
+        return juce::Result::fail("Couldn't read impulse response: " + file.getFullPathName());
+    }
+
+    if (!reader->usesFloatingPointData)
+    {
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            float *const data = buffer.getWritePointer(ch);
+            juce::FloatVectorOperations::convertFixedToFloat(data, reinterpret_cast<const int*>(data),
+                                                             1.0f / static_cast<float>(0x7fffffff), num_samples);
+        }
+    }
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,128 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ImpulseResponseCache.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ *  An impulse response cut into the partitions of ConvolutionEngine's non-uniform scheme, immutable once built so that
+ *  any number of engines can share it.
+ *
+ *  The first HeadSize samples are the head, kept in the time domain and reversed for direct convolution. The rest is
+ *  spread over NumStages stages of uniform partitions, each stage's partitions StageGrowthOrder powers of two larger
+ *  than the previous one's. A stage with partitions of B samples starts 2B into the response, B for the first one;
+ *  that's the earliest its result is due, counted from when the block it needs is complete, plus one more block for
+ *  the stages a worker computes. Stage s ends where stage s + 1 starts and the last one runs to the end.
+ *
+ *  Partitions are stored as spectra of twice their size, as separate real and imaginary parts; partition p of channel
+ *  c of a stage starts at bin (c * numPartitions + p) * numBins.
+ */
+struct PartitionedImpulse
+{
+    static constexpr int HeadOrder        = 7;
+    static constexpr int HeadSize         = 1 << HeadOrder;
+    static constexpr int StageGrowthOrder = 3;
+    static constexpr int NumStages        = 3;
+    static constexpr int MaxChannels      = 8;
+
+    struct Stage
+    {
+        int blockOrder    { 0 };
+        int blockSize     { 0 };
+        int offset        { 0 };
+        int numPartitions { 0 };
+        int numBins       { 0 };
+        std::vector<float> real;
+        std::vector<float> imag;
+    };
+
+    //==================================================================================================================
+    int numChannels { 0 };
+    int length      { 0 };
+    double sampleRate { 0.0 };
+    std::vector<float> head;
+    std::array<Stage, NumStages> stages;
+
+    //==================================================================================================================
+    /**
+     *  Partitions an impulse response, this allocates and transforms and is meant for a background thread.
+     *
+     *  @param impulse    The response, at most MaxChannels channels which engines cycle through for their channels
+     *  @param sampleRate The sample rate the response is at
+     *  @return The partitioned response
+     */
+    static std::unique_ptr<PartitionedImpulse> build(const juce::AudioBuffer<float> &impulse, double sampleRate);
+
+    /** Gets the reversed head of a channel of the response. */
+    const float* getHead(int channel) const noexcept { return head.data() + channel * HeadSize; }
+};
+
+/**
+ *  Loads impulse response files and keeps them partitioned for as long as anyone uses them, one copy per file and
+ *  sample rate for the whole process; share one cache through a juce::SharedResourcePointer.
+ *
+ *  WAV and AIFF files are memory-mapped and converted straight out of the mapping, other formats go through a regular
+ *  reader. Responses are resampled to the rate asked for with a windowed sinc, trimmed of their silent end and
+ *  normalised to unit energy per channel, so that responses of different loudness come out at about the same level.
+ *  Loading blocks for as long as that takes and must never happen on the audio thread.
+ */
+class ImpulseResponseCache final
+{
+public:
+    /** Responses are cut off after this many seconds. */
+    static constexpr double MaxLengthSeconds = 20.0;
+
+    /** Where a response has decayed to for good, relative to its peak. */
+    static constexpr float TrimThresholdDb = -120.0f;
+
+    //==================================================================================================================
+    /**
+     *  Gets a response at a sample rate, from the cache if it's already there or else from its file.
+     *  A file that changed on disk since it was cached is loaded again.
+     *
+     *  @param file       The file to load
+     *  @param sampleRate The sample rate to resample the response to
+     *  @param impulse    Receives the response if it could be loaded
+     *  @return Whether the response could be loaded, with the reason if not
+     */
+    juce::Result load(const juce::File &file, double sampleRate, std::shared_ptr<const PartitionedImpulse> &impulse);
+
+    /** Gets the number of responses that are cached and still in use. */
+    int getNumCached() const;
+
+private:
+    juce::CriticalSection cacheLock;
+    std::map<juce::String, std::weak_ptr<const PartitionedImpulse>> impulses;
+
+    //==================================================================================================================
+    static juce::Result readFile(const juce::File&, juce::AudioBuffer<float>&, double&);
+};
@@ -0,0 +1,352 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LinearPhaseConvolver.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "LinearPhaseConvolver.h"
+
+#include <algorithm>
+#include <complex>
+
+//======================================================================================================================
+LinearPhaseConvolver::LinearPhaseConvolver()
+    : juce::Thread("Linear Phase Kernel Builder")
+{}
+
+LinearPhaseConvolver::~LinearPhaseConvolver()
+{
+    stopThread(1000);
+}
+
+//======================================================================================================================
+void LinearPhaseConvolver::prepare(int newNumChannels, int kernelOrder, int partitionOrder)
+{
+    // The builder works with the sizes as well, it has to sit this out
+    const bool was_active = isThreadRunning();
+    stopThread(1000);
+
+    kernelOrder    = juce::jlimit(LinearPhaseKernel::MinKernelOrder, LinearPhaseKernel::MaxKernelOrder, kernelOrder);
+    partitionOrder = juce::jlimit(LinearPhaseKernel::MinPartitionOrder,
+                                  juce::jmin(LinearPhaseKernel::MaxPartitionOrder, kernelOrder), partitionOrder);
+
+    kernelSize    = 1 << kernelOrder;
+    partitionSize = 1 << partitionOrder;
+    numPartitions = kernelSize / partitionSize;
+    numBins       = partitionSize + 1;
+    numChannels   = juce::jlimit(1, MaxChannels, newNumChannels);
+
+    const auto channel_bins = static_cast<std::size_t>(numChannels * numPartitions * numBins);
+    const auto fft_floats   = static_cast<std::size_t>(partitionSize * 4);
+
+    fft          = std::make_unique<juce::dsp::FFT>(partitionOrder + 1);
+    partitionFft = std::make_unique<juce::dsp::FFT>(partitionOrder + 1);
+    designFft    = std::make_unique<juce::dsp::FFT>(kernelOrder);
+
+    inputs .assign(static_cast<std::size_t>(numChannels * partitionSize * 2), 0.0f);
+    outputs.assign(static_cast<std::size_t>(numChannels * partitionSize), 0.0f);
+    delayReal.allocate(channel_bins);
+    delayImag.allocate(channel_bins);
+    sumReal.allocate(static_cast<std::size_t>(numBins));
+    sumImag.allocate(static_cast<std::size_t>(numBins));
+    fftData      .assign(fft_floats, 0.0f);
+    partitionData.assign(fft_floats, 0.0f);
+    fadeOutput   .assign(static_cast<std::size_t>(partitionSize), 0.0f);
+    designData   .assign(static_cast<std::size_t>(kernelSize) * 2, 0.0f);
+    window       .resize(static_cast<std::size_t>(kernelSize));
+
+    // A Blackman window, periodic so that it peaks right at the centre of the kernel
+    for (int i = 0; i < kernelSize; ++i)
+    {
+        const double phase = juce::MathConstants<double>::twoPi * i / kernelSize;
+        window[static_cast<std::size_t>(i)] = static_cast<float>(0.42 - 0.5 * std::cos(phase)
+                                                                 + 0.08 * std::cos(2.0 * phase));
+    }
+
+    // Until the first kernel is built, a unit impulse in the centre only delays like any kernel would
+    kernels = std::make_unique<SnapshotExchange<LinearPhaseKernel>>();
+    designData[static_cast<std::size_t>(kernelSize / 2)] = 1.0f;
+    partitionKernel(designData.data(), kernels->getWriteSnapshot(), *partitionFft, partitionData.data());
+    kernels->publish();
+    kernels->pull();
+
+    reset();
+
+    if (was_active)
+    {
+        startThread();
+    }
+}
+
+void LinearPhaseConvolver::reset() noexcept
+{
+    const auto channel_bins = static_cast<std::size_t>(numChannels * numPartitions * numBins);
+
+    std::fill(inputs .begin(), inputs .end(), 0.0f);
+    std::fill(outputs.begin(), outputs.end(), 0.0f);
+    std::fill(delayReal.get(), delayReal.get() + channel_bins, 0.0f);
+    std::fill(delayImag.get(), delayImag.get() + channel_bins, 0.0f);
+    inputPosition = 0;
+    delayPosition = 0;
+}
+
+//======================================================================================================================
+void LinearPhaseConvolver::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == isThreadRunning())
+    {
+        return;
+    }
+
+    if (shouldBeActive)
+    {
+        startThread();
+    }
+    else
+    {
+        stopThread(1000);
+    }
+}
+
+//======================================================================================================================
+void LinearPhaseConvolver::requestKernel(const BiquadCoefficients *bands, int numBands) noexcept
+{
+    KernelRequest &request = requests.getWriteSnapshot();
+    request.numBands = juce::jmin(numBands, MaxBands);
+    std::copy(bands, bands + request.numBands, request.bands.begin());
+    requests.publish();
+}
+
+template<class SampleType>
+void LinearPhaseConvolver::process(juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    jassert(buffer.getNumChannels() <= numChannels);
+
+    const int num_channels = juce::jmin(buffer.getNumChannels(), numChannels);
+    const int num_samples  = buffer.getNumSamples();
+
+    for (int start = 0; start < num_samples;)
+    {
+        const int count = juce::jmin(num_samples - start, partitionSize - inputPosition);
+
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            SampleType *const data = buffer.getWritePointer(channel, start);
+            float *const input     = inputs .data() + channel * partitionSize * 2 + partitionSize + inputPosition;
+            const float *output    = outputs.data() + channel * partitionSize + inputPosition;
+
+            for (int i = 0; i < count; ++i)
+            {
+                input[i] = static_cast<float>(data[i]);
+                data[i]  = static_cast<SampleType>(output[i]);
+            }
+        }
+
+        start         += count;
+        inputPosition += count;
+
+        if (inputPosition == partitionSize)
+        {
+            processPartition(num_channels);
+            inputPosition = 0;
+        }
+    }
+}
+
+//======================================================================================================================
+void LinearPhaseConvolver::run()
+{
+    while (!threadShouldExit())
+    {
+        // Polling is what limits the rate, a drag ends up with the bands from its last poll and is built once more
+        if (requests.pull())
+        {
+            buildKernel(requests.getReadSnapshot(), kernels->getWriteSnapshot());
+            kernels->publish();
+        }
+
+        wait(RebuildIntervalMs);
+    }
+}
+
+void LinearPhaseConvolver::buildKernel(const KernelRequest &request, LinearPhaseKernel &kernel) noexcept
+{
+    // The magnitude response of all bands together, on the bins of the design transform and with zero phase
+    for (int bin = 0; bin <= kernelSize / 2; ++bin)
+    {
+        const std::complex<double> z1 = std::polar(1.0, -juce::MathConstants<double>::twoPi * bin / kernelSize);
+        const std::complex<double> z2 = z1 * z1;
+        double magnitude = 1.0;
+
+        for (int i = 0; i < request.numBands; ++i)
+        {
+            const BiquadCoefficients &band = request.bands[static_cast<std::size_t>(i)];
+
+            if (!band.isIdentity())
+            {
+                magnitude *= std::abs(band.b0 + band.b1 * z1 + band.b2 * z2) / std::abs(1.0 + band.a1 * z1
+                                                                                       + band.a2 * z2);
+            }
+        }
+
+        designData[static_cast<std::size_t>(bin) * 2]     = static_cast<float>(magnitude);
+        designData[static_cast<std::size_t>(bin) * 2 + 1] = 0.0f;
+    }
+
+    designFft->performRealOnlyInverseTransform(designData.data());
+
+    // The zero-phase response is centred around the first sample, turning it by half the kernel makes it causal
+    std::rotate(designData.begin(), designData.begin() + kernelSize / 2, designData.begin() + kernelSize);
+    juce::FloatVectorOperations::multiply(designData.data(), window.data(), kernelSize);
+
+    partitionKernel(designData.data(), kernel, *partitionFft, partitionData.data());
+}
+
+void LinearPhaseConvolver::partitionKernel(const float *impulse, LinearPhaseKernel &kernel, juce::dsp::FFT &transform,
+                                           float *scratch) const noexcept
+{
+    for (int partition = 0; partition < numPartitions; ++partition)
+    {
+        std::fill(scratch, scratch + partitionSize * 4, 0.0f);
+        std::copy(impulse + partition * partitionSize, impulse + (partition + 1) * partitionSize, scratch);
+        transform.performRealOnlyForwardTransform(scratch, true);
+
+        float *const real = kernel.real.data() + partition * numBins;
+        float *const imag = kernel.imag.data() + partition * numBins;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            real[bin] = scratch[bin * 2];
+            imag[bin] = scratch[bin * 2 + 1];
+        }
+    }
+}
+
+//======================================================================================================================
+void LinearPhaseConvolver::processPartition(int numActiveChannels) noexcept
+{
+    float *const fft_data = fftData.data();
+
+    // Channels the host doesn't feed cost nothing, should they come back they start off with a stale delay line
+    for (int channel = 0; channel < numActiveChannels; ++channel)
+    {
+        float *const input = inputs.data() + channel * partitionSize * 2;
+
+        // Overlap-save: the previous partition and this one, the transform is twice the size of a partition
+        std::copy(input, input + partitionSize * 2, fft_data);
+        std::fill(fft_data + partitionSize * 2, fft_data + partitionSize * 4, 0.0f);
+        fft->performRealOnlyForwardTransform(fft_data, true);
+
+        const int offset = (channel * numPartitions + delayPosition) * numBins;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            delayReal[static_cast<std::size_t>(offset + bin)] = fft_data[bin * 2];
+            delayImag[static_cast<std::size_t>(offset + bin)] = fft_data[bin * 2 + 1];
+        }
+
+        std::copy(input + partitionSize, input + partitionSize * 2, input);
+    }
+
+    // Checked before, so both kernels can be run on this partition when a new one arrived
+    const bool has_new_kernel = kernels->hasUpdate();
+
+    for (int channel = 0; channel < numActiveChannels; ++channel)
+    {
+        convolve(channel, kernels->getReadSnapshot(), outputs.data() + channel * partitionSize);
+    }
+
+    if (has_new_kernel && kernels->pull())
+    {
+        const float step = 1.0f / static_cast<float>(partitionSize);
+
+        for (int channel = 0; channel < numActiveChannels; ++channel)
+        {
+            float *const output = outputs.data() + channel * partitionSize;
+            convolve(channel, kernels->getReadSnapshot(), fadeOutput.data());
+
+            for (int i = 0; i < partitionSize; ++i)
+            {
+                const float amount = static_cast<float>(i + 1) * step;
+                output[i] += (fadeOutput[static_cast<std::size_t>(i)] - output[i]) * amount;
+            }
+        }
+    }
+
+    delayPosition = (delayPosition + 1) % numPartitions;
+}
+
+void LinearPhaseConvolver::convolve(int channel, const LinearPhaseKernel &kernel, float *destination) noexcept
+{
+    using simd::VecF;
+
+    float *const sum_real = sumReal.get();
+    float *const sum_imag = sumImag.get();
+    const int vector_end  = numBins - numBins % VecF::Size;
+
+    std::fill(sum_real, sum_real + numBins, 0.0f);
+    std::fill(sum_imag, sum_imag + numBins, 0.0f);
+
+    for (int partition = 0; partition < numPartitions; ++partition)
+    {
+        // The input from partition blocks ago meets the kernel partition as much delayed
+        const int slot = (delayPosition - partition + numPartitions) % numPartitions;
+        const float *const x_real = delayReal.get() + (channel * numPartitions + slot) * numBins;
+        const float *const x_imag = delayImag.get() + (channel * numPartitions + slot) * numBins;
+        const float *const h_real = kernel.real.data() + partition * numBins;
+        const float *const h_imag = kernel.imag.data() + partition * numBins;
+
+        for (int i = 0; i < vector_end; i += VecF::Size)
+        {
+            const VecF xr = VecF::load(x_real + i);
+            const VecF xi = VecF::load(x_imag + i);
+            const VecF hr = VecF::load(h_real + i);
+            const VecF hi = VecF::load(h_imag + i);
+
+            (VecF::load(sum_real + i) + xr * hr - xi * hi).store(sum_real + i);
+            (VecF::load(sum_imag + i) + xr * hi + xi * hr).store(sum_imag + i);
+        }
+
+        for (int i = vector_end; i < numBins; ++i)
+        {
+            sum_real[i] += x_real[i] * h_real[i] - x_imag[i] * h_imag[i];
+            sum_imag[i] += x_real[i] * h_imag[i] + x_imag[i] * h_real[i];
+        }
+    }
+
+    float *const fft_data = fftData.data();
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        fft_data[bin * 2]     = sum_real[bin];
+        fft_data[bin * 2 + 1] = sum_imag[bin];
+    }
+
+    fft->performRealOnlyInverseTransform(fft_data);
+
+    // Only the second half is free of the wrap-around of the circular convolution
+    std::copy(fft_data + partitionSize, fft_data + partitionSize * 2, destination);
+}
+
+//======================================================================================================================
+template void LinearPhaseConvolver::process(juce::AudioBuffer<float>&) noexcept;
+template void LinearPhaseConvolver::process(juce::AudioBuffer<double>&) noexcept;
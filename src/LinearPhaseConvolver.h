@@ -0,0 +1,157 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LinearPhaseConvolver.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include "BiquadCascade.h"
+#include "SimdOps.h"
+#include "SnapshotExchange.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ *  A linear-phase FIR kernel, split into uniform partitions which are stored as their spectra.
+ *  Partition p occupies the bins from p * (partitionSize + 1) on, as separate real and imaginary parts.
+ */
+struct LinearPhaseKernel
+{
+    static constexpr int MinKernelOrder    = 10;
+    static constexpr int MaxKernelOrder    = 14;
+    static constexpr int MinPartitionOrder = 6;
+    static constexpr int MaxPartitionOrder = 11;
+
+    /** The number of bins of the largest kernel cut into the smallest partitions. */
+    static constexpr int MaxBins = (1 << MaxKernelOrder) + (1 << (MaxKernelOrder - MinPartitionOrder));
+
+    //==================================================================================================================
+    std::array<float, MaxBins> real {};
+    std::array<float, MaxBins> imag {};
+};
+
+/**
+ *  Applies the magnitude response of a set of biquads with linear phase, by uniformly partitioned convolution.
+ *
+ *  The audio thread only hands the current bands over and convolves: it collects partitions of input, transforms them
+ *  into a frequency-domain delay line and multiplies that with the partitions of the kernel.
+ *  Kernels are designed on a worker thread, which looks for new bands every RebuildIntervalMs at the most, so that a
+ *  parameter drag costs a handful of rebuilds per second rather than one per block. Finished kernels are swapped in
+ *  atomically at the next partition boundary and crossfaded to over one partition.
+ *
+ *  The kernel is centred in its window, so it delays the signal by half its size, and the partitioning adds another
+ *  partition on top; getLatencySamples() has the sum.
+ */
+class LinearPhaseConvolver final : private juce::Thread
+{
+public:
+    static constexpr int DefaultKernelOrder    = 12;
+    static constexpr int DefaultPartitionOrder = 8;
+    static constexpr int MaxBands              = BiquadCascade<float>::MaxSections;
+    static constexpr int MaxChannels           = BiquadCascade<float>::MaxChannels;
+    static constexpr int RebuildIntervalMs     = 50;
+
+    //==================================================================================================================
+    LinearPhaseConvolver();
+    ~LinearPhaseConvolver() override;
+
+    //==================================================================================================================
+    /**
+     *  Sets the convolver up, this allocates and must not be called while processing.
+     *  The kernel starts out as a plain delay, until the first one is built.
+     *
+     *  @param numChannels    The number of channels to convolve, up to MaxChannels
+     *  @param kernelOrder    The size of the kernel as a power of two
+     *  @param partitionOrder The size of the partitions as a power of two, at most the size of the kernel
+     */
+    void prepare(int numChannels, int kernelOrder, int partitionOrder);
+
+    /** Clears the signal held by the convolver, realtime safe. */
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /** Starts or stops the kernel builder, call this from the message thread. */
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept { return isThreadRunning(); }
+
+    //==================================================================================================================
+    /** Hands new bands to the builder, realtime safe; identities are skipped. */
+    void requestKernel(const BiquadCoefficients *bands, int numBands) noexcept;
+
+    /** Convolves a block in place, realtime safe. */
+    template<class SampleType>
+    void process(juce::AudioBuffer<SampleType>&) noexcept;
+
+    //==================================================================================================================
+    int getLatencySamples() const noexcept { return kernelSize / 2 + partitionSize; }
+
+private:
+    struct KernelRequest
+    {
+        std::array<BiquadCoefficients, MaxBands> bands;
+        int numBands { 0 };
+    };
+
+    //==================================================================================================================
+    SnapshotExchange<KernelRequest> requests;
+    std::unique_ptr<SnapshotExchange<LinearPhaseKernel>> kernels;
+    int kernelSize    { 0 };
+    int partitionSize { 0 };
+    int numPartitions { 0 };
+    int numBins       { 0 };
+
+    // Audio thread only from here on
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> inputs;
+    std::vector<float> outputs;
+    simd::AlignedBlock<float> delayReal;
+    simd::AlignedBlock<float> delayImag;
+    simd::AlignedBlock<float> sumReal;
+    simd::AlignedBlock<float> sumImag;
+    std::vector<float> fftData;
+    std::vector<float> fadeOutput;
+    int numChannels    { 0 };
+    int inputPosition  { 0 };
+    int delayPosition  { 0 };
+
+    // Worker thread only from here on
+    std::unique_ptr<juce::dsp::FFT> designFft;
+    std::unique_ptr<juce::dsp::FFT> partitionFft;
+    std::vector<float> designData;
+    std::vector<float> partitionData;
+    std::vector<float> window;
+
+    //==================================================================================================================
+    void run() override;
+    void buildKernel(const KernelRequest&, LinearPhaseKernel&) noexcept;
+    void partitionKernel(const float *impulse, LinearPhaseKernel&, juce::dsp::FFT&, float *scratch) const noexcept;
+
+    //==================================================================================================================
+    void processPartition(int numActiveChannels) noexcept;
+    void convolve(int channel, const LinearPhaseKernel&, float *destination) noexcept;
+};
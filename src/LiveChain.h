@@ -0,0 +1,250 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LiveChain.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "EpochReclaimer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ *  Lets the message thread replace a processing chain while the audio thread keeps running, without either of them
+ *  waiting for the other.
+ *
+ *  A chain is immutable once published: the message thread builds and prepares a complete new one, module
+ *  beginPlayback calls included, and swaps it in with a single atomic exchange. The audio thread picks it up with its
+ *  next block and crossfades from the old chain over CrossfadeSeconds. The old chain is retired to an EpochReclaimer,
+ *  which frees it on its own thread once the audio thread let go of it; so the audio thread never locks, allocates or
+ *  frees anything.
+ *
+ *  During the crossfade both chains run, which is why they must not share module instances; a new chain gets
+ *  instances of its own. Chains that are published faster than they can be faded to are skipped.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ *  @tparam Chain      The chain type, anything with a bool process(juce::AudioBuffer<SampleType>&, bool) like
+ *                     ModuleStack and ModuleGraph
+ */
+template<class SampleType, class Chain>
+class LiveChain final
+{
+public:
+    static constexpr double CrossfadeSeconds = 0.01;
+
+    //==================================================================================================================
+    explicit LiveChain(EpochReclaimer &chainReclaimer) noexcept
+        : reclaimer(chainReclaimer)
+    {}
+
+    ~LiveChain()
+    {
+        release();
+        delete published.exchange(nullptr);
+    }
+
+    //==================================================================================================================
+    /** Sets up the crossfade and claims the audio thread's reader slot, must not be called while processing. */
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize)
+    {
+        release();
+
+        fadeBuffer.setSize(numChannels, maximumBlockSize, false, false, true);
+        fadeLength = juce::jmax(1, juce::roundToInt(sampleRate * CrossfadeSeconds));
+        reader     = reclaimer.registerReader();
+        jassert(reader >= 0);
+    }
+
+    /** Lets go of every chain the audio thread held on to, must not be called while processing. */
+    void release()
+    {
+        leave();
+
+        if (reader >= 0)
+        {
+            reclaimer.unregisterReader(reader);
+            reader = -1;
+        }
+
+        fadeBuffer.setSize(0, 0);
+    }
+
+    //==================================================================================================================
+    /**
+     *  Swaps in a new chain, which must already be prepared; the old one gets freed once the audio thread is done
+     *  with it. Always call this from the same thread, usually the message thread.
+     *
+     *  @param newChain The new chain, or nullptr for none which passes the signal through
+     */
+    void publish(std::unique_ptr<Chain> newChain)
+    {
+        std::unique_ptr<Chain> old_chain(published.exchange(newChain.release(), std::memory_order_seq_cst));
+        reclaimer.retire(std::move(old_chain));
+    }
+
+    /** Gets the published chain, only from the thread calling publish() or while not processing. */
+    Chain* getPublished() const noexcept { return published.load(std::memory_order_relaxed); }
+
+    /**
+     *  Calls a function with the published chain, which is nullptr if there is none, and returns what it returns.
+     *  Safe from any thread but the audio thread, the chain stays alive until the function returned.
+     */
+    template<class Function>
+    auto read(Function &&function) const
+    {
+        const EpochReclaimer::ReadGuard guard(reclaimer);
+        return function(static_cast<const Chain*>(published.load(std::memory_order_seq_cst)));
+    }
+
+    //==================================================================================================================
+    /** Audio thread, picks up a newly published chain; call this once per block before using the chain. */
+    void enter() noexcept
+    {
+        if (reader < 0)
+        {
+            return;
+        }
+
+        // The epoch is pinned before the chain is loaded, from then on the chain can't be freed
+        if (!isEntered)
+        {
+            currentEpoch = reclaimer.getEpoch();
+            reclaimer.pin(reader, currentEpoch);
+            current   = published.load(std::memory_order_seq_cst);
+            isEntered = true;
+            return;
+        }
+
+        const std::uint64_t epoch = reclaimer.getEpoch();
+        Chain *const latest       = published.load(std::memory_order_seq_cst);
+
+        if (latest == current)
+        {
+            // Still published as of this epoch, so it can't have been retired any earlier
+            currentEpoch = epoch;
+        }
+        else if (!isFading)
+        {
+            fadingOut      = current;
+            fadingOutEpoch = currentEpoch;
+            current        = latest;
+            currentEpoch   = epoch;
+            fadePosition   = 0;
+            isFading       = true;
+        }
+
+        // Holding on to the older epoch while fading keeps the outgoing chain alive
+        reclaimer.pin(reader, isFading ? fadingOutEpoch : currentEpoch);
+    }
+
+    /** Audio thread, lets go of all chains for as long as enter() isn't called again; no crossfade on return. */
+    void leave() noexcept
+    {
+        if (reader >= 0 && isEntered)
+        {
+            reclaimer.unpin(reader);
+        }
+
+        current   = nullptr;
+        fadingOut = nullptr;
+        isFading  = false;
+        isEntered = false;
+    }
+
+    /** Audio thread, the chain as of the last enter(). */
+    Chain* getCurrent() const noexcept { return current; }
+
+    //==================================================================================================================
+    /**
+     *  Runs a block through the current chain, crossfading from the previous one if it was just swapped.
+     *
+     *  @param buffer   The block to process in place
+     *  @param isSilent Whether the block is known to be silent
+     *  @return True if the output is still silent
+     */
+    bool process(juce::AudioBuffer<SampleType> &buffer, bool isSilent) noexcept
+    {
+        jassert(isEntered);
+
+        if (!isFading)
+        {
+            return current ? current->process(buffer, isSilent) : isSilent;
+        }
+
+        const int num_samples  = buffer.getNumSamples();
+        const int num_channels = juce::jmin(buffer.getNumChannels(), fadeBuffer.getNumChannels());
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            fadeBuffer.copyFrom(ch, 0, buffer, ch, 0, num_samples);
+        }
+
+        juce::AudioBuffer<SampleType> old_block(fadeBuffer.getArrayOfWritePointers(), num_channels, num_samples);
+        const bool old_silent = fadingOut ? fadingOut->process(old_block, isSilent) : isSilent;
+        const bool new_silent = current   ? current  ->process(buffer,    isSilent) : isSilent;
+
+        // Both chains carry the same material, so a linear fade keeps the level
+        const int num_fading = juce::jmin(num_samples, fadeLength - fadePosition);
+        const auto gain_start = static_cast<SampleType>(fadePosition) / static_cast<SampleType>(fadeLength);
+        const auto gain_end   = static_cast<SampleType>(fadePosition + num_fading) / static_cast<SampleType>(fadeLength);
+
+        for (int ch = 0; ch < num_channels; ++ch)
+        {
+            buffer.applyGainRamp(ch, 0, num_fading, gain_start, gain_end);
+            buffer.addFromWithRamp(ch, 0, fadeBuffer.getReadPointer(ch), num_fading,
+                                   SampleType(1) - gain_start, SampleType(1) - gain_end);
+        }
+
+        fadePosition += num_fading;
+
+        if (fadePosition >= fadeLength)
+        {
+            fadingOut = nullptr;
+            isFading  = false;
+        }
+
+        return old_silent && new_silent;
+    }
+
+private:
+    EpochReclaimer &reclaimer;
+    std::atomic<Chain*> published { nullptr };
+
+    // Audio thread only, or while not processing
+    Chain *current   { nullptr };
+    Chain *fadingOut { nullptr };
+    std::uint64_t currentEpoch   { 0 };
+    std::uint64_t fadingOutEpoch { 0 };
+    juce::AudioBuffer<SampleType> fadeBuffer;
+    int fadeLength   { 1 };
+    int fadePosition { 0 };
+    int reader       { -1 };
+    bool isFading    { false };
+    bool isEntered   { false };
+
+    JUCE_DECLARE_NON_COPYABLE(LiveChain)
+};
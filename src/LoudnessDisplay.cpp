@@ -0,0 +1,84 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LoudnessDisplay.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "LoudnessDisplay.h"
+#include "PluginEditor.h"
+
+namespace
+{
+//======================================================================================================================
+juce::String formatLoudness(float value, const char *unit)
+{
+    return (value < LoudnessMeter::AbsoluteGate ? juce::String("-INF") : juce::String(value, 1)) + " " + unit;
+}
+}
+
+//======================================================================================================================
+void LoudnessDisplay::setReading(const LoudnessReading &newReading)
+{
+    reading = newReading;
+    repaint();
+}
+
+//======================================================================================================================
+void LoudnessDisplay::paint(juce::Graphics &g)
+{
+    const PluginStyle &style = getPluginStyle(*this);
+    const juce::Rectangle<float> bounds = getLocalBounds().toFloat();
+    const float cell_width  = bounds.getWidth() / 2.0f;
+    const float cell_height = 17.0f;
+    
+    const auto draw_cell = [&](int column, int row, const juce::String &name, const juce::String &value)
+    {
+        const juce::Rectangle<float> cell(bounds.getX() + cell_width * static_cast<float>(column),
+                                          bounds.getY() + cell_height * static_cast<float>(row),
+                                          cell_width - 8.0f, cell_height);
+        jaut::FontFormat::drawSmallCaps(g, name, cell, juce::Justification::centredLeft);
+        g.drawText(value, cell, juce::Justification::centredRight);
+    };
+    
+    g.setFont(style.getFont(14.0f, 0, 1.0f, 0.1f));
+    g.setColour(style.findColour(CossinAudioProcessorEditor::ColourFontId));
+    
+    draw_cell(0, 0, "M",   ::formatLoudness(reading.momentary,  "LUFS"));
+    draw_cell(1, 0, "S",   ::formatLoudness(reading.shortTerm,  "LUFS"));
+    draw_cell(0, 1, "I",   ::formatLoudness(reading.integrated, "LUFS"));
+    draw_cell(1, 1, "LRA", reading.range < 0.0f ? juce::String("-- LU") : juce::String(reading.range, 1) + " LU");
+    
+    const auto seconds = static_cast<int>(reading.seconds);
+    const juce::Rectangle<float> time_row(bounds.getX(), bounds.getY() + cell_height * 2.0f,
+                                          bounds.getWidth() - 8.0f, cell_height);
+    jaut::FontFormat::drawSmallCaps(g, "Time", time_row, juce::Justification::centredLeft);
+    g.drawText(juce::String::formatted("%d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60), time_row,
+               juce::Justification::centredRight);
+}
+
+void LoudnessDisplay::mouseDown(const juce::MouseEvent&)
+{
+    if (onReset)
+    {
+        onReset();
+    }
+}
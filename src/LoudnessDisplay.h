@@ -0,0 +1,53 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LoudnessDisplay.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "LoudnessMeter.h"
+
+#include <functional>
+
+/**
+ *  The loudness readout of the editor footer, showing momentary, short-term and integrated loudness and the
+ *  loudness range with their EBU R128 abbreviations. Clicking it starts the measurement over.
+ */
+class LoudnessDisplay final : public juce::Component
+{
+public:
+    /** Called when the user asks for the measurement to start over. */
+    std::function<void()> onReset;
+    
+    //==================================================================================================================
+    void setReading(const LoudnessReading&);
+    
+    //==================================================================================================================
+    void paint(juce::Graphics&) override;
+    void mouseDown(const juce::MouseEvent&) override;
+    
+private:
+    LoudnessReading reading;
+};
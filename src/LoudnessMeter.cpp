@@ -0,0 +1,384 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LoudnessMeter.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "LoudnessMeter.h"
+
+namespace
+{
+//======================================================================================================================
+constexpr int scratchSize = 256;
+
+//======================================================================================================================
+// ITU-R BS.1770-4, Table 3: surround speakers between 60 and 120 degrees count 1.41 times, LFE channels not at all
+float getChannelWeight(juce::AudioChannelSet::ChannelType type) noexcept
+{
+    switch (type)
+    {
+        case juce::AudioChannelSet::LFE:
+        case juce::AudioChannelSet::LFE2:
+            return 0.0f;
+
+        case juce::AudioChannelSet::wideLeft:
+        case juce::AudioChannelSet::wideRight:
+        case juce::AudioChannelSet::leftSurroundSide:
+        case juce::AudioChannelSet::rightSurroundSide:
+        case juce::AudioChannelSet::leftSurround:
+        case juce::AudioChannelSet::rightSurround:
+            return 1.41f;
+
+        default:
+            return 1.0f;
+    }
+}
+
+float toLoudness(double power) noexcept
+{
+    return power > 0.0 ? static_cast<float>(-0.691 + 10.0 * std::log10(power))
+                       : -std::numeric_limits<float>::infinity();
+}
+
+float getSquareSum(const float *data, int numSamples) noexcept
+{
+    using Vec = simd::VecF;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    Vec sums = Vec::zero();
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        const Vec samples = Vec::load(data + i);
+        sums = sums + samples * samples;
+    }
+
+    float sum = simd::sum(sums);
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        sum += data[i] * data[i];
+    }
+
+    return sum;
+}
+}
+
+//======================================================================================================================
+void LoudnessMeter::prepare(double newSampleRate, const juce::AudioChannelSet &layout)
+{
+    jassert(newSampleRate > 0.0);
+
+    sampleRate = newSampleRate;
+    stepSize   = juce::jmax(1, juce::roundToInt(0.1 * sampleRate));
+
+    // The K-weighting filters, the stage 1 shelf and stage 2 high-pass of BS.1770-4 redesigned for the sample rate
+    {
+        const double k    = std::tan(juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+        const double q    = 0.7071752369554196;
+        const double vh   = std::pow(10.0, 3.999843853973347 / 20.0);
+        const double vb   = std::pow(vh, 0.4996667741545416);
+        const double norm = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / norm;
+        shelf.b1 = 2.0 * (k * k - vh)        / norm;
+        shelf.b2 = (vh - vb * k / q + k * k) / norm;
+        shelf.a1 = 2.0 * (k * k - 1.0)       / norm;
+        shelf.a2 = (1.0 - k / q + k * k)     / norm;
+    }
+
+    {
+        const double k    = std::tan(juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+        const double q    = 0.5003270373238773;
+        const double norm = 1.0 + k / q + k * k;
+
+        highPass.b0 =  1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 =  1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0)   / norm;
+        highPass.a2 = (1.0 - k / q + k * k) / norm;
+    }
+
+    channels.clear();
+
+    for (const juce::AudioChannelSet::ChannelType type : layout.getChannelTypes())
+    {
+        channels.emplace_back().weight = ::getChannelWeight(type);
+    }
+
+    scratch.allocate(scratchSize);
+    reset();
+}
+
+void LoudnessMeter::reset() noexcept
+{
+    for (ChannelState &state : channels)
+    {
+        state.filterState.fill(0.0);
+        state.stepSum = 0.0;
+    }
+
+    stepPowers.fill(0.0);
+    gatingBlocks    = {};
+    shortTermBlocks = {};
+    reading         = {};
+    numStepsTaken   = 0;
+    stepPosition    = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void LoudnessMeter::process(const juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    if (resetRequested.exchange(false, std::memory_order_acquire))
+    {
+        reset();
+    }
+
+    const int num_channels = juce::jmin(buffer.getNumChannels(), static_cast<int>(channels.size()));
+    const int num_samples  = buffer.getNumSamples();
+
+    // Slices never cross a step boundary, so each step sums exactly its own samples
+    for (int position = 0; position < num_samples;)
+    {
+        const int length = juce::jmin(scratchSize, num_samples - position, stepSize - stepPosition);
+
+        for (int i = 0; i < num_channels; ++i)
+        {
+            weightChannel(channels[static_cast<std::size_t>(i)], buffer.getReadPointer(i, position), length);
+        }
+
+        position     += length;
+        stepPosition += length;
+
+        if (stepPosition == stepSize)
+        {
+            stepPosition = 0;
+            finishStep();
+        }
+    }
+}
+
+template<class SampleType>
+void LoudnessMeter::weightChannel(ChannelState &state, const SampleType *data, int numSamples) noexcept
+{
+    double s1 = state.filterState[0], s2 = state.filterState[1];
+    double s3 = state.filterState[2], s4 = state.filterState[3];
+    float *weighted = scratch.get();
+
+    // Recursive, so this part is serial; the filters run in double as the high-pass sits at only 38Hz
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double input = static_cast<double>(data[i]);
+
+        const double shelved = shelf.b0 * input + s1;
+        s1 = shelf.b1 * input - shelf.a1 * shelved + s2;
+        s2 = shelf.b2 * input - shelf.a2 * shelved;
+
+        const double output = highPass.b0 * shelved + s3;
+        s3 = highPass.b1 * shelved - highPass.a1 * output + s4;
+        s4 = highPass.b2 * shelved - highPass.a2 * output;
+
+        weighted[i] = static_cast<float>(output);
+    }
+
+    state.filterState = { s1, s2, s3, s4 };
+    state.stepSum    += ::getSquareSum(weighted, numSamples);
+}
+
+//======================================================================================================================
+void LoudnessMeter::finishStep() noexcept
+{
+    double power = 0.0;
+
+    for (ChannelState &state : channels)
+    {
+        power        += state.weight * state.stepSum / stepSize;
+        state.stepSum = 0.0;
+    }
+
+    stepPowers[static_cast<std::size_t>(numStepsTaken % NumStepsShortTerm)] = power;
+    ++numStepsTaken;
+
+    reading.seconds = static_cast<double>(numStepsTaken) * stepSize / sampleRate;
+
+    // Every step completes a 400ms gating block overlapping the last one by 75%, as the standard asks for
+    if (numStepsTaken >= NumStepsMomentary)
+    {
+        const double momentary_power = getMeanStepPower(NumStepsMomentary);
+
+        reading.momentary    = ::toLoudness(momentary_power);
+        reading.maxMomentary = juce::jmax(reading.maxMomentary, reading.momentary);
+
+        if (reading.momentary >= AbsoluteGate)
+        {
+            addToHistogram(gatingBlocks, momentary_power, reading.momentary);
+        }
+
+        reading.integrated = getIntegratedLoudness();
+    }
+
+    if (numStepsTaken >= NumStepsShortTerm)
+    {
+        const double short_term_power = getMeanStepPower(NumStepsShortTerm);
+
+        reading.shortTerm    = ::toLoudness(short_term_power);
+        reading.maxShortTerm = juce::jmax(reading.maxShortTerm, reading.shortTerm);
+
+        if (reading.shortTerm >= AbsoluteGate)
+        {
+            addToHistogram(shortTermBlocks, short_term_power, reading.shortTerm);
+        }
+
+        reading.range = getLoudnessRange();
+    }
+
+    publish();
+}
+
+void LoudnessMeter::publish() noexcept
+{
+    snapshots.getWriteSnapshot() = reading;
+    snapshots.publish();
+
+    const juce::AbstractFifo::ScopedWrite scope = logFifo.write(1);
+
+    if (scope.blockSize1 > 0)
+    {
+        log[static_cast<std::size_t>(scope.startIndex1)] = reading;
+    }
+}
+
+int LoudnessMeter::readLog(LoudnessReading *destination, int maxReadings) noexcept
+{
+    const juce::AbstractFifo::ScopedRead scope = logFifo.read(juce::jmin(maxReadings, logFifo.getNumReady()));
+
+    std::copy_n(log.begin() + scope.startIndex1, scope.blockSize1, destination);
+    std::copy_n(log.begin() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+//======================================================================================================================
+double LoudnessMeter::getMeanStepPower(int numSteps) const noexcept
+{
+    double sum = 0.0;
+
+    for (int i = 1; i <= numSteps; ++i)
+    {
+        sum += stepPowers[static_cast<std::size_t>((numStepsTaken - i) % NumStepsShortTerm)];
+    }
+
+    return sum / numSteps;
+}
+
+float LoudnessMeter::getIntegratedLoudness() const noexcept
+{
+    if (gatingBlocks.numBlocks == 0)
+    {
+        return -std::numeric_limits<float>::infinity();
+    }
+
+    // The relative gate sits 10 LU below the mean of everything above the absolute gate
+    const float relative_gate = ::toLoudness(gatingBlocks.powerSum / static_cast<double>(gatingBlocks.numBlocks))
+                                - 10.0f;
+    const int first_bin = juce::jlimit(0, NumHistogramBins - 1,
+                                       static_cast<int>((relative_gate - AbsoluteGate) * 10.0f));
+
+    double power        = 0.0;
+    std::uint64_t count = 0;
+
+    for (int i = first_bin; i < NumHistogramBins; ++i)
+    {
+        power += gatingBlocks.powers[static_cast<std::size_t>(i)];
+        count += gatingBlocks.counts[static_cast<std::size_t>(i)];
+    }
+
+    return count > 0 ? ::toLoudness(power / static_cast<double>(count)) : -std::numeric_limits<float>::infinity();
+}
+
+float LoudnessMeter::getLoudnessRange() const noexcept
+{
+    if (shortTermBlocks.numBlocks == 0)
+    {
+        return -std::numeric_limits<float>::infinity();
+    }
+
+    // EBU Tech 3342: the spread between the 10th and 95th percentile, relative gate 20 LU below the mean
+    const float relative_gate = ::toLoudness(shortTermBlocks.powerSum
+                                             / static_cast<double>(shortTermBlocks.numBlocks)) - 20.0f;
+    const int first_bin = juce::jlimit(0, NumHistogramBins - 1,
+                                       static_cast<int>((relative_gate - AbsoluteGate) * 10.0f));
+
+    std::uint64_t total = 0;
+
+    for (int i = first_bin; i < NumHistogramBins; ++i)
+    {
+        total += shortTermBlocks.counts[static_cast<std::size_t>(i)];
+    }
+
+    if (total == 0)
+    {
+        return 0.0f;
+    }
+
+    const double low_rank  = 0.10 * static_cast<double>(total);
+    const double high_rank = 0.95 * static_cast<double>(total);
+
+    std::uint64_t cumulative = 0;
+    int low_bin  = -1;
+    int high_bin = first_bin;
+
+    for (int i = first_bin; i < NumHistogramBins; ++i)
+    {
+        cumulative += shortTermBlocks.counts[static_cast<std::size_t>(i)];
+
+        if (low_bin < 0 && static_cast<double>(cumulative) >= low_rank)
+        {
+            low_bin = i;
+        }
+
+        if (static_cast<double>(cumulative) >= high_rank)
+        {
+            high_bin = i;
+            break;
+        }
+    }
+
+    return static_cast<float>(high_bin - juce::jmax(first_bin, low_bin)) * 0.1f;
+}
+
+void LoudnessMeter::addToHistogram(Histogram &histogram, double power, float loudness) noexcept
+{
+    const int bin = juce::jlimit(0, NumHistogramBins - 1, static_cast<int>((loudness - AbsoluteGate) * 10.0f));
+
+    ++histogram.counts[static_cast<std::size_t>(bin)];
+    histogram.powers[static_cast<std::size_t>(bin)] += power;
+    histogram.powerSum += power;
+    ++histogram.numBlocks;
+}
+
+//======================================================================================================================
+template void LoudnessMeter::process(const juce::AudioBuffer<float>&) noexcept;
+template void LoudnessMeter::process(const juce::AudioBuffer<double>&) noexcept;
@@ -0,0 +1,149 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   LoudnessMeter.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "SimdOps.h"
+#include "SnapshotExchange.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/** One set of loudness readings, loudness in LUFS and the range in LU; anything not measurable yet is -infinity. */
+struct LoudnessReading
+{
+    float momentary    { -std::numeric_limits<float>::infinity() };
+    float shortTerm    { -std::numeric_limits<float>::infinity() };
+    float integrated   { -std::numeric_limits<float>::infinity() };
+    float range        { -std::numeric_limits<float>::infinity() };
+    float maxMomentary { -std::numeric_limits<float>::infinity() };
+    float maxShortTerm { -std::numeric_limits<float>::infinity() };
+
+    /** The amount of audio measured since the last reset. */
+    double seconds { 0.0 };
+};
+
+/**
+ *  Measures loudness as per ITU-R BS.1770-4 and EBU R128/Tech 3342.
+ *
+ *  Every channel is K-weighted and its squares are summed in 100ms steps, from which the 400ms momentary and the 3s
+ *  short-term windows are put together. Each step yields a reading, which goes to the editor and into a log.
+ *  Gated integrated loudness and the loudness range come from histograms of 0.1 LU resolution, which keep the exact
+ *  power sum of each bin alongside its count; no matter how long the measurement runs, memory stays the same.
+ *
+ *  All memory is allocated in prepare, processing is realtime safe.
+ */
+class LoudnessMeter final
+{
+public:
+    static constexpr float AbsoluteGate = -70.0f;
+    static constexpr float MaxLoudness  =  10.0f;
+    static constexpr int   LogCapacity  = 1024;
+
+    //==================================================================================================================
+    void prepare(double sampleRate, const juce::AudioChannelSet &layout);
+
+    /** Starts the measurement over, only ever call this from the audio thread or while it is halted. */
+    void reset() noexcept;
+
+    /** Starts the measurement over with the next block, safe to call from any thread. */
+    void requestReset() noexcept { resetRequested.store(true, std::memory_order_release); }
+
+    //==================================================================================================================
+    template<class SampleType>
+    void process(const juce::AudioBuffer<SampleType>&) noexcept;
+
+    //==================================================================================================================
+    /** The latest reading, for the editor. */
+    SnapshotExchange<LoudnessReading>& getSnapshots() noexcept { return snapshots; }
+
+    /**
+     *  Takes up to the given number of readings, oldest first, out of the log and returns how many it took.
+     *  There is one reading per 100ms of audio, if nobody reads them the newest are dropped once the log is full.
+     *  Only ever call this from one thread.
+     */
+    int readLog(LoudnessReading *destination, int maxReadings) noexcept;
+
+private:
+    static constexpr int NumStepsMomentary = 4;
+    static constexpr int NumStepsShortTerm = 30;
+    static constexpr int NumHistogramBins  = static_cast<int>((MaxLoudness - AbsoluteGate) * 10.0f);
+
+    struct Biquad
+    {
+        double b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 }, a1 { 0.0 }, a2 { 0.0 };
+    };
+
+    struct ChannelState
+    {
+        std::array<double, 4> filterState {};
+        double stepSum { 0.0 };
+        float weight   { 1.0f };
+    };
+
+    struct Histogram
+    {
+        std::array<std::uint64_t, NumHistogramBins> counts {};
+        std::array<double, NumHistogramBins> powers {};
+        double powerSum { 0.0 };
+        std::uint64_t numBlocks { 0 };
+    };
+
+    //==================================================================================================================
+    SnapshotExchange<LoudnessReading> snapshots;
+    std::array<LoudnessReading, LogCapacity> log;
+    juce::AbstractFifo logFifo { LogCapacity };
+
+    std::vector<ChannelState> channels;
+    simd::AlignedBlock<float> scratch;
+    std::array<double, NumStepsShortTerm> stepPowers {};
+    Histogram gatingBlocks;
+    Histogram shortTermBlocks;
+    LoudnessReading reading;
+    Biquad shelf;
+    Biquad highPass;
+    std::atomic<bool> resetRequested { false };
+    double sampleRate { 44100.0 };
+    std::int64_t numStepsTaken { 0 };
+    int stepSize     { 1 };
+    int stepPosition { 0 };
+
+    //==================================================================================================================
+    template<class SampleType>
+    void weightChannel(ChannelState&, const SampleType*, int) noexcept;
+    void finishStep() noexcept;
+    void publish() noexcept;
+
+    //==================================================================================================================
+    double getMeanStepPower(int numSteps) const noexcept;
+    float getIntegratedLoudness() const noexcept;
+    float getLoudnessRange() const noexcept;
+    void addToHistogram(Histogram&, double power, float loudness) noexcept;
+};
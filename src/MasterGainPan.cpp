@@ -0,0 +1,233 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MasterGainPan.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "MasterGainPan.h"
+#include "PanningLaws.h"
+
+#include <jaut_util/jaut_util.h>
+
+#include "Resources.h"
+
+namespace
+{
+//======================================================================================================================
+static_assert(panlaw::NumLaws == res::List_PanningModes.size(), "Every panning mode needs a matching panning law");
+
+//======================================================================================================================
+// The azimuth of a speaker in degrees, negative to the left and 0 for speakers on the centre line or without a place
+double getAzimuth(juce::AudioChannelSet::ChannelType type) noexcept
+{
+    switch (type)
+    {
+        case juce::AudioChannelSet::leftCentre:        return  -15.0;
+        case juce::AudioChannelSet::rightCentre:       return   15.0;
+        case juce::AudioChannelSet::left:              return  -30.0;
+        case juce::AudioChannelSet::right:             return   30.0;
+        case juce::AudioChannelSet::topFrontLeft:      return  -45.0;
+        case juce::AudioChannelSet::topFrontRight:     return   45.0;
+        case juce::AudioChannelSet::wideLeft:          return  -60.0;
+        case juce::AudioChannelSet::wideRight:         return   60.0;
+        case juce::AudioChannelSet::leftSurroundSide:  return  -90.0;
+        case juce::AudioChannelSet::rightSurroundSide: return   90.0;
+        case juce::AudioChannelSet::topSideLeft:       return  -90.0;
+        case juce::AudioChannelSet::topSideRight:      return   90.0;
+        case juce::AudioChannelSet::leftSurround:      return -110.0;
+        case juce::AudioChannelSet::rightSurround:     return  110.0;
+        case juce::AudioChannelSet::topRearLeft:       return -135.0;
+        case juce::AudioChannelSet::topRearRight:      return  135.0;
+        case juce::AudioChannelSet::leftSurroundRear:  return -150.0;
+        case juce::AudioChannelSet::rightSurroundRear: return  150.0;
+        default:                                       return    0.0;
+    }
+}
+
+// Projects a speaker onto the left-right axis, normalised to the stereo base so that stereo stays at exactly -1 and 1;
+// rounded so that all speakers on the same side end up sharing a gain row
+float getLateralSide(juce::AudioChannelSet::ChannelType type) noexcept
+{
+    constexpr double stereo_base = 0.5; // sin(30 degrees)
+    const double side = std::sin(juce::degreesToRadians(getAzimuth(type))) / stereo_base;
+    return static_cast<float>(std::round(juce::jlimit(-1.0, 1.0, side) * 1e6) / 1e6);
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MasterGainPan<SampleType>::prepare(double sampleRate, int maximumBlockSize, const juce::AudioChannelSet &layout)
+{
+    sides      .clear();
+    channelRows.clear();
+
+    for (const juce::AudioChannelSet::ChannelType type : layout.getChannelTypes())
+    {
+        const float side = ::getLateralSide(type);
+
+        if (side == 0.0f)
+        {
+            channelRows.emplace_back(0);
+            continue;
+        }
+
+        auto it = std::find(sides.begin(), sides.end(), side);
+
+        if (it == sides.end())
+        {
+            it = sides.insert(sides.end(), side);
+        }
+
+        channelRows.emplace_back(static_cast<int>(std::distance(sides.begin(), it)) + 1);
+    }
+
+    scratchSize   = juce::jmax(1, maximumBlockSize);
+    scratchStride = simd::getAlignedSize<SampleType>(scratchSize);
+    gainRows.allocate((sides.size() + 1) * static_cast<std::size_t>(scratchStride));
+    panRamp .allocate(static_cast<std::size_t>(scratchSize));
+
+    gainSmoothed.reset(sampleRate, SmoothingSeconds);
+    panSmoothed .reset(sampleRate, SmoothingSeconds);
+}
+
+template<class SampleType>
+void MasterGainPan<SampleType>::reset(float gain, float panning, int newPanMode) noexcept
+{
+    jassert(jaut::fit<int>(newPanMode, 0, panlaw::NumLaws));
+
+    gainSmoothed.setCurrentAndTargetValue(gain);
+    panSmoothed .setCurrentAndTargetValue(panning);
+    panMode     = newPanMode;
+    lastPanMode = newPanMode;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MasterGainPan<SampleType>::setTargets(float gain, float panning, int newPanMode) noexcept
+{
+    jassert(jaut::fit<int>(newPanMode, 0, panlaw::NumLaws));
+
+    gainSmoothed.setTargetValue(gain);
+    panSmoothed .setTargetValue(panning);
+    panMode = newPanMode;
+}
+
+template<class SampleType>
+void MasterGainPan<SampleType>::process(juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    const int num_samples = buffer.getNumSamples();
+
+    if (buffer.getNumChannels() == 0 || num_samples == 0)
+    {
+        return;
+    }
+
+    if (!gainSmoothed.isSmoothing() && !panSmoothed.isSmoothing() && panMode == lastPanMode)
+    {
+        processConstant(buffer);
+        return;
+    }
+
+    for (int position = 0; position < num_samples; position += scratchSize)
+    {
+        processSmoothed(buffer, position, juce::jmin(scratchSize, num_samples - position));
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+int MasterGainPan<SampleType>::getChannelRow(int channel) const noexcept
+{
+    // Channels the stage wasn't prepared for are treated as if they sat on the centre line
+    return channel < static_cast<int>(channelRows.size()) ? channelRows[static_cast<std::size_t>(channel)] : 0;
+}
+
+template<class SampleType>
+void MasterGainPan<SampleType>::processConstant(juce::AudioBuffer<SampleType> &buffer) const noexcept
+{
+    const float gain    = gainSmoothed.getTargetValue();
+    const float panning = panSmoothed .getTargetValue();
+
+    for (int i = 0; i < buffer.getNumChannels(); ++i)
+    {
+        const int  row          = getChannelRow(i);
+        const auto channel_gain = static_cast<SampleType>(row == 0 ? gain
+                                                                   : gain * panlaw::getGain(panMode, sides[row - 1],
+                                                                                            panning));
+
+        if (channel_gain != SampleType(1))
+        {
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(i), channel_gain, buffer.getNumSamples());
+        }
+    }
+}
+
+template<class SampleType>
+void MasterGainPan<SampleType>::processSmoothed(juce::AudioBuffer<SampleType> &buffer, int start,
+                                                int numSamples) noexcept
+{
+    SampleType *gain_ramp = getRow(0);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        gain_ramp[i] = static_cast<SampleType>(gainSmoothed.getNextValue());
+        panRamp  [i] = panSmoothed.getNextValue();
+    }
+
+    for (std::size_t side_index = 0; side_index < sides.size(); ++side_index)
+    {
+        SampleType  *gains = getRow(static_cast<int>(side_index) + 1);
+        const float  side  = sides[side_index];
+
+        if (panMode == lastPanMode)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                gains[i] = gain_ramp[i] * static_cast<SampleType>(panlaw::getGain(panMode, side, panRamp[i]));
+            }
+        }
+        else
+        {
+            // Switching the panning law crossfades between the old and the new law over one chunk
+            const float fade_step = 1.0f / static_cast<float>(numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float fade     = static_cast<float>(i + 1) * fade_step;
+                const float old_gain = panlaw::getGain(lastPanMode, side, panRamp[i]);
+                const float new_gain = panlaw::getGain(panMode,     side, panRamp[i]);
+                gains[i] = gain_ramp[i] * static_cast<SampleType>(old_gain + (new_gain - old_gain) * fade);
+            }
+        }
+    }
+
+    lastPanMode = panMode;
+
+    for (int i = 0; i < buffer.getNumChannels(); ++i)
+    {
+        juce::FloatVectorOperations::multiply(buffer.getWritePointer(i, start), getRow(getChannelRow(i)), numSamples);
+    }
+}
+
+//======================================================================================================================
+template class MasterGainPan<float>;
+template class MasterGainPan<double>;
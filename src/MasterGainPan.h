@@ -0,0 +1,80 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MasterGainPan.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "SimdOps.h"
+
+/**
+ *  The master level and panning stage.
+ *  Gain and panning are smoothed separately on a per-sample basis, the resulting per-channel gains are then
+ *  applied to every channel in a vectorised pass.
+ *  If neither gain nor panning are moving, the stage falls back to a constant multiply.
+ *
+ *  Any speaker layout is supported. Every speaker is projected onto the left-right axis by its azimuth, the same
+ *  projection 2D VBAP uses, relative to the stereo base at +-30 degrees. Speakers at or beyond the base follow the
+ *  panning fully, speakers in between partially, while speakers on the centre line and LFE channels only get the gain.
+ *  Speakers sharing a side share their gain ramp, so a 7.1.4 layout costs no more than stereo does.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class MasterGainPan final
+{
+public:
+    static constexpr double SmoothingSeconds = 0.02;
+
+    //==================================================================================================================
+    void prepare(double sampleRate, int maximumBlockSize, const juce::AudioChannelSet &layout);
+    void reset(float gain, float panning, int panMode) noexcept;
+
+    //==================================================================================================================
+    void setTargets(float gain, float panning, int panMode) noexcept;
+    void process(juce::AudioBuffer<SampleType>&) noexcept;
+
+private:
+    juce::SmoothedValue<float> gainSmoothed;
+    juce::SmoothedValue<float> panSmoothed;
+
+    // One gain row per distinct lateral side, plus one for the plain gain, each scratchStride samples apart
+    simd::AlignedBlock<SampleType> gainRows;
+    simd::AlignedBlock<float> panRamp;
+    std::vector<float> sides;
+    std::vector<int> channelRows;
+    int scratchSize   { 0 };
+    int scratchStride { 0 };
+    int panMode       { 0 };
+    int lastPanMode   { 0 };
+
+    //==================================================================================================================
+    SampleType* getRow(int row) const noexcept { return gainRows.get() + row * scratchStride; }
+    int getChannelRow(int channel) const noexcept;
+
+    //==================================================================================================================
+    void processConstant(juce::AudioBuffer<SampleType>&) const noexcept;
+    void processSmoothed(juce::AudioBuffer<SampleType>&, int start, int numSamples) noexcept;
+};
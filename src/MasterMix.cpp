@@ -0,0 +1,263 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MasterMix.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "MasterMix.h"
+#include "SimdOps.h"
+
+namespace
+{
+//======================================================================================================================
+// wet = dry + (wet - dry) * mix, with a per-sample mix
+template<class SampleType>
+void blend(SampleType *wet, const SampleType *dry, const SampleType *mix, int numSamples) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        const Vec dry_v = Vec::load(dry + i);
+        (dry_v + (Vec::load(wet + i) - dry_v) * Vec::load(mix + i)).store(wet + i);
+    }
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        wet[i] = dry[i] + (wet[i] - dry[i]) * mix[i];
+    }
+}
+
+// wet = dry + (wet - dry) * mix, with a constant mix
+template<class SampleType>
+void blend(SampleType *wet, const SampleType *dry, SampleType mix, int numSamples) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+    const Vec mix_v = Vec::broadcast(mix);
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        const Vec dry_v = Vec::load(dry + i);
+        (dry_v + (Vec::load(wet + i) - dry_v) * mix_v).store(wet + i);
+    }
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        wet[i] = dry[i] + (wet[i] - dry[i]) * mix;
+    }
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MasterMix<SampleType>::prepare(double sampleRate, int numChannels, int maximumBlockSize)
+{
+    maxLatency = static_cast<int>(sampleRate * MaxLatencySeconds);
+
+    const int delay_size = juce::nextPowerOfTwo(maxLatency + maximumBlockSize);
+    delayMask = delay_size - 1;
+
+    dryBuffer  .setSize(numChannels, maximumBlockSize);
+    delayBuffer.setSize(numChannels, delay_size);
+    mixRamp.allocate(static_cast<std::size_t>(maximumBlockSize), true);
+    mixSmoothed.reset(sampleRate, SmoothingSeconds);
+
+    latency        = juce::jmin(latency, maxLatency);
+    writePosition  = 0;
+    historySamples = maxLatency;
+    delayBuffer.clear();
+}
+
+template<class SampleType>
+void MasterMix<SampleType>::reset(float mix) noexcept
+{
+    mixSmoothed.setCurrentAndTargetValue(mix);
+    active = mix != 1.0f;
+
+    // Forget what was written so far, the next block zeroes only what the latency reaches back into
+    historySamples = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MasterMix<SampleType>::setLatency(int latencyInSamples) noexcept
+{
+    jassert(latencyInSamples <= maxLatency);
+    latency = juce::jlimit(0, maxLatency, latencyInSamples);
+}
+
+template<class SampleType>
+void MasterMix<SampleType>::setMix(float mix) noexcept
+{
+    mixSmoothed.setTargetValue(mix);
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MasterMix<SampleType>::pushDrySamples(const juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    const int num_samples = buffer.getNumSamples();
+
+    if (!activate(num_samples))
+    {
+        return;
+    }
+
+    const int num_channels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    for (int i = 0; i < num_channels; ++i)
+    {
+        const SampleType *input = buffer.getReadPointer(i);
+        SampleType *dry         = dryBuffer.getWritePointer(i);
+        SampleType *delay       = delayBuffer.getWritePointer(i);
+
+        // Without latency the delay line is still written, a later latency change would otherwise read stale samples
+        for (int j = 0; j < num_samples; ++j)
+        {
+            delay[(writePosition + j) & delayMask] = input[j];
+        }
+
+        if (latency == 0)
+        {
+            juce::FloatVectorOperations::copy(dry, input, num_samples);
+            continue;
+        }
+
+        for (int j = 0; j < num_samples; ++j)
+        {
+            dry[j] = delay[(writePosition + j - latency) & delayMask];
+        }
+    }
+
+    writePosition  = (writePosition + num_samples) & delayMask;
+    historySamples = juce::jmin(historySamples + num_samples, maxLatency);
+}
+
+template<class SampleType>
+void MasterMix<SampleType>::pushSilentSamples(int numSamples) noexcept
+{
+    if (!activate(numSamples))
+    {
+        return;
+    }
+
+    // The delay line holds nothing but silence as far back as the latency reaches, so it can stay as it is; anything
+    // behind that stopped being history though, as the write position doesn't move on while no samples get written
+    historySamples = juce::jmin(historySamples, latency);
+
+    for (int i = 0; i < dryBuffer.getNumChannels(); ++i)
+    {
+        juce::FloatVectorOperations::clear(dryBuffer.getWritePointer(i), numSamples);
+    }
+}
+
+template<class SampleType>
+void MasterMix<SampleType>::mixWetSamples(juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    if (!active)
+    {
+        return;
+    }
+
+    const int num_samples  = buffer.getNumSamples();
+    const int num_channels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    if (mixSmoothed.isSmoothing())
+    {
+        for (int i = 0; i < num_samples; ++i)
+        {
+            mixRamp[i] = mixSmoothed.getNextValue();
+        }
+
+        for (int i = 0; i < num_channels; ++i)
+        {
+            ::blend(buffer.getWritePointer(i), dryBuffer.getReadPointer(i), mixRamp.get(), num_samples);
+        }
+    }
+    else
+    {
+        const auto mix = static_cast<SampleType>(mixSmoothed.getTargetValue());
+
+        for (int i = 0; i < num_channels; ++i)
+        {
+            ::blend(buffer.getWritePointer(i), dryBuffer.getReadPointer(i), mix, num_samples);
+        }
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+bool MasterMix<SampleType>::activate(int numSamples) noexcept
+{
+    const bool was_active = active;
+
+    // Blocks larger than announced in prepareToPlay can't be handled without allocating, so these pass through wet
+    jassert(numSamples <= dryBuffer.getNumSamples());
+    active = (mixSmoothed.isSmoothing() || mixSmoothed.getTargetValue() != 1.0f)
+             && numSamples <= dryBuffer.getNumSamples();
+
+    if (!active)
+    {
+        return false;
+    }
+
+    if (!was_active)
+    {
+        // The delay line wasn't fed while the stage was sleeping, nothing behind the write position is valid anymore
+        historySamples = 0;
+    }
+
+    extendHistory(latency);
+    return true;
+}
+
+template<class SampleType>
+void MasterMix<SampleType>::extendHistory(int numSamples) noexcept
+{
+    if (numSamples <= historySamples)
+    {
+        return;
+    }
+
+    // Only the samples the latency reaches back into and that weren't written yet are zeroed, not the whole buffer
+    for (int i = 0; i < delayBuffer.getNumChannels(); ++i)
+    {
+        SampleType *delay = delayBuffer.getWritePointer(i);
+
+        for (int j = historySamples; j < numSamples; ++j)
+        {
+            delay[(writePosition - 1 - j) & delayMask] = SampleType();
+        }
+    }
+
+    historySamples = numSamples;
+}
+
+//======================================================================================================================
+template class MasterMix<float>;
+template class MasterMix<double>;
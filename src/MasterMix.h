@@ -0,0 +1,87 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MasterMix.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ *  The global dry/wet stage.
+ *  The dry signal is captured before any processing happens and delayed by the processor's reported latency,
+ *  so that it lines up with the wet signal again when both are blended.
+ *  As dry and wet are phase-coherent, the blend uses a linear law which keeps their sum at unity.
+ *
+ *  While the mix sits at exactly 100% wet the stage is inactive and neither copies nor delays anything.
+ *  The delay line keeps being written while active, also without latency, and only as much of it as the latency
+ *  reaches back gets zeroed when the stage wakes up or the latency grows past what was written.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class MasterMix final
+{
+public:
+    static constexpr double SmoothingSeconds  = 0.02;
+    static constexpr double MaxLatencySeconds = 1.0;
+
+    //==================================================================================================================
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+    void reset(float mix) noexcept;
+
+    //==================================================================================================================
+    void setLatency(int latencyInSamples) noexcept;
+    void setMix(float mix) noexcept;
+
+    //==================================================================================================================
+    void pushDrySamples(const juce::AudioBuffer<SampleType>&) noexcept;
+    void mixWetSamples(juce::AudioBuffer<SampleType>&) noexcept;
+
+    /**
+     *  Same as pushing a silent block without touching the delay line, for when it was already fed at least as many
+     *  silent samples in a row as the latency; the dry share of the next mixWetSamples() is then silence.
+     *  Whatever the delay line holds beyond the latency is forgotten, so that a later latency increase zeroes it.
+     */
+    void pushSilentSamples(int numSamples) noexcept;
+
+    //==================================================================================================================
+    int getLatency() const noexcept { return latency; }
+    bool isActive() const noexcept { return active; }
+
+private:
+    juce::AudioBuffer<SampleType> dryBuffer;
+    juce::AudioBuffer<SampleType> delayBuffer;
+    juce::HeapBlock<SampleType> mixRamp;
+    juce::SmoothedValue<float> mixSmoothed;
+    int delayMask      { 0 };
+    int writePosition  { 0 };
+    int historySamples { 0 };
+    int latency        { 0 };
+    int maxLatency     { 0 };
+    bool active        { false };
+
+    //==================================================================================================================
+    bool activate(int numSamples) noexcept;
+    void extendHistory(int numSamples) noexcept;
+};
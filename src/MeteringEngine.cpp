@@ -0,0 +1,289 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MeteringEngine.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "MeteringEngine.h"
+
+namespace
+{
+//======================================================================================================================
+// ITU-R BS.1770-4, Annex 2: the 4x interpolation filter, phases 2 and 3 are phases 1 and 0 reversed
+constexpr float truePeakPhase0[] {
+     0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f, -0.0594482421875f,  0.1373291015625f,
+     0.9721679687500f, -0.1022949218750f,  0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f
+};
+
+constexpr float truePeakPhase1[] {
+    -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f, -0.1665039062500f,  0.4650878906250f,
+     0.7797851562500f, -0.2003173828125f,  0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f
+};
+
+//======================================================================================================================
+float getSum(const float *data, int numSamples) noexcept
+{
+    using Vec = simd::VecF;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    Vec sums = Vec::zero();
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        sums = sums + Vec::load(data + i);
+    }
+
+    float sum = simd::sum(sums);
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        sum += data[i];
+    }
+
+    return sum;
+}
+}
+
+//======================================================================================================================
+void MeteringEngine::prepare(double sampleRate, int numChannels, double rmsWindowSeconds)
+{
+    jassert(sampleRate > 0.0 && numChannels >= 0);
+
+    windowSize     = juce::jmax(1, juce::roundToInt(rmsWindowSeconds * sampleRate));
+    maxHoldSamples = juce::jmax(1, juce::roundToInt(MaxHoldSeconds * sampleRate));
+
+    // The standard only asks for 4x below 96kHz, above that fewer phases suffice
+    truePeakFactor = sampleRate < 96000.0 ? 4 : (sampleRate < 192000.0 ? 2 : 1);
+
+    // Stored tap-major, so one vector holds a tap for all four phases and each input sample yields four outputs
+    phaseCoefficients.allocate(NumTaps * 4);
+
+    for (int tap = 0; tap < NumTaps; ++tap)
+    {
+        float *phases = phaseCoefficients.get() + tap * 4;
+        phases[0] = truePeakPhase0[tap];
+        phases[2] = truePeakPhase1[NumTaps - 1 - tap];
+
+        // At 2x only the phases on the original and the half sample positions are of interest
+        phases[1] = truePeakFactor == 4 ? truePeakPhase1[tap]               : 0.0f;
+        phases[3] = truePeakFactor == 4 ? truePeakPhase0[NumTaps - 1 - tap] : 0.0f;
+    }
+
+    channels.clear();
+    channels.resize(static_cast<std::size_t>(numChannels));
+
+    for (ChannelState &state : channels)
+    {
+        state.squares.allocate(static_cast<std::size_t>(windowSize));
+    }
+
+    scratch.allocate(ScratchSize);
+    reset();
+}
+
+void MeteringEngine::reset() noexcept
+{
+    for (ChannelState &state : channels)
+    {
+        std::fill(state.squares.get(), state.squares.get() + windowSize, 0.0f);
+        state.history.fill(0.0f);
+        state.squareSum       = 0.0;
+        state.squarePosition  = 0;
+        state.historyPosition = 0;
+        state.peak            = 0.0f;
+        state.truePeak        = 0.0f;
+    }
+
+    heldSamples   = 0;
+    silentSamples = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void MeteringEngine::process(const juce::AudioBuffer<SampleType> &buffer, bool isSilent) noexcept
+{
+    const int num_channels = juce::jmin(buffer.getNumChannels(), static_cast<int>(channels.size()));
+    const int num_samples  = buffer.getNumSamples();
+
+    // More zeros wouldn't change anything once the window and the filter history hold nothing else
+    const int flush_samples = windowSize + NumTaps;
+    const bool is_flushed   = isSilent && silentSamples >= flush_samples;
+    silentSamples = isSilent ? juce::jmin(silentSamples + num_samples, flush_samples) : 0;
+
+    if (snapshots.wasPickedUp() || heldSamples >= maxHoldSamples)
+    {
+        for (ChannelState &state : channels)
+        {
+            state.peak     = 0.0f;
+            state.truePeak = 0.0f;
+        }
+
+        heldSamples = 0;
+    }
+
+    for (int i = 0; i < num_channels && !is_flushed; ++i)
+    {
+        ChannelState &state = channels[static_cast<std::size_t>(i)];
+        const SampleType *data = buffer.getReadPointer(i);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            processChannel(state, data, num_samples);
+        }
+        else
+        {
+            // Metering is done in single precision either way, double blocks are converted in slices
+            for (int start = 0; start < num_samples; start += ScratchSize)
+            {
+                const int length = juce::jmin(ScratchSize, num_samples - start);
+                std::transform(data + start, data + start + length, scratch.get(),
+                               [](SampleType sample) { return static_cast<float>(sample); });
+                processChannel(state, scratch.get(), length);
+            }
+        }
+    }
+
+    heldSamples += num_samples;
+
+    MetreSnapshot &snapshot = snapshots.getWriteSnapshot();
+    snapshot.numChannels = juce::jmin(num_channels, MetreSnapshot::MaxChannels);
+
+    for (int i = 0; i < snapshot.numChannels; ++i)
+    {
+        const ChannelState &state = channels[static_cast<std::size_t>(i)];
+        const auto slot = static_cast<std::size_t>(i);
+
+        snapshot.peak[slot]     = state.peak;
+        snapshot.rms[slot]      = static_cast<float>(std::sqrt(juce::jmax(0.0, state.squareSum) / windowSize));
+        snapshot.truePeak[slot] = juce::jmax(state.truePeak, state.peak);
+    }
+
+    snapshots.publish();
+}
+
+//======================================================================================================================
+void MeteringEngine::processChannel(ChannelState &state, const float *data, int numSamples) noexcept
+{
+    state.peak = juce::jmax(state.peak, simd::getMaxAbs(data, numSamples));
+    measureWindow(state, data, numSamples);
+
+    if (truePeakFactor > 1)
+    {
+        state.truePeak = juce::jmax(state.truePeak, measureTruePeak(state, data, numSamples));
+    }
+}
+
+void MeteringEngine::measureWindow(ChannelState &state, const float *data, int numSamples) noexcept
+{
+    using Vec = simd::VecF;
+
+    // Whatever came before the last window worth of samples would be overwritten anyway
+    if (numSamples > windowSize)
+    {
+        data      += numSamples - windowSize;
+        numSamples = windowSize;
+    }
+
+    while (numSamples > 0)
+    {
+        const int length = juce::jmin(numSamples, windowSize - state.squarePosition);
+        float *squares   = state.squares.get() + state.squarePosition;
+
+        constexpr int step = Vec::Size;
+        const int vector_end = length - length % step;
+
+        Vec leaving  = Vec::zero();
+        Vec entering = Vec::zero();
+
+        for (int i = 0; i < vector_end; i += step)
+        {
+            const Vec samples = Vec::load(data + i);
+            const Vec squared = samples * samples;
+
+            leaving  = leaving  + Vec::load(squares + i);
+            entering = entering + squared;
+            squared.store(squares + i);
+        }
+
+        float leaving_sum  = simd::sum(leaving);
+        float entering_sum = simd::sum(entering);
+
+        for (int i = vector_end; i < length; ++i)
+        {
+            leaving_sum  += squares[i];
+            squares[i]    = data[i] * data[i];
+            entering_sum += squares[i];
+        }
+
+        state.squareSum      += static_cast<double>(entering_sum) - static_cast<double>(leaving_sum);
+        state.squarePosition += length;
+        data                 += length;
+        numSamples           -= length;
+
+        if (state.squarePosition == windowSize)
+        {
+            // Once per lap the sum is taken afresh, so rounding errors of the running sum can't pile up
+            state.squarePosition = 0;
+            state.squareSum      = getSum(state.squares.get(), windowSize);
+        }
+    }
+}
+
+float MeteringEngine::measureTruePeak(ChannelState &state, const float *data, int numSamples) noexcept
+{
+    using Vec = simd::VecF;
+
+    const float *coefficients = phaseCoefficients.get();
+    float *history = state.history.data();
+    int position   = state.historyPosition;
+
+    Vec peaks = Vec::zero();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Doubled history, so the newest NumTaps samples are always contiguous with the newest one first
+        position = (position == 0 ? NumTaps : position) - 1;
+        history[position] = history[position + NumTaps] = data[i];
+
+        const float *window = history + position;
+        Vec phases = Vec::zero();
+
+        for (int tap = 0; tap < NumTaps; ++tap)
+        {
+            phases = phases + Vec::broadcast(window[tap]) * Vec::load(coefficients + tap * 4);
+        }
+
+        peaks = max(peaks, abs(phases));
+    }
+
+    state.historyPosition = position;
+
+    float lanes[Vec::Size];
+    peaks.store(lanes);
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+
+//======================================================================================================================
+template void MeteringEngine::process(const juce::AudioBuffer<float>&, bool) noexcept;
+template void MeteringEngine::process(const juce::AudioBuffer<double>&, bool) noexcept;
@@ -0,0 +1,119 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   MeteringEngine.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "SimdOps.h"
+#include "SnapshotExchange.h"
+
+#include <array>
+#include <vector>
+
+/** One set of metre readings, all values are linear gains. */
+struct MetreSnapshot
+{
+    static constexpr int MaxChannels = 16;
+
+    //==================================================================================================================
+    /** The highest sample peak since the editor last picked up a snapshot. */
+    std::array<float, MaxChannels> peak {};
+
+    /** The RMS over the last window, as of the end of the last block. */
+    std::array<float, MaxChannels> rms {};
+
+    /** The highest 4x-oversampled peak since the editor last picked up a snapshot. */
+    std::array<float, MaxChannels> truePeak {};
+
+    int numChannels { 0 };
+};
+
+using MetreSnapshotExchange = SnapshotExchange<MetreSnapshot>;
+
+/**
+ *  Measures the main bus on the audio thread and publishes the readings to the editor.
+ *
+ *  Sample peaks are a plain SIMD reduction. The RMS window is kept in samples, a ring of squared samples with a
+ *  running sum, so it covers the same time no matter how the host slices its blocks.
+ *  True peak follows ITU-R BS.1770-4 Annex 2: the signal is interpolated 4x with the 48 tap polyphase FIR given
+ *  there (2x from 96kHz on, none from 192kHz on) and the largest interpolated magnitude is taken.
+ *
+ *  Peaks are held until the editor picked the snapshot containing them up, so no peak is lost between two repaints.
+ *  Without an editor picking anything up, they are let go after MaxHoldSeconds.
+ */
+class MeteringEngine final
+{
+public:
+    static constexpr double DefaultRmsWindowSeconds = 0.02;
+    static constexpr double MaxHoldSeconds          = 0.5;
+
+    //==================================================================================================================
+    void prepare(double sampleRate, int numChannels, double rmsWindowSeconds = DefaultRmsWindowSeconds);
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /**
+     *  Measures a block and publishes a new snapshot.
+     *  Blocks flagged as silent must be all zeros, once the window and the true peak filter are flushed with them,
+     *  they are only published without going through any of the samples.
+     */
+    template<class SampleType>
+    void process(const juce::AudioBuffer<SampleType>&, bool isSilent = false) noexcept;
+
+    //==================================================================================================================
+    MetreSnapshotExchange& getSnapshots() noexcept { return snapshots; }
+
+private:
+    static constexpr int NumTaps     = 12;
+    static constexpr int ScratchSize = 256;
+
+    struct ChannelState
+    {
+        simd::AlignedBlock<float> squares;
+        std::array<float, NumTaps * 2> history {};
+        double squareSum { 0.0 };
+        int squarePosition  { 0 };
+        int historyPosition { 0 };
+        float peak     { 0.0f };
+        float truePeak { 0.0f };
+    };
+
+    //==================================================================================================================
+    MetreSnapshotExchange snapshots;
+    std::vector<ChannelState> channels;
+    simd::AlignedBlock<float> scratch;
+    simd::AlignedBlock<float> phaseCoefficients;
+    int windowSize     { 1 };
+    int maxHoldSamples { 1 };
+    int heldSamples    { 0 };
+    int silentSamples  { 0 };
+    int truePeakFactor { 4 };
+
+    //==================================================================================================================
+    void processChannel(ChannelState&, const float*, int) noexcept;
+    void measureWindow(ChannelState&, const float*, int) noexcept;
+    float measureTruePeak(ChannelState&, const float*, int) noexcept;
+};
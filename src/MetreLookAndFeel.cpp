@@ -103,19 +103,19 @@ void MetreLookAndFeel::drawMeterBars(juce::Graphics &g, foleys::LevelMeter::Mete
                                      juce::Rectangle<float> bounds, const foleys::LevelMeterSource *source,
                                      int, int selectedChannel)
 {
-    if (source)
+    if (metreSnapshots)
     {
-        const int numChannels        = source->getNumChannels();
-        juce::Rectangle<float> maxes = getMeterMaxNumberBounds(bounds, meterType);
-        float peak                   = 0.0f;
+        const MetreSnapshot &snapshot = metreSnapshots->getReadSnapshot();
+        const int numChannels         = juce::jmin(snapshot.numChannels, MaxDisplayedChannels);
+        juce::Rectangle<float> maxes  = getMeterMaxNumberBounds(bounds, meterType);
+        float peak                    = 0.0f;
 
         if (meterType & foleys::LevelMeter::SingleChannel)
         {
-            const int channel    = selectedChannel < 0 || selectedChannel >= source->getNumChannels() ? 0
-                                   : selectedChannel;
+            const int channel    = selectedChannel < 0 || selectedChannel >= numChannels ? 0 : selectedChannel;
             const auto dest      = getMeterBounds(bounds, meterType, 0, channel);
             const auto innerDest = getMeterBarBounds(dest, meterType);
-            peak                 = source->getMaxLevel(channel);
+            peak                 = snapshot.truePeak[static_cast<std::size_t>(channel)];
             
             lastUpdate.setCurrentChannel(channel);
             drawMeterChannel(g, meterType, innerDest, source, channel);
@@ -126,11 +126,15 @@ void MetreLookAndFeel::drawMeterBars(juce::Graphics &g, foleys::LevelMeter::Mete
             {
                 const auto dest      = getMeterBounds(bounds, meterType, 0, channel);
                 const auto innerDest = getMeterBarBounds(dest, meterType);
-                peak                 = std::fmaxf(source->getMaxLevel(channel), peak);
                 
                 lastUpdate.setCurrentChannel(channel);
                 drawMeterChannel(g, meterType, innerDest, source, channel);
             }
+            
+            for (int channel = 0; channel < snapshot.numChannels; ++channel)
+            {
+                peak = std::fmaxf(snapshot.truePeak[static_cast<std::size_t>(channel)], peak);
+            }
         }
 
         if (!maxes.isEmpty())
@@ -143,6 +147,11 @@ void MetreLookAndFeel::drawMeterBars(juce::Graphics &g, foleys::LevelMeter::Mete
 void MetreLookAndFeel::drawMeterBarsBackground(juce::Graphics &g, foleys::LevelMeter::MeterFlags meterType,
                                                juce::Rectangle<float> bounds, int numChannels, int)
 {
+    if (metreSnapshots)
+    {
+        numChannels = juce::jmin(metreSnapshots->getReadSnapshot().numChannels, MaxDisplayedChannels);
+    }
+    
     if (meterType & foleys::LevelMeter::SingleChannel)
     {
         drawMeterChannelBackground(g, meterType, getMeterBounds(bounds, meterType, 0, 0));
@@ -158,15 +167,17 @@ void MetreLookAndFeel::drawMeterBarsBackground(juce::Graphics &g, foleys::LevelM
 
 
 void MetreLookAndFeel::drawMeterChannel(juce::Graphics &g, foleys::LevelMeter::MeterFlags meterType,
-                                        juce::Rectangle<float> bounds, const foleys::LevelMeterSource *source,
+                                        juce::Rectangle<float> bounds, const foleys::LevelMeterSource*,
                                         int selectedChannel)
 {
-    if (source)
+    if (metreSnapshots)
     {
-        if (!bounds.isEmpty())
+        const MetreSnapshot &snapshot = metreSnapshots->getReadSnapshot();
+        
+        if (!bounds.isEmpty() && juce::isPositiveAndBelow(selectedChannel, snapshot.numChannels))
         {
-            drawMeterBar(g, meterType, bounds, source->getRMSLevel(selectedChannel),
-                         source->getMaxLevel(selectedChannel));
+            const auto channel = static_cast<std::size_t>(selectedChannel);
+            drawMeterBar(g, meterType, bounds, snapshot.rms[channel], snapshot.peak[channel]);
         }
     }
 }
@@ -242,13 +253,22 @@ void MetreLookAndFeel::drawMeterBarBackground(juce::Graphics &g, foleys::LevelMe
 }
 
 void MetreLookAndFeel::drawMaxNumber(juce::Graphics &g, foleys::LevelMeter::MeterFlags,
-                                     juce::Rectangle<float> bounds, float)
+                                     juce::Rectangle<float> bounds, float truePeak)
 {
-    const float maxDb = juce::Decibels::gainToDecibels(lastUpdate.getPeak(), infinity);
+    const juce::uint32 now = juce::Time::getMillisecondCounter();
+    
+    // Hold the highest reading for a while, otherwise the number would flicker with every repaint
+    if (truePeak >= heldTruePeak || now - heldTruePeakTime > TruePeakHoldMs)
+    {
+        heldTruePeak     = truePeak;
+        heldTruePeakTime = now;
+    }
+    
+    const float maxDb = juce::Decibels::gainToDecibels(heldTruePeak, infinity);
     g.setFont(font);
     g.setColour(pluginStyle.findColour(foleys::LevelMeter::lmTextColour));
-    jaut::FontFormat::drawSmallCaps(g, "Peak", bounds, juce::Justification::bottomLeft);
-    g.drawText((maxDb <= infinity ? "-INF" : juce::String(maxDb, 2) + " ") + "dB", bounds,
+    jaut::FontFormat::drawSmallCaps(g, "True Peak", bounds, juce::Justification::bottomLeft);
+    g.drawText((maxDb <= infinity ? "-INF " : juce::String(maxDb, 2) + " ") + "dBTP", bounds,
                juce::Justification::bottomRight);
 }
 
@@ -294,6 +314,12 @@ int MetreLookAndFeel::hitTestMaxNumber(juce::Point<int> position, foleys::LevelM
     return -1;
 }
 
+//======================================================================================================================
+void MetreLookAndFeel::setMetreSnapshots(const MetreSnapshotExchange *snapshots) noexcept
+{
+    metreSnapshots = snapshots;
+}
+
 //======================================================================================================================
 void MetreLookAndFeel::reloadResources() noexcept
 {
@@ -28,6 +28,8 @@
 #include <ff_meters/ff_meters.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "MeteringEngine.h"
+
 class PluginStyle;
 class MetreLookAndFeel : public foleys::LevelMeter::LookAndFeelMethods
 {
@@ -35,6 +37,10 @@ public:
     using MeterFlags       = foleys::LevelMeter::MeterFlags;
     using LevelMeterSource = foleys::LevelMeterSource;
     
+    /** The metre only has room for two bars, any further channels only count towards the peak readout. */
+    static constexpr int MaxDisplayedChannels = 2;
+    static constexpr juce::uint32 TruePeakHoldMs = 1000;
+    
     //==================================================================================================================
     explicit MetreLookAndFeel(PluginStyle&, float = -80.0f, int = 50) noexcept;
     
@@ -67,6 +73,10 @@ public:
     void drawMeterBarBackground(juce::Graphics&, MeterFlags, juce::Rectangle<float>) override;
     void drawMaxNumber(juce::Graphics&, MeterFlags, juce::Rectangle<float>, float) override;
 
+    //==================================================================================================================
+    /** Sets the exchange the metre reads its snapshots from, the metre itself never pulls new ones. */
+    void setMetreSnapshots(const MetreSnapshotExchange*) noexcept;
+    
     //==================================================================================================================
     void reloadResources() noexcept;
 
@@ -135,5 +145,8 @@ private:
     juce::Font font;
     juce::ColourGradient horizontalGradient;
     LastUpdate lastUpdate;
+    const MetreSnapshotExchange *metreSnapshots { nullptr };
+    float heldTruePeak { 0.0f };
+    juce::uint32 heldTruePeakTime { 0 };
 
 };
@@ -0,0 +1,459 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ModulatedDelay.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "ModulatedDelay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+/** The largest feedback, where the echoes still die out. */
+constexpr double maxFeedback = 0.99;
+
+/** The value a sample of 1 is stored as in compact lines, which leaves 12 dB of headroom for the feedback. */
+constexpr double compactScale = 32767.0 / 4.0;
+
+/** The share of the distance to the input a one-pole lowpass covers per sample at the given cutoff. */
+double getOnePoleCoefficient(double cutoff, double sampleRate) noexcept
+{
+    return 1.0 - std::exp(-juce::MathConstants<double>::twoPi * cutoff / sampleRate);
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void ModulatedDelay<SampleType>::prepare(double newSampleRate, int maximumBlockSize, bool compactStorage)
+{
+    sampleRate = newSampleRate;
+    compact    = compactStorage;
+
+    const double samples_per_ms = sampleRate / 1000.0;
+    minimumDelay   = juce::jmax(2.0, MinDelayMs * samples_per_ms);
+    modulationBias = static_cast<int>(std::ceil(MaxModulationDepthMs * samples_per_ms)) + 1;
+
+    // Room for the longest delay, the deepest modulation and the taps on either side of the read position
+    const double longest = (MaxDelayMs + MaxModulationDepthMs) * samples_per_ms + 4.0;
+    const int line_size  = juce::nextPowerOfTwo(static_cast<int>(std::ceil(longest)));
+    lineMask = line_size - 1;
+
+    // Every line starts on a cache line of its own, with the mirrored samples at its end
+    const int storage_size = compact ? static_cast<int>(sizeof(std::int16_t)) : static_cast<int>(sizeof(SampleType));
+    const int line_align   = static_cast<int>(CacheLineSize) / storage_size;
+    lineStride = (line_size + NumGuardSamples + line_align - 1) / line_align * line_align;
+
+    const auto arena_size = static_cast<std::size_t>(lineStride) * MaxChannels;
+
+    if (compact)
+    {
+        compactLines.allocate(arena_size);
+        lines = simd::AlignedBlock<SampleType, CacheLineSize>();
+    }
+    else
+    {
+        lines.allocate(arena_size);
+        compactLines = simd::AlignedBlock<std::int16_t, CacheLineSize>();
+    }
+
+    scratchSize = simd::getAlignedSize<SampleType>(juce::jmax(1, maximumBlockSize));
+    scratch.allocate(static_cast<std::size_t>(NumScratchRows) * static_cast<std::size_t>(scratchSize));
+
+    // The crossfade turns a phasor a quarter of the way round, its cosine fading out and its sine fading in
+    fadeSamples = juce::jmax(1, juce::roundToInt(FadeMs * samples_per_ms));
+    const double fade_angle = juce::MathConstants<double>::halfPi / fadeSamples;
+    fadeRotationCos = static_cast<SampleType>(std::cos(fade_angle));
+    fadeRotationSin = static_cast<SampleType>(std::sin(fade_angle));
+
+    setParameters(currentParameters);
+    reset();
+}
+
+template<class SampleType>
+void ModulatedDelay<SampleType>::release()
+{
+    lines        = simd::AlignedBlock<SampleType, CacheLineSize>();
+    compactLines = simd::AlignedBlock<std::int16_t, CacheLineSize>();
+    scratch      = simd::AlignedBlock<SampleType>();
+    lineMask     = 0;
+    lineStride   = 0;
+    scratchSize  = 0;
+}
+
+template<class SampleType>
+void ModulatedDelay<SampleType>::reset() noexcept
+{
+    if (isPrepared())
+    {
+        const std::size_t arena_size = static_cast<std::size_t>(lineStride) * MaxChannels;
+
+        if (compact)
+        {
+            std::fill(compactLines.get(), compactLines.get() + arena_size, std::int16_t(0));
+        }
+        else
+        {
+            std::fill(lines.get(), lines.get() + arena_size, SampleType(0));
+        }
+    }
+
+    writePosition = 0;
+    heads.fill(targetDelay);
+    activeHead    = 0;
+    fadeRemaining = 0;
+
+    lfoCos          = SampleType(1);
+    lfoSin          = SampleType(0);
+    currentDepth    = targetDepth;
+    currentFeedback = targetFeedback;
+    highCutStates.fill(SampleType(0));
+    lowCutStates .fill(SampleType(0));
+}
+
+//======================================================================================================================
+template<class SampleType>
+void ModulatedDelay<SampleType>::setParameters(const Parameters &parameters) noexcept
+{
+    currentParameters = parameters;
+
+    const double samples_per_ms = sampleRate / 1000.0;
+    targetDelay    = juce::jlimit(MinDelayMs, MaxDelayMs, parameters.timeMs) * samples_per_ms;
+    targetDepth    = static_cast<SampleType>(juce::jlimit(0.0, MaxModulationDepthMs, parameters.modulationDepthMs)
+                                             * samples_per_ms);
+    targetFeedback = static_cast<SampleType>(juce::jlimit(0.0, maxFeedback, parameters.feedback));
+
+    // The rate doesn't ramp, the phasor just keeps turning from wherever it is at the new speed
+    const double lfo_angle = juce::MathConstants<double>::twoPi * juce::jmax(0.0, parameters.modulationRate)
+                             / sampleRate;
+    lfoRotationCos = static_cast<SampleType>(std::cos(lfo_angle));
+    lfoRotationSin = static_cast<SampleType>(std::sin(lfo_angle));
+
+    const double highest_cutoff = sampleRate * 0.45;
+    highCutCoeff = static_cast<SampleType>(getOnePoleCoefficient(juce::jlimit(10.0, highest_cutoff,
+                                                                              parameters.highCutHz), sampleRate));
+    lowCutCoeff  = static_cast<SampleType>(getOnePoleCoefficient(juce::jlimit(1.0, highest_cutoff,
+                                                                              parameters.lowCutHz), sampleRate));
+
+    // Every echo is quieter by the feedback, falling by 120 dB takes that many of them after the first one came out
+    const double longest  = juce::jmax(targetDelay, heads[0], heads[1]) + static_cast<double>(targetDepth);
+    const double feedback = static_cast<double>(targetFeedback);
+    const double repeats  = feedback > 0.0 ? std::ceil(std::log(1.0e-6) / std::log(feedback)) : 0.0;
+    const double tail     = longest * (repeats + 1.0);
+    tailSamples = static_cast<int>(std::min(std::ceil(tail), static_cast<double>(std::numeric_limits<int>::max())));
+}
+
+//======================================================================================================================
+template<class SampleType>
+void ModulatedDelay<SampleType>::process(SampleType *const *channels, int numChannels, int numSamples) noexcept
+{
+    jassert(isPrepared());
+
+    const int num_channels = juce::jmin(numChannels, MaxChannels);
+
+    if (num_channels <= 0 || numSamples <= 0)
+    {
+        return;
+    }
+
+    depthIncrement    = (targetDepth    - currentDepth)    / static_cast<SampleType>(numSamples);
+    feedbackIncrement = (targetFeedback - currentFeedback) / static_cast<SampleType>(numSamples);
+
+    for (int start = 0; start < numSamples;)
+    {
+        // A new time is taken up once the fade to the last one is done
+        if (fadeRemaining == 0 && heads[static_cast<std::size_t>(activeHead)] != targetDelay)
+        {
+            heads[static_cast<std::size_t>(1 - activeHead)] = targetDelay;
+            fadeRemaining = fadeSamples;
+            fadeCos       = SampleType(1);
+            fadeSin       = SampleType(0);
+        }
+
+        const int chunk = juce::jmin(numSamples - start, getChunkLimit());
+
+        if (compact)
+        {
+            processChunk<std::int16_t>(channels, num_channels, start, chunk);
+        }
+        else
+        {
+            processChunk<SampleType>(channels, num_channels, start, chunk);
+        }
+
+        start += chunk;
+    }
+
+    // Landing exactly on the targets, rather than wherever the rounding errors of the increments add up to
+    currentDepth    = targetDepth;
+    currentFeedback = targetFeedback;
+
+    // The phasor drifts off the unit circle by a rounding error per sample, one Newton step per block pulls it back
+    const SampleType scale = SampleType(1.5) - SampleType(0.5) * (lfoCos * lfoCos + lfoSin * lfoSin);
+    lfoCos *= scale;
+    lfoSin *= scale;
+}
+
+//======================================================================================================================
+template<class SampleType>
+template<class StorageType>
+StorageType* ModulatedDelay<SampleType>::getLine(int channel) const noexcept
+{
+    const auto offset = static_cast<std::size_t>(channel) * static_cast<std::size_t>(lineStride);
+
+    if constexpr (std::is_same_v<StorageType, std::int16_t>)
+    {
+        return compactLines.get() + offset;
+    }
+    else
+    {
+        return lines.get() + offset;
+    }
+}
+
+template<class SampleType>
+int ModulatedDelay<SampleType>::getChunkLimit() const noexcept
+{
+    double shortest = heads[static_cast<std::size_t>(activeHead)];
+
+    if (fadeRemaining > 0)
+    {
+        shortest = juce::jmin(shortest, heads[static_cast<std::size_t>(1 - activeHead)]);
+    }
+
+    shortest = juce::jmax(minimumDelay, shortest - static_cast<double>(juce::jmax(currentDepth, targetDepth)));
+
+    // The newest tap of a read lies one sample after its position, it has to be written before the chunk starts
+    int limit = juce::jmin(juce::jmax(1, static_cast<int>(shortest) - 1), scratchSize);
+
+    // Fades end on a chunk boundary, so that the next one can start right there
+    if (fadeRemaining > 0)
+    {
+        limit = juce::jmin(limit, fadeRemaining);
+    }
+
+    return limit;
+}
+
+template<class SampleType>
+template<class StorageType>
+void ModulatedDelay<SampleType>::processChunk(SampleType *const *channels, int numChannels, int start,
+                                              int numSamples) noexcept
+{
+    const bool is_fading   = fadeRemaining > 0;
+    const int  vector_end  = simd::getAlignedSize<SampleType>(numSamples);
+    SampleType *const wet[MaxChannels] { getScratch(WetLeft), getScratch(WetRight) };
+    const SampleType *const modulation[MaxChannels] { getScratch(ModulationLeft), getScratch(ModulationRight) };
+
+    // The modulation and the gains of the crossfade, both phasors that depend on the sample before
+    {
+        SampleType *const modulation_left  = getScratch(ModulationLeft);
+        SampleType *const modulation_right = getScratch(ModulationRight);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const SampleType next_sin = lfoCos * lfoRotationSin + lfoSin * lfoRotationCos;
+            lfoCos        = lfoCos * lfoRotationCos - lfoSin * lfoRotationSin;
+            lfoSin        = next_sin;
+            currentDepth += depthIncrement;
+
+            modulation_left [i] = currentDepth * lfoCos;
+            modulation_right[i] = currentDepth * lfoSin;
+        }
+    }
+
+    if (is_fading)
+    {
+        SampleType *const fade_out = getScratch(FadeOutGains);
+        SampleType *const fade_in  = getScratch(FadeInGains);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            fade_out[i] = fadeCos;
+            fade_in [i] = fadeSin;
+
+            const SampleType next_sin = fadeCos * fadeRotationSin + fadeSin * fadeRotationCos;
+            fadeCos = fadeCos * fadeRotationCos - fadeSin * fadeRotationSin;
+            fadeSin = next_sin;
+        }
+    }
+
+    // The reads, none of which depends on a write of this chunk
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const StorageType *const line = getLine<StorageType>(ch);
+        readTap(line, heads[static_cast<std::size_t>(activeHead)], modulation[ch], wet[ch], numSamples);
+
+        if (is_fading)
+        {
+            SampleType *const fading_in = getScratch(FadingIn);
+            const SampleType *fade_out  = getScratch(FadeOutGains);
+            const SampleType *fade_in   = getScratch(FadeInGains);
+            readTap(line, heads[static_cast<std::size_t>(1 - activeHead)], modulation[ch], fading_in, numSamples);
+
+            for (int i = 0; i < vector_end; i += Vec::Size)
+            {
+                (Vec::load(wet[ch] + i) * Vec::load(fade_out + i) + Vec::load(fading_in + i) * Vec::load(fade_in + i))
+                    .store(wet[ch] + i);
+            }
+        }
+    }
+
+    // Filtering the feedback and writing, sample by sample as the filters depend on the sample before
+    auto write = [this](int channel, SampleType value) noexcept
+    {
+        StorageType *const line = getLine<StorageType>(channel);
+        StorageType stored;
+
+        if constexpr (std::is_same_v<StorageType, std::int16_t>)
+        {
+            const auto scale = static_cast<SampleType>(compactScale);
+            stored = static_cast<std::int16_t>(juce::roundToInt(juce::jlimit(SampleType(-32767), SampleType(32767),
+                                                                             value * scale)));
+        }
+        else
+        {
+            stored = value;
+        }
+
+        line[writePosition] = stored;
+
+        // Mirrored past the end, so that the taps of a read never wrap
+        if (writePosition < NumGuardSamples)
+        {
+            line[lineMask + 1 + writePosition] = stored;
+        }
+    };
+
+    const bool is_ping_pong = currentParameters.pingPong && numChannels == MaxChannels;
+    std::array<SampleType, MaxChannels> inputs {};
+    std::array<SampleType, MaxChannels> feedback {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        currentFeedback += feedbackIncrement;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto channel = static_cast<std::size_t>(ch);
+            SampleType &high_cut = highCutStates[channel];
+            SampleType &low_cut  = lowCutStates [channel];
+
+            high_cut += highCutCoeff * (wet[ch][i] - high_cut);
+            low_cut  += lowCutCoeff  * (high_cut - low_cut);
+
+            feedback[channel]    = (high_cut - low_cut) * currentFeedback;
+            inputs  [channel]    = channels[ch][start + i];
+            channels[ch][start + i] = wet[ch][i];
+        }
+
+        if (is_ping_pong)
+        {
+            // Both inputs go into the left line, from there the echoes cross over to the other side on every repeat
+            write(0, (inputs[0] + inputs[1]) * SampleType(0.5) + feedback[1]);
+            write(1, feedback[0]);
+        }
+        else
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                write(ch, inputs[static_cast<std::size_t>(ch)] + feedback[static_cast<std::size_t>(ch)]);
+            }
+        }
+
+        writePosition = (writePosition + 1) & lineMask;
+    }
+
+    if (is_fading)
+    {
+        fadeRemaining -= numSamples;
+
+        if (fadeRemaining == 0)
+        {
+            activeHead = 1 - activeHead;
+        }
+    }
+}
+
+template<class SampleType>
+template<class StorageType>
+void ModulatedDelay<SampleType>::readTap(const StorageType *line, double delay, const SampleType *modulation,
+                                         SampleType *output, int numSamples) noexcept
+{
+    // Only the whole samples of the delay are kept as an integer, the rest goes along with the modulation; a float
+    // couldn't hold the fraction of a delay several seconds long precisely enough. The bias keeps that rest positive,
+    // so that casting it to an integer rounds it down.
+    const int whole_delay = static_cast<int>(delay) - modulationBias;
+    const auto rest       = static_cast<SampleType>(delay - whole_delay);
+    const auto lowest     = static_cast<SampleType>(minimumDelay - whole_delay);
+
+    SampleType *const fractions = getScratch(Fractions);
+    SampleType *const taps_0    = getScratch(Tap0);
+    SampleType *const taps_1    = getScratch(Tap1);
+    SampleType *const taps_2    = getScratch(Tap2);
+    SampleType *const taps_3    = getScratch(Tap3);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const SampleType offset = juce::jmax(lowest, rest + modulation[i]);
+        const int offset_whole  = static_cast<int>(offset);
+        fractions[i] = offset - static_cast<SampleType>(offset_whole);
+
+        // Oldest first, the samples two, one, zero and minus one samples beyond the whole delay
+        const StorageType *const taps = line + ((writePosition + i - whole_delay - offset_whole - 2) & lineMask);
+        taps_0[i] = static_cast<SampleType>(taps[0]);
+        taps_1[i] = static_cast<SampleType>(taps[1]);
+        taps_2[i] = static_cast<SampleType>(taps[2]);
+        taps_3[i] = static_cast<SampleType>(taps[3]);
+    }
+
+    // Third-order Lagrange weights for the nodes at -1, 0, 1 and 2 samples from the whole delay
+    const auto read_scale = static_cast<SampleType>(std::is_same_v<StorageType, std::int16_t> ? 1.0 / compactScale
+                                                                                              : 1.0);
+    const int vector_end  = simd::getAlignedSize<SampleType>(numSamples);
+    const Vec one         = Vec::broadcast(SampleType(1));
+    const Vec two         = Vec::broadcast(SampleType(2));
+    const Vec sixth       = Vec::broadcast(read_scale / SampleType(6));
+    const Vec half        = Vec::broadcast(read_scale / SampleType(2));
+
+    for (int i = 0; i < vector_end; i += Vec::Size)
+    {
+        const Vec u     = Vec::load(fractions + i);
+        const Vec outer = (u - one) * (u - two);
+        const Vec inner = (u + one) * u;
+
+        const Vec later   = Vec::load(taps_3 + i) * u * outer * sixth;
+        const Vec at      = Vec::load(taps_2 + i) * (u + one) * outer * half;
+        const Vec earlier = Vec::load(taps_1 + i) * inner * (u - two) * half;
+        const Vec oldest  = Vec::load(taps_0 + i) * inner * (u - one) * sixth;
+
+        (at + oldest - later - earlier).store(output + i);
+    }
+}
+
+//======================================================================================================================
+template class ModulatedDelay<float>;
+template class ModulatedDelay<double>;
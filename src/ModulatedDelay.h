@@ -0,0 +1,217 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ModulatedDelay.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include "SimdOps.h"
+
+#include <array>
+#include <cstdint>
+
+/** The settings of a ModulatedDelay, the same for both precisions. */
+struct ModulatedDelayParameters
+{
+    /** The delay time in milliseconds, from ModulatedDelay::MinDelayMs to ModulatedDelay::MaxDelayMs. */
+    double timeMs { 350.0 };
+
+    /** How much of the output is fed back into the lines, from 0 to below 1. */
+    double feedback { 0.4 };
+
+    /** Whether the echoes bounce between the two channels instead of each staying on its own. */
+    bool pingPong { false };
+
+    /** The cutoff in Hz of the highpass the fed back signal goes through. */
+    double lowCutHz { 80.0 };
+
+    /** The cutoff in Hz of the lowpass the fed back signal goes through. */
+    double highCutHz { 12000.0 };
+
+    /** How far the read taps wander in milliseconds, up to ModulatedDelay::MaxModulationDepthMs. */
+    double modulationDepthMs { 0.0 };
+
+    /** How fast the read taps wander in Hz. */
+    double modulationRate { 0.5 };
+};
+
+/**
+ *  A stereo delay with filtered feedback, ping-pong and modulated read taps.
+ *
+ *  Each channel writes into a ring buffer whose size is a power of two, allocated for MaxDelayMs in prepare and
+ *  starting on a cache line, so that positions wrap with a mask. The first samples of every line are mirrored past its
+ *  end, which keeps the four taps of an interpolated read next to each other wherever it wraps.
+ *  Reads are third-order Lagrange interpolated, with the weights and sums computed on SIMD vectors of consecutive
+ *  samples. That works because blocks are processed in chunks no longer than the shortest delay in them, so no read
+ *  ever depends on a write of the same chunk. The two channels read with their modulation a quarter turn apart.
+ *
+ *  A new delay time never moves a tap: a second tap starts at the new time and is crossfaded to with equal power over
+ *  FadeMs, a change arriving during a fade is picked up once it's done. Nothing is reallocated.
+ *
+ *  The lines can be kept as 16-bit integers with 12 dB of headroom instead, for a noise floor around -84 dB. That
+ *  halves their memory for float and quarters it for double, which for the longest delays at high sample rates is the
+ *  difference between a few and a few dozen megabytes.
+ *
+ *  The output is wet only.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class ModulatedDelay final
+{
+public:
+    using Vec = simd::Vec<SampleType>;
+
+    static constexpr int MaxChannels = 2;
+
+    static constexpr double MinDelayMs           = 1.0;
+    static constexpr double MaxDelayMs           = 10000.0;
+    static constexpr double MaxModulationDepthMs = 5.0;
+
+    /** How long the crossfade to a new delay time takes. */
+    static constexpr double FadeMs = 50.0;
+
+    using Parameters = ModulatedDelayParameters;
+
+    //==================================================================================================================
+    /**
+     *  Allocates the lines and scratch space, after that processing and changing parameters is realtime safe.
+     *
+     *  @param sampleRate       The sample rate
+     *  @param maximumBlockSize The largest block process() will see
+     *  @param compactStorage   Whether the lines are kept as 16-bit integers instead of samples
+     */
+    void prepare(double sampleRate, int maximumBlockSize, bool compactStorage);
+    void release();
+    void reset() noexcept;
+
+    //==================================================================================================================
+    /** Sets new parameters; the delay time is crossfaded to, the depth and feedback are ramped over the next block. */
+    void setParameters(const Parameters &parameters) noexcept;
+    const Parameters& getParameters() const noexcept { return currentParameters; }
+
+    /** Gets for how many samples the echoes keep sounding after the input went silent, until they fell by 120 dB. */
+    int getTailSamples() const noexcept { return tailSamples; }
+
+    bool isPrepared() const noexcept { return lineMask != 0; }
+    bool isCompact() const noexcept { return compact; }
+
+    //==================================================================================================================
+    /**
+     *  Replaces a block by its echoes.
+     *
+     *  @param channels    The channels to process in place
+     *  @param numChannels The number of channels, channels from MaxChannels on are passed through untouched
+     *  @param numSamples  The number of samples per channel
+     */
+    void process(SampleType *const *channels, int numChannels, int numSamples) noexcept;
+
+private:
+    /** The rows of the scratch space, each holding a chunk. */
+    enum Scratch
+    {
+        ModulationLeft,
+        ModulationRight,
+        WetLeft,
+        WetRight,
+        FadingIn,
+        Fractions,
+        Tap0,
+        Tap1,
+        Tap2,
+        Tap3,
+        FadeOutGains,
+        FadeInGains,
+        NumScratchRows
+    };
+
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr int NumGuardSamples = 3;
+
+    //==================================================================================================================
+    simd::AlignedBlock<SampleType,   CacheLineSize> lines;
+    simd::AlignedBlock<std::int16_t, CacheLineSize> compactLines;
+    bool compact      { false };
+    int lineStride    { 0 };
+    int lineMask      { 0 };
+    int writePosition { 0 };
+
+    simd::AlignedBlock<SampleType> scratch;
+    int scratchSize { 0 };
+
+    // The taps, one reading at the current time and one at the time being faded to
+    std::array<double, 2> heads {};
+    double targetDelay { 0.0 };
+    int activeHead     { 0 };
+    int fadeRemaining  { 0 };
+    int fadeSamples    { 1 };
+    SampleType fadeCos { 1 };
+    SampleType fadeSin { 0 };
+    SampleType fadeRotationCos { 1 };
+    SampleType fadeRotationSin { 0 };
+
+    // Modulation, a phasor whose cosine moves the left tap and whose sine moves the right one
+    SampleType lfoCos         { 1 };
+    SampleType lfoSin         { 0 };
+    SampleType lfoRotationCos { 1 };
+    SampleType lfoRotationSin { 0 };
+    SampleType currentDepth   { 0 };
+    SampleType targetDepth    { 0 };
+    SampleType depthIncrement { 0 };
+    int modulationBias { 1 };
+
+    // Feedback and its filters, a lowpass and a highpass made of subtracting a second lowpass
+    SampleType currentFeedback   { 0 };
+    SampleType targetFeedback    { 0 };
+    SampleType feedbackIncrement { 0 };
+    SampleType highCutCoeff { 1 };
+    SampleType lowCutCoeff  { 0 };
+    std::array<SampleType, MaxChannels> highCutStates {};
+    std::array<SampleType, MaxChannels> lowCutStates {};
+
+    Parameters currentParameters;
+    double sampleRate   { 44100.0 };
+    double minimumDelay { 0.0 };
+    int tailSamples     { 0 };
+
+    //==================================================================================================================
+    SampleType* getScratch(Scratch row) const noexcept
+    {
+        return scratch.get() + static_cast<std::size_t>(row) * static_cast<std::size_t>(scratchSize);
+    }
+
+    template<class StorageType>
+    StorageType* getLine(int channel) const noexcept;
+
+    int getChunkLimit() const noexcept;
+
+    template<class StorageType>
+    void processChunk(SampleType *const *channels, int numChannels, int start, int numSamples) noexcept;
+
+    template<class StorageType>
+    void readTap(const StorageType *line, double delay, const SampleType *modulation, SampleType *output,
+                 int numSamples) noexcept;
+};
@@ -0,0 +1,764 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ModuleGraph.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "CompensationDelay.h"
+#include "GraphWorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ *  Runs effect module instances as a directed acyclic graph, the "Graph" process mode.
+ *
+ *  Every node takes the sum of the output of its predecessors, or the graph's input if it has none, and runs it
+ *  through its module; a node without a module just passes the sum on. So a node with several successors splits
+ *  the signal, one with several predecessors merges it, and the graph's output is the sum of all nodes without
+ *  successors. Each node's output goes into these sums scaled by the node's gain, changes of which are ramped over
+ *  one block; a node with a gain of 0 is muted and doesn't run its module at all. setChain() builds the graph of a
+ *  ModuleStack this way, so that the same chain sounds the same in both process modes.
+ *
+ *  Independent branches run in parallel on a GraphWorkerPool. Every node sums its inputs in the same fixed order no
+ *  matter which thread gets to run it, so the output is bit-identical to the single-threaded fallback.
+ *  The graph itself may only be changed while the graph isn't processing, that's also where the topological order
+ *  is worked out; a LiveChain swaps in whole new graphs instead.
+ *
+ *  Every node may add latency. Where paths of different latency meet, at a node with several predecessors or at the
+ *  output, the earlier ones are delayed to line up with the latest; the latency of the graph is that of its slowest
+ *  path. These delays are allocated in prepare for the longest latency there may ever be, so latency changes of the
+ *  nodes are picked up by the audio thread with the next block without allocating.
+ *
+ *  Silence is tracked per node like in ModuleStack: a node that only got silence for as long as its tail lasts is
+ *  asleep and neither sums nor processes anything, its successors leave it out of their sum. Once the whole graph is
+ *  asleep on silent input the pool isn't even woken up.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ *  @tparam ModuleType The module type, anything with processEffect(int, juce::AudioBuffer<SampleType>&,
+ *                     juce::MidiBuffer&)
+ */
+template<class SampleType, class ModuleType>
+class ModuleGraph final : private GraphWorkerPool::NodeRunner
+{
+public:
+    /** A node of the graph, the module and the index of the instance of it to run, or no module for a plain sum. */
+    struct Node
+    {
+        ModuleType *module { nullptr };
+        int instance { 0 };
+
+        /** For how many samples the instance keeps sounding once its input went silent. */
+        int tailSamples { 0 };
+
+        /** The latency the instance adds to the signal. */
+        int latencySamples { 0 };
+
+        /** What the output of the node is scaled by where it's summed. */
+        float gain { 1.0f };
+    };
+
+    /** A connection from the output of one node to the input of another, by their indices. */
+    using Edge = std::pair<int, int>;
+
+    //==================================================================================================================
+    /**
+     *  Replaces the graph, this allocates and must not be called while process() might run.
+     *
+     *  @param newNodes The nodes of the graph
+     *  @param newEdges The connections between the nodes
+     *  @return True if the graph was acyclic and got taken over, false if not in which case nothing changed
+     */
+    bool setGraph(const std::vector<Node> &newNodes, const std::vector<Edge> &newEdges)
+    {
+        GraphSchedule new_schedule;
+
+        if (!new_schedule.build(static_cast<int>(newNodes.size()), newEdges))
+        {
+            return false;
+        }
+
+        const auto num_nodes = newNodes.size();
+        nodes      = newNodes;
+        schedule   = std::move(new_schedule);
+        nodeStates = std::make_unique<NodeState[]>(num_nodes);
+        asleep     = false;
+
+        for (std::size_t i = 0; i < num_nodes; ++i)
+        {
+            nodeStates[i].tailSamples   .store(juce::jmax(0, nodes[i].tailSamples),    std::memory_order_relaxed);
+            nodeStates[i].latencySamples.store(juce::jmax(0, nodes[i].latencySamples), std::memory_order_relaxed);
+            nodeStates[i].gain          .store(juce::jmax(0.0f, nodes[i].gain),        std::memory_order_relaxed);
+            nodeStates[i].gainStart = nodeStates[i].gainEnd = juce::jmax(0.0f, nodes[i].gain);
+        }
+
+        // The inputs of each node in ascending order, which fixes the order in which they are summed
+        predecessorStart.assign(num_nodes + 1, 0);
+        predecessors.resize(newEdges.size());
+        sinks.clear();
+
+        for (const auto &[from, to] : newEdges)
+        {
+            juce::ignoreUnused(from);
+            ++predecessorStart[static_cast<std::size_t>(to) + 1];
+        }
+
+        for (std::size_t i = 0; i < num_nodes; ++i)
+        {
+            predecessorStart[i + 1] += predecessorStart[i];
+        }
+
+        std::vector<int> fill_position(predecessorStart.begin(), predecessorStart.end() - 1);
+
+        for (int node = 0; node < static_cast<int>(num_nodes); ++node)
+        {
+            const auto index = static_cast<std::size_t>(node);
+
+            for (int s = schedule.successorStart[index]; s < schedule.successorStart[index + 1]; ++s)
+            {
+                const auto successor = static_cast<std::size_t>(schedule.successors[static_cast<std::size_t>(s)]);
+                predecessors[static_cast<std::size_t>(fill_position[successor]++)] = node;
+            }
+
+            if (schedule.successorStart[index] == schedule.successorStart[index + 1])
+            {
+                sinks.emplace_back(node);
+            }
+        }
+
+        pathLatencies.assign(num_nodes, 0);
+        edgeCompensations.assign(predecessors.size(), 0);
+        sinkCompensations.assign(sinks.size(), 0);
+        edgeDelays = std::vector<CompensationDelay<SampleType>>(predecessors.size());
+        sinkDelays = std::vector<CompensationDelay<SampleType>>(sinks.size());
+
+        if (maximumBlockSize > 0)
+        {
+            allocate();
+        }
+
+        updateCompensation();
+        return true;
+    }
+
+    /**
+     *  Replaces the graph with the equivalent of a ModuleStack running the given slots in series.
+     *  Slot i becomes node 2 * i, which runs the module, and node 2 * i + 1 next to it without a module, which carries
+     *  the dry signal past it; both are fed by the two nodes of the slot before. All slots start out fully wet and not
+     *  bypassed, and setChainMix() blends them like ModuleStack::setMix() and ModuleStack::setBypassed() do.
+     *  This allocates and must not be called while process() might run.
+     *
+     *  @param slots The chain, in the order the slots are processed in; their gain is ignored
+     */
+    void setChain(const std::vector<Node> &slots)
+    {
+        std::vector<Node> chain_nodes;
+        std::vector<Edge> chain_edges;
+        chain_nodes.reserve(slots.size() * 2);
+        chain_edges.reserve(slots.size() * 4);
+
+        for (const Node &slot : slots)
+        {
+            const int node = static_cast<int>(chain_nodes.size());
+
+            chain_nodes.push_back(slot);
+            chain_nodes.back().gain = 1.0f;
+            chain_nodes.emplace_back();
+            chain_nodes.back().gain = 0.0f;
+
+            if (node > 0)
+            {
+                for (const int predecessor : { node - 2, node - 1 })
+                {
+                    chain_edges.emplace_back(predecessor, node);
+                    chain_edges.emplace_back(predecessor, node + 1);
+                }
+            }
+        }
+
+        const bool is_acyclic = setGraph(chain_nodes, chain_edges);
+        jassert(is_acyclic);
+        juce::ignoreUnused(is_acyclic);
+    }
+
+    /**
+     *  Sets the wet proportion and bypass of a slot of a graph built with setChain(), safe to call from any thread.
+     *
+     *  @param slot       The index of the slot
+     *  @param mix        The wet proportion between 0 and 1
+     *  @param isBypassed Whether the slot is bypassed, in which case only the dry signal passes
+     */
+    void setChainMix(int slot, float mix, bool isBypassed) noexcept
+    {
+        const float wet = isBypassed ? 0.0f : juce::jlimit(0.0f, 1.0f, mix);
+        setGain(slot * 2,     wet);
+        setGain(slot * 2 + 1, 1.0f - wet);
+    }
+
+    int getNumNodes() const noexcept { return static_cast<int>(nodes.size()); }
+
+    /** Calls a function with the module and instance of every node that has a module, by node index. */
+    template<class Function>
+    void forEachModule(Function &&function) const
+    {
+        for (const Node &node : nodes)
+        {
+            if (node.module)
+            {
+                function(*node.module, node.instance);
+            }
+        }
+    }
+
+    /** Sets what the output of a node is scaled by, ramped over the next block; safe to call from any thread. */
+    void setGain(int node, float gain) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(node, getNumNodes()));
+        nodeStates[static_cast<std::size_t>(node)].gain.store(juce::jmax(0.0f, gain), std::memory_order_relaxed);
+    }
+
+    /** Updates the tail of a node, whenever that of its instance changed; safe to call from any thread. */
+    void setTailSamples(int node, int tailSamples) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(node, getNumNodes()));
+        nodeStates[static_cast<std::size_t>(node)].tailSamples.store(juce::jmax(0, tailSamples),
+                                                                     std::memory_order_relaxed);
+    }
+
+    /** Updates the latency of a node, whenever that of its instance changed; safe to call from any thread. */
+    void setLatencySamples(int node, int latencySamples) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(node, getNumNodes()));
+        nodeStates[static_cast<std::size_t>(node)].latencySamples.store(juce::jmax(0, latencySamples),
+                                                                        std::memory_order_relaxed);
+        latencyChanged.store(true, std::memory_order_release);
+    }
+
+    /**
+     *  Realigns the paths of the graph if the latency of any node changed since the last call and returns the latency
+     *  of the graph. This is done by process() anyway, it must only be called from the audio thread or while the graph
+     *  isn't processing.
+     */
+    int updateLatency() noexcept
+    {
+        if (latencyChanged.exchange(false, std::memory_order_acquire))
+        {
+            updateCompensation();
+        }
+
+        return latency.load(std::memory_order_relaxed);
+    }
+
+    /** Gets the latency of the graph as of the last block, safe to call from any thread. */
+    int getLatencySamples() const noexcept { return latency.load(std::memory_order_relaxed); }
+
+    /**
+     *  Reads the latency and tail of every node that has a module from its instance again, safe to call from any
+     *  thread. This needs getLatencySamples(int) and getTailSamples(int) from the module type.
+     */
+    void updateFromModules() noexcept
+    {
+        for (int i = 0; i < getNumNodes(); ++i)
+        {
+            const Node &node = nodes[static_cast<std::size_t>(i)];
+
+            if (node.module)
+            {
+                setLatencySamples(i, node.module->getLatencySamples(node.instance));
+                setTailSamples   (i, node.module->getTailSamples(node.instance));
+            }
+        }
+    }
+
+    /**
+     *  Gets the tail of the whole graph, that of the longest path through it; muted nodes add none.
+     *  This allocates and must be called from the thread that changes the graph.
+     */
+    int getTailSamples() const
+    {
+        std::vector<std::int64_t> path_tails(nodes.size(), 0);
+        std::int64_t tail = 0;
+
+        for (const int node : schedule.order)
+        {
+            const auto index = static_cast<std::size_t>(node);
+            std::int64_t longest_input = 0;
+
+            for (int p = predecessorStart[index]; p < predecessorStart[index + 1]; ++p)
+            {
+                longest_input = std::max(longest_input,
+                                         path_tails[static_cast<std::size_t>(predecessors[static_cast<std::size_t>(p)])]);
+            }
+
+            const NodeState &state = nodeStates[index];
+            path_tails[index] = longest_input + (state.gain.load(std::memory_order_relaxed) > 0.0f
+                                                     ? state.tailSamples.load(std::memory_order_relaxed) : 0);
+            tail              = std::max(tail, path_tails[index]);
+        }
+
+        return static_cast<int>(std::min<std::int64_t>(tail, std::numeric_limits<int>::max()));
+    }
+
+    //==================================================================================================================
+    /**
+     *  Sets the graph up for playback and starts the workers.
+     *
+     *  @param newNumChannels      The number of channels to process
+     *  @param newMaximumBlockSize The largest block process() will see
+     *  @param newMaximumLatency   The largest latency any path may ever need to be delayed by
+     *  @param newNumWorkers       The number of threads to run nodes on besides the audio thread, 0 for the
+     *                             single-threaded fallback
+     */
+    void prepare(int newNumChannels, int newMaximumBlockSize, int newMaximumLatency, int newNumWorkers)
+    {
+        maximumChannels  = newNumChannels;
+        maximumBlockSize = newMaximumBlockSize;
+        maximumLatency   = newMaximumLatency;
+        numWorkers       = newNumWorkers;
+
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            nodeStates[i].gainStart = nodeStates[i].gainEnd = nodeStates[i].gain.load(std::memory_order_relaxed);
+        }
+
+        allocate();
+        updateCompensation();
+    }
+
+    /**
+     *  Starts or stops workers so that there are as many as given, this may be called while the graph is processing
+     *  on the audio thread but only from the thread that prepares it. Until the graph is prepared, this only sets how
+     *  many workers prepare() starts.
+     *
+     *  @param newNumWorkers The number of threads to run nodes on besides the audio thread, 0 for the single-threaded
+     *                       fallback
+     */
+    void setNumWorkers(int newNumWorkers)
+    {
+        numWorkers = newNumWorkers;
+
+        if (maximumBlockSize > 0)
+        {
+            pool.setNumWorkers(numWorkers);
+        }
+    }
+
+    /** Stops the workers and frees all buffers, the graph stays as it is. */
+    void release()
+    {
+        pool.release();
+        nodeBuffers.clear();
+        midiBuffers.clear();
+
+        for (CompensationDelay<SampleType> &delay : edgeDelays) { delay.release(); }
+        for (CompensationDelay<SampleType> &delay : sinkDelays) { delay.release(); }
+
+        maximumBlockSize = 0;
+        maximumLatency   = 0;
+    }
+
+    //==================================================================================================================
+    /**
+     *  Runs a block through the graph.
+     *
+     *  @param buffer   The block to process in place
+     *  @param isSilent Whether the block is known to be silent
+     *  @return True if the output is still silent, because every node without successors was asleep; the buffer is
+     *          left as it was then. If they were all muted instead, the buffer is cleared.
+     */
+    bool process(juce::AudioBuffer<SampleType> &buffer, bool isSilent = false) noexcept
+    {
+        if (nodes.empty())
+        {
+            return isSilent;
+        }
+
+        jassert(buffer.getNumSamples() <= maximumBlockSize);
+
+        updateLatency();
+
+        if (isSilent && asleep)
+        {
+            return true;
+        }
+
+        input       = &buffer;
+        inputSilent = isSilent;
+        numSamples  = buffer.getNumSamples();
+        numChannels = juce::jmin(buffer.getNumChannels(), maximumChannels);
+        pool.run(*this);
+
+        asleep = std::all_of(nodeStates.get(), nodeStates.get() + nodes.size(),
+                             [](const NodeState &state) { return state.outputSilent; });
+
+        if (sumOutputs(sinks.data(), static_cast<int>(sinks.size()), sinkDelays.data(), sinkCompensations.data(),
+                       buffer.getArrayOfWritePointers()))
+        {
+            return false;
+        }
+
+        const auto is_asleep = [this](int sink) { return nodeStates[static_cast<std::size_t>(sink)].outputSilent; };
+
+        if (std::all_of(sinks.begin(), sinks.end(), is_asleep))
+        {
+            return true;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            buffer.clear(ch, 0, numSamples);
+        }
+
+        return false;
+    }
+
+private:
+    struct NodeState
+    {
+        std::atomic<int> tailSamples    { 0 };
+        std::atomic<int> latencySamples { 0 };
+        std::atomic<float> gain         { 1.0f };
+
+        // Written by whichever thread runs the node, read by its successors once it's done; the gain the output is
+        // summed with ramps from start to end over the block
+        int silentSamples { 0 };
+        bool outputSilent { false };
+        float gainStart { 1.0f };
+        float gainEnd   { 1.0f };
+
+        // Audio thread only, the longest delay the output of the node goes through on the way to any successor
+        int outgoingCompensation { 0 };
+    };
+
+    //==================================================================================================================
+    std::vector<Node> nodes;
+    std::unique_ptr<NodeState[]> nodeStates;
+    std::vector<int> predecessorStart;
+    std::vector<int> predecessors;
+    std::vector<int> sinks;
+    GraphSchedule schedule;
+    GraphWorkerPool pool;
+
+    std::vector<juce::AudioBuffer<SampleType>> nodeBuffers;
+    std::vector<juce::MidiBuffer> midiBuffers;
+    int maximumChannels  { 0 };
+    int maximumBlockSize { 0 };
+    int maximumLatency   { 0 };
+    int numWorkers       { 0 };
+
+    // Per predecessor entry and per sink, by how much an input is delayed to line up with the slowest one; only
+    // merging inputs ever need that, so only their delays are allocated
+    std::vector<std::int64_t> pathLatencies;
+    std::vector<int> edgeCompensations;
+    std::vector<int> sinkCompensations;
+    std::vector<CompensationDelay<SampleType>> edgeDelays;
+    std::vector<CompensationDelay<SampleType>> sinkDelays;
+    std::atomic<bool> latencyChanged { false };
+    std::atomic<int> latency { 0 };
+
+    // Set by the audio thread for the block at hand, read by whichever thread runs a node
+    const juce::AudioBuffer<SampleType> *input { nullptr };
+    int numSamples   { 0 };
+    int numChannels  { 0 };
+    bool inputSilent { false };
+
+    // Audio thread only, whether every node was asleep after the last block
+    bool asleep { false };
+
+    //==================================================================================================================
+    void allocate()
+    {
+        // The pool must not run nodes on buffers that are being replaced
+        pool.release();
+
+        nodeBuffers.resize(nodes.size());
+        midiBuffers.resize(nodes.size());
+
+        for (juce::AudioBuffer<SampleType> &node_buffer : nodeBuffers)
+        {
+            node_buffer.setSize(maximumChannels, maximumBlockSize, false, true, true);
+        }
+
+        for (std::size_t node = 0; node < nodes.size(); ++node)
+        {
+            const bool is_merging = predecessorStart[node + 1] - predecessorStart[node] > 1;
+
+            for (int p = predecessorStart[node]; p < predecessorStart[node + 1]; ++p)
+            {
+                prepareDelay(edgeDelays[static_cast<std::size_t>(p)], is_merging);
+            }
+        }
+
+        for (CompensationDelay<SampleType> &delay : sinkDelays)
+        {
+            prepareDelay(delay, sinkDelays.size() > 1);
+        }
+
+        pool.prepare(schedule, numWorkers);
+    }
+
+    void prepareDelay(CompensationDelay<SampleType> &delay, bool isNeeded)
+    {
+        if (isNeeded)
+        {
+            delay.prepare(maximumChannels, maximumLatency, maximumBlockSize);
+        }
+        else
+        {
+            delay.release();
+        }
+    }
+
+    // Works out the latency of every path and how much each merging input needs to be delayed by
+    void updateCompensation() noexcept
+    {
+        const auto to_compensation = [this](std::int64_t difference)
+        {
+            jassert(difference <= maximumLatency);
+            return static_cast<int>(std::min<std::int64_t>(difference, maximumLatency));
+        };
+
+        for (const int node : schedule.order)
+        {
+            const auto index = static_cast<std::size_t>(node);
+            const auto first = static_cast<std::size_t>(predecessorStart[index]);
+            const auto last  = static_cast<std::size_t>(predecessorStart[index + 1]);
+            std::int64_t input_latency = 0;
+
+            for (std::size_t p = first; p < last; ++p)
+            {
+                input_latency = std::max(input_latency, pathLatencies[static_cast<std::size_t>(predecessors[p])]);
+            }
+
+            for (std::size_t p = first; p < last; ++p)
+            {
+                edgeCompensations[p] = to_compensation(input_latency
+                                                       - pathLatencies[static_cast<std::size_t>(predecessors[p])]);
+            }
+
+            pathLatencies[index] = input_latency + nodeStates[index].latencySamples.load(std::memory_order_relaxed);
+            nodeStates[index].outgoingCompensation = 0;
+        }
+
+        std::int64_t total = 0;
+
+        for (const int sink : sinks)
+        {
+            total = std::max(total, pathLatencies[static_cast<std::size_t>(sink)]);
+        }
+
+        for (std::size_t i = 0; i < sinks.size(); ++i)
+        {
+            const auto sink      = static_cast<std::size_t>(sinks[i]);
+            sinkCompensations[i] = to_compensation(total - pathLatencies[sink]);
+            sinkDelays[i].setDelay(sinkCompensations[i]);
+            nodeStates[sink].outgoingCompensation = sinkCompensations[i];
+        }
+
+        for (std::size_t p = 0; p < predecessors.size(); ++p)
+        {
+            int &outgoing = nodeStates[static_cast<std::size_t>(predecessors[p])].outgoingCompensation;
+            outgoing = std::max(outgoing, edgeCompensations[p]);
+            edgeDelays[p].setDelay(edgeCompensations[p]);
+        }
+
+        latency.store(static_cast<int>(std::min<std::int64_t>(total, std::numeric_limits<int>::max())),
+                      std::memory_order_relaxed);
+    }
+
+    // Sums the outputs of the nodes that aren't asleep, in the given order and each delayed by its compensation and
+    // scaled by its gain; returns false if none of them added anything, the destination is left as it was then
+    bool sumOutputs(const int *sources, int numSources, CompensationDelay<SampleType> *delays,
+                    const int *compensations, SampleType *const *destination) noexcept
+    {
+        bool is_adding = false;
+
+        for (int i = 0; i < numSources; ++i)
+        {
+            const auto source = static_cast<std::size_t>(sources[i]);
+            const NodeState &state = nodeStates[source];
+
+            if (state.outputSilent)
+            {
+                continue;
+            }
+
+            const SampleType *const *output = nodeBuffers[source].getArrayOfReadPointers();
+            const auto gain_start = static_cast<SampleType>(state.gainStart);
+            const auto gain_end   = static_cast<SampleType>(state.gainEnd);
+            const bool is_muted   = gain_start == SampleType(0) && gain_end == SampleType(0);
+
+            if (compensations[i] > 0)
+            {
+                // Muted outputs still go through their delay, so that it's lined up the moment they're unmuted
+                if (is_adding || is_muted)
+                {
+                    delays[i].processAddingWithRamp(output, destination, numChannels, numSamples, gain_start, gain_end);
+                }
+                else
+                {
+                    delays[i].process(output, destination, numChannels, numSamples);
+                }
+            }
+            else if (!is_muted)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    if (is_adding)
+                    {
+                        addWithRamp(destination[ch], output[ch], gain_start, gain_end);
+                    }
+                    else
+                    {
+                        std::copy_n(output[ch], numSamples, destination[ch]);
+                    }
+                }
+            }
+
+            if (is_muted)
+            {
+                continue;
+            }
+
+            if (!is_adding && (gain_start != SampleType(1) || gain_end != SampleType(1)))
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    applyGainRamp(destination[ch], gain_start, gain_end);
+                }
+            }
+
+            is_adding = true;
+        }
+
+        return is_adding;
+    }
+
+    // The same ramps as juce::AudioBuffer::applyGainRamp and juce::AudioBuffer::addFromWithRamp
+    void applyGainRamp(SampleType *samples, SampleType startGain, SampleType endGain) const noexcept
+    {
+        if (startGain == endGain)
+        {
+            juce::FloatVectorOperations::multiply(samples, startGain, numSamples);
+            return;
+        }
+
+        const SampleType increment = (endGain - startGain) / static_cast<SampleType>(numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            samples[i] *= startGain;
+            startGain  += increment;
+        }
+    }
+
+    void addWithRamp(SampleType *destination, const SampleType *source, SampleType startGain,
+                     SampleType endGain) const noexcept
+    {
+        if (startGain == SampleType(1) && endGain == SampleType(1))
+        {
+            juce::FloatVectorOperations::add(destination, source, numSamples);
+            return;
+        }
+
+        const SampleType increment = (endGain - startGain) / static_cast<SampleType>(numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            destination[i] += source[i] * startGain;
+            startGain      += increment;
+        }
+    }
+
+    void runNode(int node) noexcept override
+    {
+        const auto index = static_cast<std::size_t>(node);
+        juce::AudioBuffer<SampleType> &node_buffer = nodeBuffers[index];
+        NodeState &state = nodeStates[index];
+
+        state.gainStart = state.gainEnd;
+        state.gainEnd   = state.gain.load(std::memory_order_relaxed);
+
+        const int first = predecessorStart[index];
+        const int last  = predecessorStart[index + 1];
+        const auto is_asleep = [this](int predecessor)
+        {
+            return nodeStates[static_cast<std::size_t>(predecessor)].outputSilent;
+        };
+        const bool input_silent = first == last
+                                      ? inputSilent
+                                      : std::all_of(predecessors.begin() + first, predecessors.begin() + last, is_asleep);
+
+        if (input_silent)
+        {
+            // The alignment delays behind the node have to be flushed with silence too before it can sleep
+            const std::int64_t tail = std::int64_t(state.tailSamples.load(std::memory_order_relaxed))
+                                          + state.outgoingCompensation;
+
+            if (state.silentSamples >= tail)
+            {
+                state.outputSilent = true;
+                return;
+            }
+
+            state.silentSamples = static_cast<int>(std::min<std::int64_t>(std::int64_t(state.silentSamples)
+                                                                          + numSamples, tail));
+        }
+        else
+        {
+            state.silentSamples = 0;
+        }
+
+        state.outputSilent = false;
+
+        if (first == last)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                std::copy_n(input->getReadPointer(ch), numSamples, node_buffer.getWritePointer(ch));
+            }
+        }
+        else if (!sumOutputs(predecessors.data() + first, last - first, edgeDelays.data() + first,
+                             edgeCompensations.data() + first, node_buffer.getArrayOfWritePointers()))
+        {
+            node_buffer.clear(0, numSamples);
+        }
+
+        // A muted node still sums its inputs, which keeps the delays in front of it fed, but skips its module
+        const bool is_muted = state.gainStart == 0.0f && state.gainEnd == 0.0f;
+
+        if (ModuleType *const module = nodes[index].module; module && !is_muted)
+        {
+            juce::AudioBuffer<SampleType> block(node_buffer.getArrayOfWritePointers(), numChannels, numSamples);
+            module->processEffect(nodes[index].instance, block, midiBuffers[index]);
+            midiBuffers[index].clear();
+        }
+    }
+};
@@ -0,0 +1,234 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ModuleRegistry.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <variant>
+
+/**
+ *  Everything that can be generated about a fixed set of effect modules at compile time.
+ *
+ *  The modules live inline in Slots, a variant over all module types, instead of behind a pointer each. Calls that
+ *  go through a slot resolve the module type with a switch over the variant index and then call the concrete,
+ *  final type, so the compiler can devirtualise and inline them; that's what the module stack and graph should be
+ *  instantiated with on the audio thread.
+ *  For the message thread there are tables indexed by module type, names and factories, and slots hand out the
+ *  parameter layouts and editors of their modules.
+ *  Slots can't be moved, keep them in one contiguous array, like a std::unique_ptr<Slot[]>, sized up front.
+ *
+ *  Every module type needs a static constexpr ModuleId string that is unique among the modules of the list.
+ *  The order of the list decides the type indices, so new modules go at the end.
+ *
+ *  @tparam ModuleList The module types as a jaut::TypeArray, or any other template over a type pack
+ */
+template<class ModuleList>
+class ModuleRegistry;
+
+template<template<class...> class List, class ...Modules>
+class ModuleRegistry<List<Modules...>> final
+{
+public:
+    static constexpr int NumTypes = static_cast<int>(sizeof...(Modules));
+
+    //==================================================================================================================
+    /** Storage for one module of any of the types, or none. */
+    class Slot final
+    {
+    public:
+        Slot() = default;
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        //==============================================================================================================
+        /** Constructs a module in place, destroying whatever module was in here before. */
+        template<class Module, class ...Args>
+        Module& emplace(Args &&...args)
+        {
+            return module.template emplace<Module>(std::forward<Args>(args)...);
+        }
+
+        /** Destroys the module again. */
+        void clear() noexcept { module.template emplace<std::monostate>(); }
+
+        //==============================================================================================================
+        bool isEmpty() const noexcept { return module.index() == 0; }
+
+        /** The index of the type of the module in the list, or -1 if there is none. */
+        int getTypeIndex() const noexcept { return static_cast<int>(module.index()) - 1; }
+
+        //==============================================================================================================
+        /**
+         *  Calls a function with the module as its concrete type, nothing happens if there is no module.
+         *
+         *  @param function The function, it must take any of the module types
+         */
+        template<class Function>
+        void visit(Function &&function)
+        {
+            std::visit([&function](auto &unit)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(unit)>, std::monostate>)
+                {
+                    function(unit);
+                }
+            }, module);
+        }
+
+        /** Processes a block with an instance of the module, as ModuleStack and ModuleGraph expect it. */
+        template<class SampleType>
+        void processEffect(int index, juce::AudioBuffer<SampleType> &buffer, juce::MidiBuffer &midiBuffer)
+        {
+            visit([index, &buffer, &midiBuffer](auto &unit) { unit.processEffect(index, buffer, midiBuffer); });
+        }
+
+        /** Starts an instance of the module for playback, as the processing core does for the instances it runs. */
+        void beginPlayback(int index, double sampleRate, int maximumBlockSize)
+        {
+            visit([index, sampleRate, maximumBlockSize](auto &unit)
+            {
+                unit.beginPlayback(index, sampleRate, maximumBlockSize);
+            });
+        }
+
+        /** Stops an instance of the module again and lets go of what it allocated for playback. */
+        void finishPlayback(int index)
+        {
+            visit([index](auto &unit) { unit.finishPlayback(index); });
+        }
+
+        /** Gets the latency of an instance of the module in samples, or 0 if there is no module. */
+        int getLatencySamples(int index) const noexcept
+        {
+            int latency = 0;
+            std::visit([index, &latency](const auto &unit)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(unit)>, std::monostate>)
+                {
+                    latency = unit.getLatencySamples(index);
+                }
+            }, module);
+            return latency;
+        }
+
+        /** Gets the tail of an instance of the module in samples, or 0 if there is no module. */
+        int getTailSamples(int index) const noexcept
+        {
+            int tail = 0;
+            std::visit([index, &tail](const auto &unit)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(unit)>, std::monostate>)
+                {
+                    tail = unit.getTailSamples(index);
+                }
+            }, module);
+            return tail;
+        }
+
+        /** Gets the parameter layout of the module, which is empty if there is no module. */
+        auto createParameters() const
+        {
+            decltype(std::declval<const FirstModule&>().createParameters()) parameters;
+            std::visit([&parameters](const auto &unit)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(unit)>, std::monostate>)
+                {
+                    parameters = unit.createParameters();
+                }
+            }, module);
+            return parameters;
+        }
+
+        /** Creates the editor of the module, or returns nullptr if there is no module. */
+        auto* createGui()
+        {
+            using GuiPointer = decltype(std::declval<FirstModule&>().getGuiType());
+            GuiPointer gui = nullptr;
+            visit([&gui](auto &unit) { gui = unit.getGuiType(); });
+            return gui;
+        }
+
+    private:
+        std::variant<std::monostate, Modules...> module;
+    };
+
+    //==================================================================================================================
+    /** The ModuleId of every module type, by type index. */
+    static constexpr std::array<const char*, NumTypes> getModuleIds() noexcept
+    {
+        return { Modules::ModuleId... };
+    }
+
+    /** Finds the type index of a module by its id, -1 if none of the types has it. */
+    static int findModuleType(const char *moduleId) noexcept
+    {
+        constexpr std::array<const char*, NumTypes> ids = getModuleIds();
+
+        for (int i = 0; i < NumTypes; ++i)
+        {
+            if (std::strcmp(ids[static_cast<std::size_t>(i)], moduleId) == 0)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    //==================================================================================================================
+    /**
+     *  Creates a module of the given type in a slot.
+     *  This goes through a table of factories built at compile time, one per type, all taking the same arguments.
+     *
+     *  @param slot      The slot to create the module in
+     *  @param typeIndex The index of the module type
+     *  @param args      The arguments of the module's constructor
+     *  @return True if the type existed and the module was created
+     */
+    template<class ...Args>
+    static bool createModule(Slot &slot, int typeIndex, Args &&...args)
+    {
+        using Factory = void(*)(Slot&, Args&&...);
+        static constexpr std::array<Factory, NumTypes> factories {
+            [](Slot &target, Args &&...arguments) { target.template emplace<Modules>(std::forward<Args>(arguments)...); }...
+        };
+
+        if (!juce::isPositiveAndBelow(typeIndex, NumTypes))
+        {
+            return false;
+        }
+
+        factories[static_cast<std::size_t>(typeIndex)](slot, std::forward<Args>(args)...);
+        return true;
+    }
+
+private:
+    using FirstModule = std::tuple_element_t<0, std::tuple<Modules...>>;
+};
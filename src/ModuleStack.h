@@ -0,0 +1,351 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ModuleStack.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "CompensationDelay.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ *  Runs any number of effect module instances in series over the same buffer, the "Stack" process mode.
+ *
+ *  Every module processes the buffer in place, no intermediate buffers are involved apart from one preallocated dry
+ *  copy for slots that are neither fully wet nor fully bypassed, or that have latency.
+ *  Per block and slot this costs exactly one call into the module, fully bypassed slots without latency cost nothing
+ *  at all. That call is virtual for jaut::SfxUnit, with EffectModuleRegistry::Slot it's a switch over the module types
+ *  instead.
+ *  Changes to bypass and mix are ramped over one block, so that toggling a slot doesn't click.
+ *
+ *  The latency of the chain is that of all slots added up, bypassed ones included. The dry signal of a slot is delayed
+ *  by the slot's latency, which lines it up with the wet signal when mixing, and a bypassed slot keeps delaying by it;
+ *  so bypassing never changes the latency the host has to compensate for.
+ *
+ *  Blocks can be flagged as silent. A module that got nothing but silence for as long as its tail lasts has rung out
+ *  and is put to sleep: it's skipped until the first block that isn't silent, which it processes right away from the
+ *  state it went to sleep in. Since that state rang out, waking up doesn't click.
+ *
+ *  The slots themselves may only be changed while the stack isn't processing, a LiveChain swaps in whole new stacks
+ *  instead.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ *  @tparam ModuleType The module type, anything with processEffect(int, juce::AudioBuffer<SampleType>&,
+ *                     juce::MidiBuffer&)
+ */
+template<class SampleType, class ModuleType>
+class ModuleStack final
+{
+public:
+    /** One link in the chain, a module and the index of the instance of it to run. */
+    struct Slot
+    {
+        ModuleType *module { nullptr };
+        int instance { 0 };
+
+        /** For how many samples the instance keeps sounding once its input went silent. */
+        int tailSamples { 0 };
+
+        /** The latency the instance adds to the signal. */
+        int latencySamples { 0 };
+    };
+
+    //==================================================================================================================
+    /**
+     *  Replaces the chain, the order of the slots is the order they are processed in.
+     *  All slots start out fully wet and not bypassed.
+     *  This allocates and must not be called while process() might run.
+     *
+     *  @param newSlots The new chain
+     */
+    void setSlots(const std::vector<Slot> &newSlots)
+    {
+        numSlots = static_cast<int>(newSlots.size());
+        slots    = std::make_unique<SlotState[]>(newSlots.size());
+
+        for (std::size_t i = 0; i < newSlots.size(); ++i)
+        {
+            jassert(newSlots[i].module != nullptr);
+            slots[i].module   = newSlots[i].module;
+            slots[i].instance = newSlots[i].instance;
+            slots[i].tailSamples.store(newSlots[i].tailSamples, std::memory_order_relaxed);
+            slots[i].latencySamples.store(newSlots[i].latencySamples, std::memory_order_relaxed);
+        }
+    }
+
+    int getNumSlots() const noexcept { return numSlots; }
+
+    /** Calls a function with the module and instance of every slot, in chain order. */
+    template<class Function>
+    void forEachModule(Function &&function) const
+    {
+        for (int i = 0; i < numSlots; ++i)
+        {
+            const SlotState &slot = slots[static_cast<std::size_t>(i)];
+            function(*slot.module, slot.instance);
+        }
+    }
+
+    //==================================================================================================================
+    /**
+     *  Sets the stack up for playback.
+     *
+     *  @param numChannels      The number of channels to process
+     *  @param maximumBlockSize The largest block process() will see
+     *  @param maximumLatency   The largest latency any single slot may ever report, the dry delays are allocated for it
+     */
+    void prepare(int numChannels, int maximumBlockSize, int maximumLatency)
+    {
+        dryBuffer.setSize(numChannels, maximumBlockSize, false, false, true);
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            SlotState &slot = slots[static_cast<std::size_t>(i)];
+            slot.currentMix = slot.bypassed.load(std::memory_order_relaxed)
+                                  ? 0.0f : slot.mix.load(std::memory_order_relaxed);
+            slot.silentSamples = 0;
+            slot.dryDelay.prepare(numChannels, maximumLatency, maximumBlockSize);
+        }
+    }
+
+    /** Frees the dry buffer and delays again, the chain stays as it is. */
+    void release()
+    {
+        dryBuffer.setSize(0, 0);
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            slots[static_cast<std::size_t>(i)].dryDelay.release();
+        }
+    }
+
+    //==================================================================================================================
+    /** Sets whether a slot is bypassed, safe to call from any thread. */
+    void setBypassed(int slot, bool shouldBeBypassed) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(slot, numSlots));
+        slots[static_cast<std::size_t>(slot)].bypassed.store(shouldBeBypassed, std::memory_order_relaxed);
+    }
+
+    /** Sets the wet proportion of a slot between 0 and 1, safe to call from any thread. */
+    void setMix(int slot, float newMix) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(slot, numSlots));
+        slots[static_cast<std::size_t>(slot)].mix.store(juce::jlimit(0.0f, 1.0f, newMix), std::memory_order_relaxed);
+    }
+
+    /** Updates the tail of a slot, whenever that of its instance changed; safe to call from any thread. */
+    void setTailSamples(int slot, int tailSamples) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(slot, numSlots));
+        slots[static_cast<std::size_t>(slot)].tailSamples.store(juce::jmax(0, tailSamples), std::memory_order_relaxed);
+    }
+
+    /**
+     *  Reads the latency and tail of every slot from its instance again, safe to call from any thread.
+     *  This needs getLatencySamples(int) and getTailSamples(int) from the module type.
+     */
+    void updateFromModules() noexcept
+    {
+        for (int i = 0; i < numSlots; ++i)
+        {
+            const SlotState &slot = slots[static_cast<std::size_t>(i)];
+            setLatencySamples(i, slot.module->getLatencySamples(slot.instance));
+            setTailSamples   (i, slot.module->getTailSamples(slot.instance));
+        }
+    }
+
+    /** Updates the latency of a slot, whenever that of its instance changed; safe to call from any thread. */
+    void setLatencySamples(int slot, int latencySamples) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(slot, numSlots));
+        slots[static_cast<std::size_t>(slot)].latencySamples.store(juce::jmax(0, latencySamples),
+                                                                   std::memory_order_relaxed);
+    }
+
+    /** Gets the latency of the whole chain, safe to call from any thread. */
+    int getLatencySamples() const noexcept
+    {
+        std::int64_t latency = 0;
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            latency += slots[static_cast<std::size_t>(i)].latencySamples.load(std::memory_order_relaxed);
+        }
+
+        return static_cast<int>(std::min<std::int64_t>(latency, std::numeric_limits<int>::max()));
+    }
+
+    /** Gets the tail of the whole chain, the tails of all slots that aren't bypassed one after the other. */
+    int getTailSamples() const noexcept
+    {
+        std::int64_t tail = 0;
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            const SlotState &slot = slots[static_cast<std::size_t>(i)];
+
+            if (!slot.bypassed.load(std::memory_order_relaxed))
+            {
+                tail += slot.tailSamples.load(std::memory_order_relaxed);
+            }
+        }
+
+        return static_cast<int>(std::min<std::int64_t>(tail, std::numeric_limits<int>::max()));
+    }
+
+    //==================================================================================================================
+    /**
+     *  Runs a block through the chain.
+     *
+     *  @param buffer   The block to process in place
+     *  @param isSilent Whether the block is known to be silent
+     *  @return True if the output is still silent, because every slot was either bypassed or asleep
+     */
+    bool process(juce::AudioBuffer<SampleType> &buffer, bool isSilent = false) noexcept
+    {
+        const int num_samples  = buffer.getNumSamples();
+        const int num_channels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+        jassert(num_samples <= dryBuffer.getNumSamples());
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            SlotState &slot = slots[static_cast<std::size_t>(i)];
+
+            const float start = slot.currentMix;
+            const float end   = slot.bypassed.load(std::memory_order_relaxed)
+                                    ? 0.0f : slot.mix.load(std::memory_order_relaxed);
+            slot.currentMix   = end;
+
+            slot.dryDelay.setDelay(slot.latencySamples.load(std::memory_order_relaxed));
+            const int latency      = slot.dryDelay.getDelay();
+            const bool is_bypassed = start == 0.0f && end == 0.0f;
+
+            if (is_bypassed && latency == 0)
+            {
+                continue;
+            }
+
+            if (isSilent)
+            {
+                // The dry delay rings for as long as it delays, it sleeps along with the module
+                const int tail = is_bypassed ? latency
+                                             : juce::jmax(latency, slot.tailSamples.load(std::memory_order_relaxed));
+
+                if (slot.silentSamples >= tail)
+                {
+                    continue;
+                }
+
+                slot.silentSamples = static_cast<int>(std::min<std::int64_t>(std::int64_t(slot.silentSamples)
+                                                                             + num_samples, tail));
+            }
+            else
+            {
+                slot.silentSamples = 0;
+            }
+
+            // Whatever is still ringing in here makes the rest of the chain hear something
+            isSilent = false;
+
+            if (latency > 0)
+            {
+                // Always fed, so that the dry signal is there the moment the mix leaves fully wet
+                slot.dryDelay.process(buffer.getArrayOfReadPointers(), dryBuffer.getArrayOfWritePointers(),
+                                      num_channels, num_samples);
+
+                if (is_bypassed)
+                {
+                    for (int ch = 0; ch < num_channels; ++ch)
+                    {
+                        buffer.copyFrom(ch, 0, dryBuffer, ch, 0, num_samples);
+                    }
+
+                    continue;
+                }
+            }
+
+            if (start == 1.0f && end == 1.0f)
+            {
+                slot.module->processEffect(slot.instance, buffer, midiBuffer);
+                midiBuffer.clear();
+                continue;
+            }
+
+            if (latency == 0)
+            {
+                for (int ch = 0; ch < num_channels; ++ch)
+                {
+                    dryBuffer.copyFrom(ch, 0, buffer, ch, 0, num_samples);
+                }
+            }
+
+            slot.module->processEffect(slot.instance, buffer, midiBuffer);
+            midiBuffer.clear();
+
+            const auto wet_start = static_cast<SampleType>(start);
+            const auto wet_end   = static_cast<SampleType>(end);
+
+            for (int ch = 0; ch < num_channels; ++ch)
+            {
+                buffer.applyGainRamp(ch, 0, num_samples, wet_start, wet_end);
+                buffer.addFromWithRamp(ch, 0, dryBuffer.getReadPointer(ch), num_samples,
+                                       SampleType(1) - wet_start, SampleType(1) - wet_end);
+            }
+        }
+
+        return isSilent;
+    }
+
+private:
+    struct SlotState
+    {
+        ModuleType *module { nullptr };
+        int instance { 0 };
+
+        std::atomic<float> mix            { 1.0f };
+        std::atomic<bool>  bypassed       { false };
+        std::atomic<int>   tailSamples    { 0 };
+        std::atomic<int>   latencySamples { 0 };
+
+        // Audio thread only, the mix the last block ended on and how much silence the module got since it last heard
+        // anything
+        float currentMix  { 1.0f };
+        int silentSamples { 0 };
+        CompensationDelay<SampleType> dryDelay;
+    };
+
+    //==================================================================================================================
+    std::unique_ptr<SlotState[]> slots;
+    int numSlots { 0 };
+
+    juce::AudioBuffer<SampleType> dryBuffer;
+    juce::MidiBuffer midiBuffer;
+};
@@ -0,0 +1,494 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   Oversampler.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "Oversampler.h"
+#include "SimdOps.h"
+
+namespace
+{
+//======================================================================================================================
+struct StageSpec
+{
+    double transition;  // full width of the transition band, relative to the stage's output rate
+    double attenuation; // stopband attenuation in dB
+};
+
+// Only the first stage sees content up to the base Nyquist, the later ones can use much wider transition bands
+constexpr StageSpec StageSpecs[] {
+    { 0.05, 90.0 },
+    { 0.20, 80.0 },
+    { 0.30, 80.0 }
+};
+
+//======================================================================================================================
+double besselI0(double x) noexcept
+{
+    const double half_x = x * 0.5;
+    double term = 1.0;
+    double sum  = 1.0;
+
+    for (int k = 1; term > sum * 1e-12; ++k)
+    {
+        term *= (half_x / k) * (half_x / k);
+        sum  += term;
+    }
+
+    return sum;
+}
+
+// Designs the odd phase of a Kaiser-windowed half-band, returns taps h[-M], h[-M + 2], ..., h[M] with M odd
+std::vector<double> designHalfBandFir(const StageSpec &spec)
+{
+    const double delta_omega = juce::MathConstants<double>::twoPi * spec.transition;
+    const int    order       = static_cast<int>(std::ceil((spec.attenuation - 7.95) / (2.285 * delta_omega)));
+    const int    half_order  = (order / 2) | 1;
+    const double beta        = 0.1102 * (spec.attenuation - 8.7);
+    const double window_norm = besselI0(beta);
+
+    std::vector<double> taps;
+    double sum = 0.0;
+
+    for (int k = -half_order; k <= half_order; k += 2)
+    {
+        const double ratio  = static_cast<double>(k) / half_order;
+        const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - ratio * ratio))) / window_norm;
+        const double sinc   = std::sin(juce::MathConstants<double>::halfPi * k) / (juce::MathConstants<double>::pi * k);
+        taps.emplace_back(sinc * window);
+        sum += taps.back();
+    }
+
+    // The odd phase has to sum up to exactly one half for unity gain at DC
+    for (double &tap : taps)
+    {
+        tap *= 0.5 / sum;
+    }
+
+    return taps;
+}
+
+// Designs the allpass coefficients of a polyphase IIR half-band, after the elliptic design used by HIIR
+std::vector<double> designHalfBandIir(const StageSpec &spec)
+{
+    constexpr double pi = juce::MathConstants<double>::pi;
+
+    double k = std::tan((1.0 - spec.transition * 2.0) * pi / 4.0);
+    k *= k;
+
+    const double kk_root = std::pow(1.0 - k * k, 0.25);
+    const double e       = 0.5 * (1.0 - kk_root) / (1.0 + kk_root);
+    const double e4      = e * e * e * e;
+    const double q       = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    const double attenuation = std::pow(10.0, -spec.attenuation / 10.0);
+    const double a           = attenuation / (1.0 - attenuation);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    order = juce::jmax(3, order | 1);
+
+    std::vector<double> coefficients;
+
+    for (int index = 0; index < (order - 1) / 2; ++index)
+    {
+        const int c = index + 1;
+        double numerator   = 0.0;
+        double denominator = 0.0;
+
+        for (int i = 0, sign = 1;; ++i, sign = -sign)
+        {
+            const double term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * pi / order) * sign;
+            numerator += term;
+
+            if (std::abs(term) < 1e-100)
+            {
+                break;
+            }
+        }
+
+        for (int i = 1, sign = -1;; ++i, sign = -sign)
+        {
+            const double term = std::pow(q, i * i) * std::cos(i * 2 * c * pi / order) * sign;
+            denominator += term;
+
+            if (std::abs(term) < 1e-100)
+            {
+                break;
+            }
+        }
+
+        const double ww      = numerator * std::pow(q, 0.25) / (denominator + 0.5);
+        const double ww_sq   = ww * ww;
+        const double x       = std::sqrt((1.0 - ww_sq * k) * (1.0 - ww_sq / k)) / (1.0 + ww_sq);
+        coefficients.emplace_back((1.0 - x) / (1.0 + x));
+    }
+
+    return coefficients;
+}
+
+//======================================================================================================================
+template<class SampleType>
+SampleType dotProduct(const SampleType *a, const SampleType *b, int numElements) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    // Always a multiple of the vector size, the FIR stages pad their kernels accordingly
+    jassert(numElements % Vec::Size == 0);
+
+    Vec accumulator = Vec::zero();
+
+    for (int i = 0; i < numElements; i += Vec::Size)
+    {
+        accumulator = accumulator + Vec::load(a + i) * Vec::load(b + i);
+    }
+
+    return simd::sum(accumulator);
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+class Oversampler<SampleType>::Stage
+{
+public:
+    virtual ~Stage() = default;
+
+    //==================================================================================================================
+    virtual void prepare(int numChannels) = 0;
+    virtual void reset() noexcept = 0;
+
+    //==================================================================================================================
+    // Reads numSamples and writes twice as many
+    virtual void processUp(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept = 0;
+
+    // Reads twice as many samples as it writes
+    virtual void processDown(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept = 0;
+};
+
+/**
+ *  The linear phase half-band.
+ *  Every other tap of a half-band is zero except for the centre one, so each output phase is either a plain delay
+ *  or a symmetric FIR over the odd taps only. The histories are stored twice in a row so that the kernel can always
+ *  run over a contiguous window with vector loads.
+ */
+template<class SampleType>
+class Oversampler<SampleType>::FirStage final : public Oversampler<SampleType>::Stage
+{
+public:
+    explicit FirStage(const StageSpec &spec)
+    {
+        const std::vector<double> taps = ::designHalfBandFir(spec);
+
+        halfOrder  = static_cast<int>(taps.size()) - 1;
+        kernelSize = simd::getAlignedSize<SampleType>(static_cast<int>(taps.size()));
+
+        // The padding sits at the oldest end of the window where its zeros don't matter
+        kernel.allocate(static_cast<std::size_t>(kernelSize));
+        std::copy(taps.begin(), taps.end(), kernel.get() + kernelSize - static_cast<int>(taps.size()));
+    }
+
+    //==================================================================================================================
+    void prepare(int numChannels) override
+    {
+        const auto history_size = static_cast<std::size_t>(numChannels * kernelSize * 2);
+        upHistory       .allocate(history_size);
+        downEvenHistory .allocate(history_size);
+        downOddHistory  .allocate(history_size);
+        positions.assign(static_cast<std::size_t>(numChannels) * 2, 0);
+    }
+
+    void reset() noexcept override
+    {
+        const std::size_t history_size = positions.size() * static_cast<std::size_t>(kernelSize);
+        std::fill(upHistory      .get(), upHistory      .get() + history_size, SampleType());
+        std::fill(downEvenHistory.get(), downEvenHistory.get() + history_size, SampleType());
+        std::fill(downOddHistory .get(), downOddHistory .get() + history_size, SampleType());
+        std::fill(positions.begin(), positions.end(), 0);
+    }
+
+    //==================================================================================================================
+    void processUp(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept override
+    {
+        SampleType *history = upHistory.get() + channel * kernelSize * 2;
+        int &position       = positions[static_cast<std::size_t>(channel) * 2];
+        const int delay_tap = kernelSize - 1 - (halfOrder - 1) / 2;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[position] = history[position + kernelSize] = input[i];
+            const SampleType *window = history + position + 1;
+
+            // The zero-stuffed input has only every other sample set, hence the gain of two on both phases
+            output[i * 2]     = SampleType(2) * ::dotProduct(kernel.get(), window, kernelSize);
+            output[i * 2 + 1] = window[delay_tap];
+
+            position = position + 1 == kernelSize ? 0 : position + 1;
+        }
+    }
+
+    void processDown(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept override
+    {
+        SampleType *even_history = downEvenHistory.get() + channel * kernelSize * 2;
+        SampleType *odd_history  = downOddHistory .get() + channel * kernelSize * 2;
+        int &position            = positions[static_cast<std::size_t>(channel) * 2 + 1];
+        const int delay_tap      = kernelSize - 1 - (halfOrder + 1) / 2;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            even_history[position] = even_history[position + kernelSize] = input[i * 2];
+            odd_history [position] = odd_history [position + kernelSize] = input[i * 2 + 1];
+
+            output[i] = ::dotProduct(kernel.get(), even_history + position + 1, kernelSize)
+                        + SampleType(0.5) * odd_history[position + 1 + delay_tap];
+
+            position = position + 1 == kernelSize ? 0 : position + 1;
+        }
+    }
+
+private:
+    simd::AlignedBlock<SampleType> kernel;
+    simd::AlignedBlock<SampleType> upHistory;
+    simd::AlignedBlock<SampleType> downEvenHistory;
+    simd::AlignedBlock<SampleType> downOddHistory;
+    std::vector<int> positions;
+    int halfOrder  { 0 };
+    int kernelSize { 0 };
+};
+
+/**
+ *  The minimum phase half-band, two parallel chains of first order allpass sections running at the lower rate.
+ *  Each section's input memory doubles as the output memory of the section two places before it, so a chain of
+ *  n coefficients needs only n + 2 memories per channel.
+ */
+template<class SampleType>
+class Oversampler<SampleType>::IirStage final : public Oversampler<SampleType>::Stage
+{
+public:
+    explicit IirStage(const StageSpec &spec)
+    {
+        for (const double coefficient : ::designHalfBandIir(spec))
+        {
+            coefficients.emplace_back(static_cast<SampleType>(coefficient));
+        }
+    }
+
+    //==================================================================================================================
+    void prepare(int numChannels) override
+    {
+        upMemory  .assign(static_cast<std::size_t>(numChannels) * (coefficients.size() + 2), SampleType());
+        downMemory.assign(upMemory.size(), SampleType());
+    }
+
+    void reset() noexcept override
+    {
+        std::fill(upMemory  .begin(), upMemory  .end(), SampleType());
+        std::fill(downMemory.begin(), downMemory.end(), SampleType());
+    }
+
+    //==================================================================================================================
+    void processUp(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept override
+    {
+        SampleType *memory = upMemory.data() + static_cast<std::size_t>(channel) * (coefficients.size() + 2);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            SampleType even = input[i];
+            SampleType odd  = input[i];
+            processChains(memory, even, odd);
+            output[i * 2]     = even;
+            output[i * 2 + 1] = odd;
+        }
+    }
+
+    void processDown(const SampleType *input, SampleType *output, int channel, int numSamples) noexcept override
+    {
+        SampleType *memory = downMemory.data() + static_cast<std::size_t>(channel) * (coefficients.size() + 2);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            SampleType even = input[i * 2 + 1];
+            SampleType odd  = input[i * 2];
+            processChains(memory, even, odd);
+            output[i] = SampleType(0.5) * (even + odd);
+        }
+    }
+
+private:
+    std::vector<SampleType> coefficients;
+    std::vector<SampleType> upMemory;
+    std::vector<SampleType> downMemory;
+
+    //==================================================================================================================
+    void processChains(SampleType *memory, SampleType &first, SampleType &second) const noexcept
+    {
+        const int num_coefficients = static_cast<int>(coefficients.size());
+
+        for (int i = 0; i < num_coefficients; ++i)
+        {
+            SampleType &sample      = (i & 1) ? second : first;
+            const SampleType result = (sample - memory[i + 2]) * coefficients[static_cast<std::size_t>(i)]
+                                      + memory[i];
+            memory[i] = sample;
+            sample    = result;
+        }
+
+        memory[num_coefficients]     = (num_coefficients & 1) ? second : first;
+        memory[num_coefficients + 1] = (num_coefficients & 1) ? first  : second;
+    }
+};
+
+//======================================================================================================================
+template<class SampleType>
+Oversampler<SampleType>::Oversampler(int newNumChannels, int factorLog2, OversamplingFilter newFilterType)
+    : filterType(newFilterType), numChannels(newNumChannels)
+{
+    jassert(factorLog2 > 0 && factorLog2 <= MaxFactorLog2);
+
+    for (int i = 0; i < juce::jlimit(1, MaxFactorLog2, factorLog2); ++i)
+    {
+        if (filterType == OversamplingFilter::LinearPhase)
+        {
+            stages.emplace_back(std::make_unique<FirStage>(StageSpecs[i]));
+        }
+        else
+        {
+            stages.emplace_back(std::make_unique<IirStage>(StageSpecs[i]));
+        }
+    }
+}
+
+template<class SampleType>
+Oversampler<SampleType>::~Oversampler() = default;
+
+//======================================================================================================================
+template<class SampleType>
+void Oversampler<SampleType>::prepare(int maximumBlockSize)
+{
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+    stageBuffers.resize(stages.size());
+
+    for (std::size_t i = 0; i < stages.size(); ++i)
+    {
+        stages[i]->prepare(numChannels);
+        stageBuffers[i].setSize(numChannels, maxBlockSize << (i + 1));
+    }
+
+    measureLatency();
+    reset();
+}
+
+template<class SampleType>
+void Oversampler<SampleType>::reset() noexcept
+{
+    for (auto &stage : stages)
+    {
+        stage->reset();
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+juce::AudioBuffer<SampleType>& Oversampler<SampleType>::processUp(const juce::AudioBuffer<SampleType> &input) noexcept
+{
+    const int num_samples  = input.getNumSamples();
+    const int num_channels = juce::jmin(numChannels, input.getNumChannels());
+
+    jassert(num_samples <= maxBlockSize);
+
+    for (std::size_t i = 0; i < stages.size(); ++i)
+    {
+        const juce::AudioBuffer<SampleType> &source = i == 0 ? input : stageBuffers[i - 1];
+
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            stages[i]->processUp(source.getReadPointer(channel), stageBuffers[i].getWritePointer(channel), channel,
+                                 num_samples << i);
+        }
+    }
+
+    oversampledBlock.setDataToReferTo(stageBuffers.back().getArrayOfWritePointers(), num_channels,
+                                      num_samples * getFactor());
+    return oversampledBlock;
+}
+
+template<class SampleType>
+void Oversampler<SampleType>::processDown(juce::AudioBuffer<SampleType> &output) noexcept
+{
+    const int num_samples  = output.getNumSamples();
+    const int num_channels = juce::jmin(numChannels, output.getNumChannels());
+
+    jassert(num_samples <= maxBlockSize);
+
+    for (std::size_t i = stages.size(); i-- > 0;)
+    {
+        juce::AudioBuffer<SampleType> &destination = i == 0 ? output : stageBuffers[i - 1];
+
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            stages[i]->processDown(stageBuffers[i].getReadPointer(channel), destination.getWritePointer(channel),
+                                   channel, num_samples << i);
+        }
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void Oversampler<SampleType>::measureLatency()
+{
+    // The centroid of the impulse response is the group delay at DC; exact for the linear phase stages and the
+    // closest thing to a single latency figure the minimum phase ones have
+    constexpr int probe_length = 4096;
+
+    juce::AudioBuffer<SampleType> probe(numChannels, maxBlockSize);
+    double weighted_sum = 0.0;
+    double sum          = 0.0;
+
+    reset();
+
+    for (int position = 0; position < probe_length; position += maxBlockSize)
+    {
+        const int block_size = juce::jmin(maxBlockSize, probe_length - position);
+        juce::AudioBuffer<SampleType> block(probe.getArrayOfWritePointers(), numChannels, block_size);
+        block.clear();
+
+        if (position == 0)
+        {
+            block.setSample(0, 0, SampleType(1));
+        }
+
+        processUp(block);
+        processDown(block);
+
+        for (int i = 0; i < block_size; ++i)
+        {
+            const double sample = static_cast<double>(block.getSample(0, i));
+            weighted_sum += sample * (position + i);
+            sum          += sample;
+        }
+    }
+
+    latency = sum != 0.0 ? juce::roundToInt(weighted_sum / sum) : 0;
+}
+
+//======================================================================================================================
+template class Oversampler<float>;
+template class Oversampler<double>;
@@ -0,0 +1,92 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   Oversampler.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <memory>
+#include <vector>
+
+/** The filter family an oversampler uses for its half-band stages. */
+enum class OversamplingFilter
+{
+    /** Polyphase allpass IIR half-bands, a few samples of latency at the cost of a non-linear phase. */
+    MinimumPhase,
+
+    /** Polyphase FIR half-bands, linear phase at the cost of a few dozen samples of latency. */
+    LinearPhase
+};
+
+/**
+ *  Up- and downsamples a block by 2x, 4x or 8x through a cascade of half-band stages.
+ *  The first stage carries the steep filter, the later ones only need to reject the images of an already
+ *  band-limited signal and are therefore much cheaper.
+ *
+ *  All memory is allocated in prepare, processing is realtime safe.
+ *  The returned oversampled block refers to internal storage and is only valid until the next call to processUp.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class Oversampler final
+{
+public:
+    static constexpr int MaxFactorLog2 = 3;
+
+    //==================================================================================================================
+    Oversampler(int numChannels, int factorLog2, OversamplingFilter filterType);
+    ~Oversampler();
+
+    //==================================================================================================================
+    void prepare(int maximumBlockSize);
+    void reset() noexcept;
+
+    //==================================================================================================================
+    juce::AudioBuffer<SampleType>& processUp(const juce::AudioBuffer<SampleType>&) noexcept;
+    void processDown(juce::AudioBuffer<SampleType>&) noexcept;
+
+    //==================================================================================================================
+    int getFactor() const noexcept { return 1 << static_cast<int>(stages.size()); }
+    int getLatencySamples() const noexcept { return latency; }
+    OversamplingFilter getFilterType() const noexcept { return filterType; }
+
+private:
+    class Stage;
+    class FirStage;
+    class IirStage;
+
+    //==================================================================================================================
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<juce::AudioBuffer<SampleType>> stageBuffers;
+    juce::AudioBuffer<SampleType> oversampledBlock;
+    OversamplingFilter filterType;
+    int numChannels;
+    int maxBlockSize { 0 };
+    int latency      { 0 };
+
+    //==================================================================================================================
+    void measureLatency();
+};
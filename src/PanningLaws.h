@@ -0,0 +1,214 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   PanningLaws.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+namespace panlaw
+{
+/**
+ *  The available panning laws, in the same order as res::List_PanningModes.
+ *  The first three are compensated to unity at the centre and boost towards the sides, the latter three are the
+ *  classic attenuating laws named after their centre attenuation.
+ */
+enum Law
+{
+    Linear,
+    Square,
+    Sinusoidal,
+    ConstantPower,
+    Compromise,
+    LinearAttenuated,
+    NumLaws
+};
+
+/** The number of segments each lookup table is divided into. */
+inline constexpr int TableResolution = 1024;
+
+namespace detail
+{
+//======================================================================================================================
+inline constexpr double Pi    = 3.14159265358979323846;
+inline constexpr double Sqrt2 = 1.41421356237309504880;
+
+// Taylor series, only ever evaluated for [0, pi/2] where 12 terms are far beyond float precision
+constexpr double sin(double x) noexcept
+{
+    double term   = x;
+    double result = x;
+
+    for (int i = 1; i < 12; ++i)
+    {
+        term   *= -x * x / static_cast<double>((2 * i) * (2 * i + 1));
+        result += term;
+    }
+
+    return result;
+}
+
+// Newton-Raphson, converges quadratically for the [0, 1] range we need
+constexpr double sqrt(double x) noexcept
+{
+    if (x <= 0.0)
+    {
+        return 0.0;
+    }
+
+    double result = x < 1.0 ? 1.0 : x;
+
+    for (int i = 0; i < 32; ++i)
+    {
+        result = 0.5 * (result + x / result);
+    }
+
+    return result;
+}
+}
+
+//======================================================================================================================
+/**
+ *  Evaluates a panning law in closed form.
+ *
+ *  @param law      The panning law
+ *  @param position The normalised position of the channel's speaker relative to the source, 0 being fully opposite
+ *                  and 1 being fully on the channel's side
+ *  @return The gain for the channel
+ */
+constexpr double evaluate(int law, double position) noexcept
+{
+    const double sine = detail::sin(position * detail::Pi / 2.0);
+
+    switch (law)
+    {
+        case Linear:           return position * 2.0;
+        case Square:           return detail::sqrt(position) * detail::Sqrt2;
+        case Sinusoidal:       return sine * detail::Sqrt2;
+        case ConstantPower:    return sine;
+        case Compromise:       return detail::sqrt(position * sine);
+        case LinearAttenuated: return position;
+        default:               return 0.0;
+    }
+}
+
+namespace detail
+{
+//======================================================================================================================
+// One extra guard entry at the end so that interpolating at position 1 never needs a branch
+using Table = std::array<float, TableResolution + 2>;
+
+constexpr std::array<Table, NumLaws> createTables() noexcept
+{
+    std::array<Table, NumLaws> tables {};
+
+    for (int law = 0; law < NumLaws; ++law)
+    {
+        Table &table = tables[static_cast<std::size_t>(law)];
+
+        for (int i = 0; i <= TableResolution; ++i)
+        {
+            const double position = static_cast<double>(i) / TableResolution;
+            table[static_cast<std::size_t>(i)] = static_cast<float>(evaluate(law, position));
+        }
+
+        table[TableResolution + 1] = table[TableResolution];
+    }
+
+    return tables;
+}
+
+inline constexpr std::array<Table, NumLaws> Tables = createTables();
+
+constexpr bool matches(double value, double expected) noexcept
+{
+    return (value > expected ? value - expected : expected - value) < 1e-6;
+}
+
+// Closed-form reference values at the centre and at the sides
+static_assert(matches(Tables[Linear]          [TableResolution / 2], 1.0));
+static_assert(matches(Tables[Square]          [TableResolution / 2], 1.0));
+static_assert(matches(Tables[Sinusoidal]      [TableResolution / 2], 1.0));
+static_assert(matches(Tables[ConstantPower]   [TableResolution / 2], 0.70710678118654752));
+static_assert(matches(Tables[Compromise]      [TableResolution / 2], 0.59460355750136053));
+static_assert(matches(Tables[LinearAttenuated][TableResolution / 2], 0.5));
+static_assert(matches(Tables[Linear]          [TableResolution],     2.0));
+static_assert(matches(Tables[Square]          [TableResolution],     1.41421356237309504));
+static_assert(matches(Tables[Sinusoidal]      [TableResolution],     1.41421356237309504));
+static_assert(matches(Tables[ConstantPower]   [TableResolution],     1.0));
+static_assert(matches(Tables[Compromise]      [TableResolution],     1.0));
+static_assert(matches(Tables[LinearAttenuated][TableResolution],     1.0));
+static_assert(matches(Tables[ConstantPower]   [0],                   0.0));
+static_assert(matches(Tables[ConstantPower]   [TableResolution / 3], 0.49955711254508184));
+}
+
+//======================================================================================================================
+/**
+ *  Gets the gain of a channel for the given panning, linearly interpolated from the compile-time generated tables.
+ *
+ *  @param law     The panning law
+ *  @param side    The lateral side of the channel's speaker, -1 for left and 1 for right; speakers in between
+ *                 only follow the panning partially
+ *  @param panning The panning from -1 (left) to 1 (right)
+ *  @return The gain for the channel
+ */
+constexpr float getGain(int law, float side, float panning) noexcept
+{
+    const detail::Table &table = detail::Tables[static_cast<std::size_t>(law)];
+    const float position       = std::clamp((panning * side + 1.0f) * 0.5f, 0.0f, 1.0f)
+                                     * static_cast<float>(TableResolution);
+    const int   index          = static_cast<int>(position);
+    const float fraction       = position - static_cast<float>(index);
+    const float start          = table[static_cast<std::size_t>(index)];
+
+    return start + (table[static_cast<std::size_t>(index) + 1] - start) * fraction;
+}
+
+namespace detail
+{
+//======================================================================================================================
+constexpr double getPower(int law, float panning) noexcept
+{
+    const double left  = getGain(law, -1.0f, panning);
+    const double right = getGain(law,  1.0f, panning);
+    return left * left + right * right;
+}
+
+constexpr double getSum(int law, float panning) noexcept
+{
+    return static_cast<double>(getGain(law, -1.0f, panning)) + getGain(law, 1.0f, panning);
+}
+
+// Interpolating between the grid points keeps what defines the laws, checked at the centre and at positions that fall
+// between two entries; constant power stays at unity power and the linear laws keep their sum
+static_assert(matches(getPower(ConstantPower,     0.0f),   1.0));
+static_assert(matches(getPower(ConstantPower,     0.3f),   1.0));
+static_assert(matches(getPower(ConstantPower,    -0.777f), 1.0));
+static_assert(matches(getSum  (LinearAttenuated,  0.3f),   1.0));
+static_assert(matches(getSum  (LinearAttenuated, -0.777f), 1.0));
+static_assert(matches(getSum  (Linear,            0.3f),   2.0));
+static_assert(matches(getGain (Linear, 1.0f,      0.3f),   1.3));
+}
+}
@@ -0,0 +1,126 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ParameterStore.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "ParameterStore.h"
+
+//======================================================================================================================
+ParameterStore::ParameterStore(std::vector<juce::RangedAudioParameter*> newParameters)
+    : parameters(std::move(newParameters))
+{
+    const std::size_t num_parameters = parameters.size();
+    const std::size_t num_words      = (num_parameters + 63) / 64;
+
+    values.allocate(num_parameters);
+    dirty.assign(num_words, 0);
+    pendingValues = std::make_unique<std::atomic<float>[]>(num_parameters);
+    pendingDirty  = std::make_unique<std::atomic<std::uint64_t>[]>(num_words);
+
+    for (std::size_t i = 0; i < num_words; ++i)
+    {
+        // Everything counts as changed for the very first block
+        const std::size_t bits_in_word = juce::jmin<std::size_t>(64, num_parameters - i * 64);
+        pendingDirty[i].store(bits_in_word == 64 ? ~std::uint64_t() : (std::uint64_t(1) << bits_in_word) - 1,
+                              std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < num_parameters; ++i)
+    {
+        juce::RangedAudioParameter *parameter = parameters[i];
+        jassert(parameter != nullptr);
+
+        pendingValues[i].store(parameter->convertFrom0to1(parameter->getValue()), std::memory_order_relaxed);
+
+        // The listener callback only gets the parameter's index in the processor, so that's what we map from
+        const int parameter_index = parameter->getParameterIndex();
+
+        // A parameter that wasn't added to a processor yet has no index, its changes can't be told apart from the
+        // others; it keeps the value it had at construction
+        jassert(parameter_index >= 0);
+
+        if (parameter_index < 0)
+        {
+            continue;
+        }
+
+        if (storeIndices.size() <= static_cast<std::size_t>(parameter_index))
+        {
+            storeIndices.resize(static_cast<std::size_t>(parameter_index) + 1, -1);
+        }
+
+        storeIndices[static_cast<std::size_t>(parameter_index)] = static_cast<int>(i);
+        parameter->addListener(this);
+    }
+}
+
+ParameterStore::~ParameterStore()
+{
+    for (juce::RangedAudioParameter *parameter : parameters)
+    {
+        parameter->removeListener(this);
+    }
+}
+
+//======================================================================================================================
+void ParameterStore::update() noexcept
+{
+    changed = false;
+
+    for (std::size_t word = 0; word < dirty.size(); ++word)
+    {
+        const std::uint64_t bits = pendingDirty[word].exchange(0, std::memory_order_acquire);
+        dirty[word] = bits;
+        changed    |= bits != 0;
+
+        std::size_t index = word * 64;
+
+        for (std::uint64_t remaining = bits; remaining != 0; remaining >>= 1, ++index)
+        {
+            if (remaining & 1u)
+            {
+                values[index] = pendingValues[index].load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+//======================================================================================================================
+void ParameterStore::parameterValueChanged(int parameterIndex, float newValue)
+{
+    if (!juce::isPositiveAndBelow(parameterIndex, static_cast<int>(storeIndices.size())))
+    {
+        return;
+    }
+
+    const int index = storeIndices[static_cast<std::size_t>(parameterIndex)];
+
+    if (index < 0)
+    {
+        return;
+    }
+
+    const auto slot = static_cast<std::size_t>(index);
+    pendingValues[slot].store(parameters[slot]->convertFrom0to1(newValue), std::memory_order_relaxed);
+    pendingDirty[slot / 64].fetch_or(std::uint64_t(1) << (slot % 64), std::memory_order_release);
+}
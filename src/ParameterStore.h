@@ -0,0 +1,91 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ParameterStore.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "SimdOps.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *  A dense, index-addressed mirror of a set of parameters for the audio thread.
+ *
+ *  Parameters get their index by their position in the list the store is constructed with. Whichever thread changes
+ *  a parameter only writes its denormalised value to an atomic slot and sets its bit in a dirty mask.
+ *  Once per block the audio thread calls update(), which collects all dirty slots into one contiguous,
+ *  cache-line-aligned float array; from there on the DSP reads plain floats by index and can ask which of them
+ *  changed with this block.
+ *
+ *  With nothing changed, an update costs one atomic exchange per 64 parameters.
+ */
+class ParameterStore final : private juce::AudioProcessorParameter::Listener
+{
+public:
+    static constexpr std::size_t CacheLineSize = 64;
+
+    //==================================================================================================================
+    explicit ParameterStore(std::vector<juce::RangedAudioParameter*> parameters);
+    ~ParameterStore() override;
+
+    //==================================================================================================================
+    /** Collects all changes since the last call, only ever call this from the audio thread or while it is halted. */
+    void update() noexcept;
+
+    //==================================================================================================================
+    float get(int index) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, size()));
+        return values[static_cast<std::size_t>(index)];
+    }
+
+    bool isDirty(int index) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, size()));
+        return (dirty[static_cast<std::size_t>(index) / 64] >> (static_cast<std::size_t>(index) % 64)) & 1u;
+    }
+
+    /** Determines whether any parameter changed with the last update. */
+    bool hasChanges() const noexcept { return changed; }
+
+    int size() const noexcept { return static_cast<int>(parameters.size()); }
+
+private:
+    std::vector<juce::RangedAudioParameter*> parameters;
+    simd::AlignedBlock<float, CacheLineSize> values;
+    std::vector<std::uint64_t> dirty;
+    std::vector<int> storeIndices;
+    std::unique_ptr<std::atomic<float>[]> pendingValues;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> pendingDirty;
+    bool changed { false };
+
+    //==================================================================================================================
+    void parameterValueChanged(int, float) override;
+    void parameterGestureChanged(int, bool) override {}
+};
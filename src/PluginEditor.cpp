@@ -97,10 +97,10 @@ void sendStartupMessage(const PluginSession &session, juce::String gpuInfo)
 // region CossinAudioProcessorEditor
 //======================================================================================================================
 CossinAudioProcessorEditor::CossinAudioProcessorEditor(CossinAudioProcessor &p, juce::AudioProcessorValueTreeState &vts,
-                                                       FFAU::LevelMeterSource &metreSource,
+                                                       MetreSnapshotExchange &metreSnapshots,
                                                        CossinMainEditorWindow &parent, bool supportsOpenGl,
                                                        const juce::String &gpuInfo)
-    : processor(p), sourceMetre(metreSource), tooltipServer(this),
+    : processor(p), metreSnapshots(metreSnapshots), tooltipServer(this),
 #if COSSIN_USE_OPENGL
       glContext(supportsOpenGl ? new juce::OpenGLContext() : nullptr),
 #endif
@@ -131,7 +131,7 @@ CossinAudioProcessorEditor::CossinAudioProcessorEditor(CossinAudioProcessor &p,
     parameterAttachments.attach(ParameterIds::MasterMix,           vts, sliderMix,        nullptr);
     parameterAttachments.attach(ParameterIds::MasterPan,           vts, sliderPanning,    nullptr);
     parameterAttachments.attach(ParameterIds::PropertyPanningMode, vts, valuePanningMode, nullptr);
-    // TODO parameterAttachments.attach(ParameterIds::PropertyProcessMode, vts, valueProcessMode, nullptr);
+    parameterAttachments.attach(ParameterIds::PropertyProcessMode, vts, valueProcessMode, nullptr);
     
     sendLog("Done initializing Cossin.");
     resized();
@@ -143,6 +143,8 @@ CossinAudioProcessorEditor::~CossinAudioProcessorEditor()
     sharedData->EventLocaleChange -= jaut::make_handler(&CossinAudioProcessorEditor::reloadLocale, *this);
     sharedData->EventThemeChange  -= jaut::make_handler(&CossinAudioProcessorEditor::reloadTheme,  *this);
     
+    processor.getSpectrumAnalyser().setActive(false);
+    
 #if COSSIN_USE_OPENGL
     if (glContext)
     {
@@ -270,9 +272,22 @@ void CossinAudioProcessorEditor::initializeComponents()
     buttonSettings.addListener(this);
     addAndMakeVisible(buttonSettings);
 
-    // Level metre display
-    metreLevel.setMeterSource(&sourceMetre);
+    // Level metre display, drawn from the snapshots the processor publishes
+    lookAndFeel.setMetreSnapshots(&metreSnapshots);
     addAndMakeVisible(metreLevel);
+    startTimerHz(30);
+    
+    // Loudness readout, clicking it restarts the measurement
+    loudnessDisplay.onReset = [this]()
+    {
+        processor.getLoudnessMeter().requestReset();
+    };
+    addAndMakeVisible(loudnessDisplay);
+    
+    // Spectrum analyser, the processor only analyses while this view exists
+    spectrumView.setInterceptsMouseClicks(false, false);
+    addAndMakeVisible(spectrumView);
+    processor.getSpectrumAnalyser().setActive(true);
 
     // Panning law selection list
     buttonPanningLawSelection.setLookAndFeel(this);
@@ -319,6 +334,7 @@ void CossinAudioProcessorEditor::resized()
 
     // Body
     backgroundBlur.setBounds(body.getX(), body.getY(), body.getWidth(), body.getHeight());
+    spectrumView  .setBounds(body.reduced(::Const_PanelMargin * 5));
     
     // Footer
     const int footer_middle             = footer.getCentreX();
@@ -327,16 +343,18 @@ void CossinAudioProcessorEditor::resized()
     const int footer_label_slider_small = footer_centre + 5;
     const int footer_knob_big_y         = footer.getY() + 39;
     const int footer_panning_y          = footer.getCentreY() + 13;
+    const int footer_panning_list_w     = static_cast<int>(res::List_PanningModes.size()) * 15;
 
     sliderLevel              .setBounds(footer_middle - 100,     footer_knob_small_y,       36,  36);
     sliderMix                .setBounds(footer_middle - 30,      footer_knob_big_y - 28,    60,  60);
     sliderPanning            .setBounds(footer_middle + 64,      footer_knob_small_y,       36,  36);
-    buttonPanningLawSelection.setBounds(footer_middle + 107,     footer_panning_y,          45,  15);
+    buttonPanningLawSelection.setBounds(footer_middle + 107,     footer_panning_y,          footer_panning_list_w, 15);
     buttonPanningLaw         .setBounds(footer_middle + 92,      footer_panning_y,          15,  15);
     labelLevel               .setBounds(footer_middle - 107,     footer_label_slider_small, 50,  31);
     labelMix                 .setBounds(footer_middle - 30,      footer_centre - 28,        60,  60);
     labelPan                 .setBounds(footer_middle + 50,      footer_label_slider_small, 50,  31);
     metreLevel               .setBounds(footer.getRight() - 259, footer_knob_big_y - 26,    212, 53);
+    loudnessDisplay          .setBounds(footer.getX() + 47,      footer_knob_big_y - 26,    212, 53);
     
     // Pop-ups and everything else that doesn't necessarily has to fit into grid (these stand by their own)
     const int options_c = getWidth() / 2 - ::Const_WindowDefaultWidth / 2;
@@ -510,7 +528,8 @@ void CossinAudioProcessorEditor::buttonClicked(juce::Button *button)
 {
     if (button == &buttonPanningLawSelection)
     {
-        const int panning_mode = std::min(buttonPanningLawSelection.getMouseXYRelative().getX() / 15, 2);
+        const int last_mode    = static_cast<int>(res::List_PanningModes.size()) - 1;
+        const int panning_mode = juce::jlimit(0, last_mode, buttonPanningLawSelection.getMouseXYRelative().getX() / 15);
         
         buttonPanningLaw.setToggleState(false, juce::dontSendNotification);
         buttonPanningLawSelection.setVisible(false);
@@ -599,6 +618,29 @@ void CossinAudioProcessorEditor::sliderDragEnded(juce::Slider*)
     }*/
 }
 
+void CossinAudioProcessorEditor::timerCallback()
+{
+    // Only the editor pulls, the metre's look and feel reads whatever was pulled last
+    if (metreSnapshots.pull())
+    {
+        metreLevel.repaint();
+    }
+    
+    SnapshotExchange<LoudnessReading> &loudness_snapshots = processor.getLoudnessMeter().getSnapshots();
+    
+    if (loudness_snapshots.pull())
+    {
+        loudnessDisplay.setReading(loudness_snapshots.getReadSnapshot());
+    }
+    
+    SnapshotExchange<SpectrumFrame> &spectrum_frames = processor.getSpectrumAnalyser().getFrames();
+    
+    if (spectrum_frames.pull())
+    {
+        spectrumView.setFrame(spectrum_frames.getReadSnapshot());
+    }
+}
+
 //======================================================================================================================
 void CossinAudioProcessorEditor::drawToggleButton(juce::Graphics &g, juce::ToggleButton &button, bool, bool)
 {
@@ -685,9 +727,9 @@ void CossinAudioProcessorEditor::openGLContextClosing()
 // region CossinMainEditorWindow
 //======================================================================================================================
 CossinMainEditorWindow::CossinMainEditorWindow(CossinAudioProcessor &processor, juce::AudioProcessorValueTreeState &vts,
-                                               foleys::LevelMeterSource &metreSource)
+                                               MetreSnapshotExchange &metreSnapshots)
     : AudioProcessorEditor(processor),
-      processor(processor), vts(vts), metreSource(metreSource)
+      processor(processor), vts(vts), metreSnapshots(metreSnapshots)
 {
     initializeWindow();
 
@@ -781,7 +823,7 @@ void CossinMainEditorWindow::handleAsyncUpdate()
     card_info = graphicsCardDetails;
 #endif
 
-    editor = std::make_unique<CossinAudioProcessorEditor>(processor, vts, metreSource, *this, is_supported, card_info);
+    editor = std::make_unique<CossinAudioProcessorEditor>(processor, vts, metreSnapshots, *this, is_supported, card_info);
     addAndMakeVisible(editor.get());
 
 #if COSSIN_USE_OPENGL
@@ -32,9 +32,11 @@
 #include <juce_opengl/juce_opengl.h>
 
 #include "CossinDef.h"
+#include "LoudnessDisplay.h"
 #include "PluginStyle.h"
 #include "OptionPanel.h"
 #include "ReloadListener.h"
+#include "SpectrumView.h"
 #include "AttachmentList.h"
 
 #include <bitset>
@@ -66,7 +68,7 @@ struct PluginSession final
 };
 
 class CossinAudioProcessorEditor final : public juce::Component, private juce::Button::Listener,
-                                         private juce::Slider::Listener,
+                                         private juce::Slider::Listener, private juce::Timer,
                                          
 #if COSSIN_USE_OPENGL
                                          public juce::OpenGLRenderer,
@@ -103,7 +105,7 @@ public:
     using AttachmentTypes = DefaultAttachmentList<AttachmentEntry<juce::Value, jaut::ValueParameterAttachment>>;
     
     //==================================================================================================================
-    CossinAudioProcessorEditor(CossinAudioProcessor&, juce::AudioProcessorValueTreeState&, foleys::LevelMeterSource&,
+    CossinAudioProcessorEditor(CossinAudioProcessor&, juce::AudioProcessorValueTreeState&, MetreSnapshotExchange&,
                                CossinMainEditorWindow&, bool, const juce::String&);
     ~CossinAudioProcessorEditor() override;
     
@@ -142,7 +144,7 @@ private:
     PluginSession session;
     juce::SharedResourcePointer<SharedData> sharedData;
     CossinAudioProcessor &processor;
-    foleys::LevelMeterSource &sourceMetre;
+    MetreSnapshotExchange &metreSnapshots;
     PluginStyle lookAndFeel;
     juce::TooltipWindow tooltipServer;
 
@@ -163,6 +165,8 @@ private:
     juce::DrawableButton buttonSettings;
     
     foleys::LevelMeter metreLevel;
+    LoudnessDisplay loudnessDisplay;
+    SpectrumView spectrumView;
     OptionPanel optionsPanel;
     
     juce::Slider sliderLevel;
@@ -203,6 +207,7 @@ private:
     void buttonClicked(juce::Button*) override;
     void sliderValueChanged(juce::Slider*) override;
     void sliderDragEnded(juce::Slider*) override;
+    void timerCallback() override;
 
     //==================================================================================================================
     void drawToggleButton(juce::Graphics&, juce::ToggleButton&, bool, bool) override;
@@ -226,7 +231,7 @@ class CossinMainEditorWindow final : public juce::AudioProcessorEditor, private
 #endif
 {
 public:
-    CossinMainEditorWindow(CossinAudioProcessor&, juce::AudioProcessorValueTreeState&, foleys::LevelMeterSource&);
+    CossinMainEditorWindow(CossinAudioProcessor&, juce::AudioProcessorValueTreeState&, MetreSnapshotExchange&);
     ~CossinMainEditorWindow() override;
     
     //==================================================================================================================
@@ -236,7 +241,7 @@ private:
     std::unique_ptr<CossinAudioProcessorEditor> editor;
     CossinAudioProcessor &processor;
     juce::AudioProcessorValueTreeState &vts;
-    foleys::LevelMeterSource &metreSource;
+    MetreSnapshotExchange &metreSnapshots;
 
 #if COSSIN_USE_OPENGL
     juce::MessageManager::Lock messageManagerLock;
@@ -33,14 +33,6 @@
 
 namespace
 {
-//======================================================================================================================
-inline constexpr float Const_Pi                        = 3.14159f;
-inline constexpr float Const_LinearPanningCompensation = 2.0f;
-inline constexpr float Const_SquarePanningCompensation = 1.41421356238f;
-inline constexpr float Const_SinePanningCompensation   = 1.41421356238f;
-
-inline constexpr int Resolution_LookupTable = 200;
-
 //======================================================================================================================
 template<class Member, class ...Args>
 std::unique_ptr<Member> newParameter(Member *&member, Args &&...args)
@@ -48,41 +40,44 @@ std::unique_ptr<Member> newParameter(Member *&member, Args &&...args)
     return std::unique_ptr<Member>((member = new Member(std::forward<Args>(args)...)));
 }
 
-auto createSineTable() noexcept
+//======================================================================================================================
+struct ChainModule
 {
-    std::array<float, Resolution_LookupTable + 1> table {};
-    constexpr int size = static_cast<std::size_t>(table.size());
-    
-    for (int i = 0; i < size; ++i)
-    {
-        table[static_cast<std::size_t>(i)] = std::sqrt(static_cast<float>(i) / 100.0f) *
-                                             Const_SquarePanningCompensation;
-    }
-    
-    return table;
-}
+    const char *moduleId;
 
-auto createSquareTable() noexcept
-{
-    std::array<float, ::Resolution_LookupTable + 1> table {};
-    constexpr int size = static_cast<std::size_t>(table.size());
-    
-    for (int i = 0; i < size; ++i)
-    {
-        table[static_cast<std::size_t>(i)] = std::sin((static_cast<float>(i) / 100.0f) * (Const_Pi / 2.0f)) *
-                                             Const_SinePanningCompensation;
-    }
-    
-    return table;
-}
+    // Inserts process the whole signal, the others are blended in at SendMix like an effect send
+    bool isInsert;
+};
+
+// The modules the processor creates, in the order the chains run them
+constexpr ChainModule chainModules[] {
+    { EffectEqualizer::ModuleId,   true  },
+    { EffectReverb::ModuleId,      false },
+    { EffectConvolution::ModuleId, false },
+    { EffectDynamics::ModuleId,    true  },
+    { EffectDelay::ModuleId,       false }
+};
+
+constexpr int NumChainSlots = static_cast<int>(std::size(chainModules));
+
+// The mix the sends start out with, all modules start out bypassed
+constexpr float SendMix = 0.3f;
+
+// The stack and the graph each run their own instance of every module
+constexpr int StackInstance = 0;
+constexpr int GraphInstance = 1;
 }
 
 //======================================================================================================================
 CossinAudioProcessor::CossinAudioProcessor()
      : AudioProcessor(getDefaultBusesLayout()),
-       parameters(*this, nullptr, "CossinState", getParameters())
+       parameters(*this, nullptr, "CossinState", getParameters()),
+       parameterStore(getStoredParameters())
 {
     initialize();
+    createModules();
+    publishModuleChains(floatCore);
+    publishModuleChains(doubleCore);
 }
 
 CossinAudioProcessor::~CossinAudioProcessor() = default;
@@ -93,15 +88,67 @@ const juce::String CossinAudioProcessor::getName() const
     return "Cossin";
 }
 
+double CossinAudioProcessor::getTailLengthSeconds() const
+{
+    const double sample_rate = getSampleRate();
+
+    if (sample_rate <= 0.0)
+    {
+        return 0.0;
+    }
+
+    const int process_mode = parProcMode->get();
+    const int tail = isUsingDoublePrecision() ? doubleCore.getTailSamples(process_mode)
+                                              : floatCore .getTailSamples(process_mode);
+    return tail / sample_rate;
+}
+
 //======================================================================================================================
 void CossinAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    const float gain   = parGain->get();
-    const int pan_mode = parPanMode->get();
-    previousGain[0]    = gain * calculatePanningGain(pan_mode, 0);
-    previousGain[1]    = gain * calculatePanningGain(pan_mode, 1);
+    parameterStore.update();
+    const ProcessingParameters processing_parameters = getProcessingParameters();
+    const juce::AudioChannelSet layout = getChannelLayoutOfBus(false, 0);
+    
+    // The dynamics keep a lookahead delay per channel, sized for the main bus when the cores start them
+    for (const ChainModule &chain_module : ::chainModules)
+    {
+        const int type = EffectModuleRegistry::findModuleType(chain_module.moduleId);
+        modules[static_cast<std::size_t>(type)].visit([&layout](auto &effect)
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(effect)>, EffectDynamics>)
+            {
+                effect.setNumChannels(layout.size());
+            }
+        });
+    }
+    
+    graphWorkers = getNumGraphWorkers(processing_parameters);
+    floatCore .setGraphWorkers(graphWorkers);
+    doubleCore.setGraphWorkers(graphWorkers);
+    
+    // Only the core matching the current precision holds any memory
+    if (isUsingDoublePrecision())
+    {
+        floatCore .release();
+        doubleCore.prepare(sampleRate, layout, samplesPerBlock, processing_parameters);
+        moduleLatency = doubleCore.getLatencySamples(processing_parameters.processMode);
+    }
+    else
+    {
+        doubleCore.release();
+        floatCore .prepare(sampleRate, layout, samplesPerBlock, processing_parameters);
+        moduleLatency = floatCore.getLatencySamples(processing_parameters.processMode);
+    }
+    
+    // Hosts expect the latency to be known by the time prepareToPlay returns
+    cancelPendingUpdate();
+    setLatencySamples(moduleLatency);
     
-    metreSource.resize(getMainBusNumOutputChannels(), static_cast<int>(0.02f * sampleRate / samplesPerBlock));
+    scheduler.reset(processing_parameters);
+    metering.prepare(sampleRate, layout.size());
+    loudnessMeter.prepare(sampleRate, layout);
+    spectrumAnalyser.prepare(sampleRate);
 }
 
 void CossinAudioProcessor::releaseResources()
@@ -112,38 +159,116 @@ bool CossinAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) co
 {
     const juce::AudioChannelSet main_bus = layouts.getMainOutputChannelSet();
 
-    if((main_bus != juce::AudioChannelSet::mono() && main_bus != juce::AudioChannelSet::stereo())
-       || main_bus == juce::AudioChannelSet::disabled())
+    // Any speaker layout will do, from mono up to immersive formats, as long as input and output match
+    if (main_bus.isDisabled())
     {
         return false;
     }
+    
+    if (layouts.inputBuses.size() > 1)
+    {
+        const juce::AudioChannelSet sidechain_bus = layouts.getChannelSet(true, 1);
+        
+        if (sidechain_bus != juce::AudioChannelSet::mono() && sidechain_bus != juce::AudioChannelSet::stereo()
+            && sidechain_bus != juce::AudioChannelSet::disabled())
+        {
+            return false;
+        }
+    }
 
     return main_bus == layouts.getMainInputChannelSet();
 }
 
 void CossinAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer&)
 {
-    juce::ScopedNoDenormals denormals;
+    processBlockInternal(buffer, floatCore);
+}
+
+void CossinAudioProcessor::processBlock(juce::AudioBuffer<double> &buffer, juce::MidiBuffer&)
+{
+    processBlockInternal(buffer, doubleCore);
+}
 
-    const float gain   = parGain->get();
-    const int pan_mode = parPanMode->get();
+template<class SampleType>
+void CossinAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType> &buffer, Core<SampleType> &core)
+{
+    juce::ScopedNoDenormals denormals;
     
-    for (auto i = 0; i < buffer.getNumChannels(); ++i)
+    parameterStore.update();
+    hostTempo.update(getPlayHead());
+    
+    for (int i = 0; i < ::NumChainSlots; ++i)
     {
-        const float current_gain = gain * calculatePanningGain(pan_mode, i);
-        
-        if (current_gain == previousGain[i])
+        core.setChainMix(i, parameterStore.get(IndexChainSlots + i * 2 + 1),
+                         parameterStore.get(IndexChainSlots + i * 2) >= 0.5f);
+    }
+    
+    const Bus *sidechain_bus = getBus(true, 1);
+    juce::AudioBuffer<SampleType> main_buffer = getBusBuffer(buffer, false, 0);
+    const juce::AudioBuffer<SampleType> key_buffer = sidechain_bus && sidechain_bus->isEnabled()
+                                                         ? getBusBuffer(buffer, true, 1)
+                                                         : juce::AudioBuffer<SampleType>();
+
+    const ProcessingParameters processing_parameters = getProcessingParameters();
+    const bool input_silent = Core<SampleType>::isSilent(main_buffer);
+    bool skipped = main_buffer.getNumSamples() > 0;
+    
+    scheduler.process(main_buffer, key_buffer, processing_parameters,
+                      [&core, input_silent, &skipped](juce::AudioBuffer<SampleType> &main,
+                                                      const juce::AudioBuffer<SampleType> &key,
+                                                      const ProcessingParameters &processingParameters)
+                      {
+                          skipped = core.process(main, key, processingParameters, input_silent) && skipped;
+                      });
+    
+    if (skipped)
+    {
+        numSkippedBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // The processing already follows latency changes, the host only needs to be told about them; threads can't be
+    // started from here, the graph's workers are started on the message thread once it's in use and stopped again
+    // when it isn't
+    const int latency        = core.getLatencySamples(processing_parameters.processMode);
+    const int graph_workers  = getNumGraphWorkers(processing_parameters);
+    const bool latency_moved = moduleLatency.exchange(latency, std::memory_order_relaxed) != latency;
+    const bool workers_moved = graphWorkers.exchange(graph_workers, std::memory_order_relaxed) != graph_workers;
+    
+    if (latency_moved || workers_moved)
+    {
+        triggerAsyncUpdate();
+    }
+    
+    // Loudness gating and the spectrum's decay still need to see the silence
+    metering.process(main_buffer, skipped);
+    loudnessMeter.process(main_buffer);
+    spectrumAnalyser.push(main_buffer);
+}
+
+void CossinAudioProcessor::handleAsyncUpdate()
+{
+    // A module may have changed its latency from the message thread, the chains only see that once they read it again;
+    // the audio thread then picks it up with its next block and comes back here if the total changed
+    const auto update_chains = [](auto &core)
+    {
+        if (auto *const stack = core.getModuleStack())
         {
-            buffer.applyGain(i, 0, buffer.getNumSamples(), current_gain);
+            stack->updateFromModules();
         }
-        else
+
+        if (auto *const graph = core.getModuleGraph())
         {
-            buffer.applyGainRamp(i, 0, buffer.getNumSamples(), previousGain[i], current_gain);
-            previousGain[i] = current_gain;
+            graph->updateFromModules();
         }
-    }
+    };
+
+    update_chains(floatCore);
+    update_chains(doubleCore);
+
+    floatCore .setGraphWorkers(graphWorkers.load(std::memory_order_relaxed));
+    doubleCore.setGraphWorkers(graphWorkers.load(std::memory_order_relaxed));
 
-    metreSource.measureBlock(buffer);
+    setLatencySamples(moduleLatency.load(std::memory_order_relaxed));
 }
 
 //======================================================================================================================
@@ -154,7 +279,7 @@ bool CossinAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* CossinAudioProcessor::createEditor()
 {
-    return new CossinMainEditorWindow(*this, parameters, metreSource);
+    return new CossinMainEditorWindow(*this, parameters, metering.getSnapshots());
 }
 
 //======================================================================================================================
@@ -230,31 +355,119 @@ void CossinAudioProcessor::initialize()
         windowBounds.setBounds(0, 0, property_window_size->getProperty("width") ->getValue(),
                                      property_window_size->getProperty("height")->getValue());
     )
+}
+
+void CossinAudioProcessor::createModules()
+{
+    modules = std::make_unique<EffectModuleRegistry::Slot[]>(EffectModuleRegistry::NumTypes);
+
+    for (const ChainModule &chain_module : ::chainModules)
+    {
+        const int type = EffectModuleRegistry::findModuleType(chain_module.moduleId);
+        jassert(type >= 0);
+
+        EffectModuleRegistry::Slot &module = modules[static_cast<std::size_t>(type)];
+        EffectModuleRegistry::createModule(module, type, moduleUnit, parameters, &undoManager);
 
-    // Misc
-    metreSource.setMaxHoldMS(50);
+        module.visit([this](auto &effect)
+        {
+            effect.onLatencyChanged = [this]() { triggerAsyncUpdate(); };
+
+            if constexpr (std::is_same_v<std::decay_t<decltype(effect)>, EffectDynamics>)
+            {
+                effect.setSidechainKey(&getSidechainKey());
+            }
+            else if constexpr (std::is_same_v<std::decay_t<decltype(effect)>, EffectDelay>)
+            {
+                effect.setHostTempo(&getHostTempo());
+            }
+        });
+    }
 }
 
-float CossinAudioProcessor::calculatePanningGain(int panMode, int channel) const noexcept
+template<class SampleType>
+void CossinAudioProcessor::publishModuleChains(Core<SampleType> &core)
 {
-    static auto SineLookupTable   = ::createSineTable();
-    static auto SquareLookupTable = ::createSquareTable();
-    
-    jassert(jaut::fit<int>(panMode, 0, res::List_PanningModes.size()));
+    using Stack = typename Core<SampleType>::Stack;
+    using Graph = typename Core<SampleType>::Graph;
 
-    if (panMode == 0) // linear
+    std::vector<typename Stack::Slot> stack_slots;
+    std::vector<typename Graph::Node> graph_slots;
+
+    for (const ChainModule &chain_module : ::chainModules)
     {
-        const float panning_p    = parPanning->get() / 2.0f + 0.5f;
-        const float channel_mod  = channel == 0 ? 1.0f - panning_p : panning_p;
-        return channel_mod * Const_LinearPanningCompensation;
+        const int type = EffectModuleRegistry::findModuleType(chain_module.moduleId);
+        EffectModuleRegistry::Slot &module = modules[static_cast<std::size_t>(type)];
+        stack_slots.push_back({ &module, StackInstance, module.getTailSamples(StackInstance),
+                                module.getLatencySamples(StackInstance) });
+        graph_slots.push_back({ &module, GraphInstance, module.getTailSamples(GraphInstance),
+                                module.getLatencySamples(GraphInstance) });
     }
-    else
+
+    // The graph runs the same chain as the stack, each module next to a node carrying its dry signal, so that
+    // switching between the two doesn't change the sound
+    auto stack = std::make_unique<Stack>();
+    auto graph = std::make_unique<Graph>();
+    stack->setSlots(stack_slots);
+    graph->setChain(graph_slots);
+
+    for (int i = 0; i < stack->getNumSlots(); ++i)
     {
-        const int panning_p   = juce::roundToInt(parPanning->get() * 100.0f) + 100;
-        const int table_index = channel == 0 ? 200 - panning_p : panning_p;
-        return panMode == 1 ? SquareLookupTable[static_cast<std::size_t>(table_index)]
-                            : SineLookupTable  [static_cast<std::size_t>(table_index)];
+        const auto index = static_cast<std::size_t>(i);
+        stack->setMix(i, parSlotMix[index]->get());
+        stack->setBypassed(i, parSlotBypass[index]->get());
+        graph->setChainMix(i, parSlotMix[index]->get(), parSlotBypass[index]->get());
     }
+
+    core.publishModuleStack(std::move(stack));
+    core.publishModuleGraph(std::move(graph));
+}
+
+std::vector<juce::RangedAudioParameter*> CossinAudioProcessor::getStoredParameters() const
+{
+    // In the order of StoreIndex
+    std::vector<juce::RangedAudioParameter*> stored_parameters {
+        parGain, parPanning, parMix, parPanMode, parDuckThreshold, parDuckRatio, parDuckAttack, parDuckRelease,
+        parDuckKeyFilter, parDuckKeyLow, parDuckKeyHigh, parProcMode, parGraphWorkers
+    };
+
+    for (std::size_t i = 0; i < parSlotMix.size(); ++i)
+    {
+        stored_parameters.emplace_back(parSlotBypass[i]);
+        stored_parameters.emplace_back(parSlotMix[i]);
+    }
+
+    return stored_parameters;
+}
+
+ProcessingParameters CossinAudioProcessor::getProcessingParameters() const noexcept
+{
+    const ParameterStore &store = parameterStore;
+    
+    ProcessingParameters processing_parameters;
+    processing_parameters.gain        = store.get(IndexGain);
+    processing_parameters.panning     = store.get(IndexPanning);
+    processing_parameters.mix         = store.get(IndexMix);
+    processing_parameters.panMode     = static_cast<int>(store.get(IndexPanMode));
+    processing_parameters.processMode = static_cast<int>(store.get(IndexProcessMode));
+    
+    DuckerParameters &ducker = processing_parameters.ducker;
+    ducker.threshold = store.get(IndexDuckThreshold);
+    ducker.ratio     = store.get(IndexDuckRatio);
+    ducker.attack    = store.get(IndexDuckAttack);
+    ducker.release   = store.get(IndexDuckRelease);
+    ducker.keyFilter = store.get(IndexDuckKeyFilter) >= 0.5f;
+    ducker.keyLow    = store.get(IndexDuckKeyLow);
+    ducker.keyHigh   = store.get(IndexDuckKeyHigh);
+
+    return processing_parameters;
+}
+
+int CossinAudioProcessor::getNumGraphWorkers(const ProcessingParameters &processingParameters) const noexcept
+{
+    // The graph's workers only run while it's in use
+    return processingParameters.processMode == static_cast<int>(ProcessMode::Graph)
+               ? static_cast<int>(parameterStore.get(IndexGraphWorkers)) : 0;
 }
 
 //======================================================================================================================
@@ -268,10 +481,10 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossinAudioProcessor::getPar
     const jaut::Config &config  = sharedData->Configuration();
     const int default_pan_mode  = std::clamp<int>(config.getProperty(res::Prop_DefaultsPanningMode, res::Cfg_Defaults)
                                                   ->getValue(), 0, last_panning_mode);
-    //const int default_processor = std::clamp<int>(config.getProperty(res::Prop_DefaultsProcessMode, res::Cfg_Defaults)
-    //                                              ->getValue(), 0, last_process_mode);
+    const int default_processor = std::clamp<int>(config.getProperty(res::Prop_DefaultsProcessMode, res::Cfg_Defaults)
+                                                  ->getValue(), 0, last_process_mode);
     
-    return {
+    juce::AudioProcessorValueTreeState::ParameterLayout layout {
         // Volume parameter
         ::newParameter(parGain, ParameterIds::MasterLevel, "Global level", Range(0.0f, 1.0f, 0.0f, 0.5f), 1.0f, "",
                        juce::AudioProcessorParameter::Category::genericParameter,
@@ -291,7 +504,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossinAudioProcessor::getPar
                        }),
         
         // Panning parameter
-        ::newParameter(parPanning, ParameterIds::MasterPan, "Global pan", Range(-1.0f, 1.0f, 0.01f, 0.5f, true), 0.0f,
+        ::newParameter(parPanning, ParameterIds::MasterPan, "Global pan", Range(-1.0f, 1.0f, 0.0f, 0.5f, true), 0.0f,
                        "", juce::AudioProcessorParameter::Category::genericParameter,
                        [](float value, int maximumStringLength) -> juce::String
                        {
@@ -312,16 +525,85 @@ juce::AudioProcessorValueTreeState::ParameterLayout CossinAudioProcessor::getPar
                        {
                            return juce::String(res::List_PanningModes[static_cast<std::size_t>(value)])
                                         .substring(maximumStringLength);
-                       })
-    
-        // TODO Processor mode parameter
-        /*::newParameter(parProcMode, ParameterIds::PropertyProcessMode, "Process mode", 0, last_process_mode,
+                       }),
+        
+        // Sidechain ducker parameters
+        ::newParameter(parDuckThreshold, ParameterIds::DuckerThreshold, "Duck threshold", Range(-60.0f, 0.0f), 0.0f,
+                       "", juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(value, 1) + "dB").substring(0, maximumStringLength);
+                       }),
+        ::newParameter(parDuckRatio, ParameterIds::DuckerRatio, "Duck ratio", Range(1.0f, 20.0f, 0.0f, 0.5f), 1.0f,
+                       "", juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(value, 1) + ":1").substring(0, maximumStringLength);
+                       }),
+        ::newParameter(parDuckAttack, ParameterIds::DuckerAttack, "Duck attack", Range(0.1f, 200.0f, 0.0f, 0.4f),
+                       10.0f, "", juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(value, 1) + "ms").substring(0, maximumStringLength);
+                       }),
+        ::newParameter(parDuckRelease, ParameterIds::DuckerRelease, "Duck release", Range(5.0f, 2000.0f, 0.0f, 0.4f),
+                       200.0f, "", juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(static_cast<int>(value)) + "ms").substring(0, maximumStringLength);
+                       }),
+        ::newParameter(parDuckKeyFilter, ParameterIds::DuckerKeyFilter, "Duck key filter", false),
+        ::newParameter(parDuckKeyLow, ParameterIds::DuckerKeyLow, "Duck key low cut", Range(20.0f, 2000.0f, 0.0f, 0.3f),
+                       150.0f, "", juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(static_cast<int>(value)) + "Hz").substring(0, maximumStringLength);
+                       }),
+        ::newParameter(parDuckKeyHigh, ParameterIds::DuckerKeyHigh, "Duck key high cut",
+                       Range(500.0f, 20000.0f, 0.0f, 0.3f), 4000.0f, "",
+                       juce::AudioProcessorParameter::Category::genericParameter,
+                       [](float value, int maximumStringLength)
+                       {
+                           return (juce::String(static_cast<int>(value)) + "Hz").substring(0, maximumStringLength);
+                       }),
+        
+        // Processor mode parameter
+        ::newParameter(parProcMode, ParameterIds::PropertyProcessMode, "Process mode", 0, last_process_mode,
                        default_processor, "",
                        [](int value, int maximumStringLength)
                        {
-                           return juce::String(res::List_PanModes[value]).substring(maximumStringLength);
-                       })*/
+                           return juce::String(res::List_ProcessModes[static_cast<std::size_t>(value)])
+                                        .substring(maximumStringLength);
+                       }),
+        
+        // Graph worker parameter, 0 runs the graph on the audio thread alone
+        ::newParameter(parGraphWorkers, ParameterIds::PropertyGraphWorkers, "Graph workers", 0,
+                       GraphWorkerPool::MaxWorkers, GraphWorkerPool::getDefaultNumWorkers(), "",
+                       [](int value, int maximumStringLength)
+                       {
+                           return (value == 0 ? juce::String("Audio thread only") : juce::String(value))
+                                        .substring(0, maximumStringLength);
+                       })
     };
+    
+    // Chain slot parameters, nothing runs until it's switched on
+    for (const ChainModule &chain_module : ::chainModules)
+    {
+        const juce::String id   = ParameterIds::ChainSlotPrefix + juce::String(chain_module.moduleId).toLowerCase();
+        const juce::String name = chain_module.moduleId;
+        
+        layout.add(::newParameter(parSlotBypass.emplace_back(), id + "_bypass", name + " bypass", true));
+        layout.add(::newParameter(parSlotMix.emplace_back(), id + "_mix", name + " mix", Range(0.0f, 1.0f),
+                                  chain_module.isInsert ? 1.0f : ::SendMix, "",
+                                  juce::AudioProcessorParameter::Category::genericParameter,
+                                  [](float value, int maximumStringLength)
+                                  {
+                                      return (juce::String(static_cast<int>(value * 100)) + "%")
+                                                  .substring(0, maximumStringLength);
+                                  }));
+    }
+    
+    return layout;
 }
 
 //======================================================================================================================
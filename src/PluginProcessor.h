@@ -26,9 +26,15 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include <ff_meters/ff_meters.h>
 
-inline constexpr int Const_NumChannels = 2;
+#include "EffectModules.h"
+#include "HostTempo.h"
+#include "LoudnessMeter.h"
+#include "MeteringEngine.h"
+#include "ParameterStore.h"
+#include "ProcessingCore.h"
+#include "SpectrumAnalyser.h"
+#include "SubBlockScheduler.h"
 
 struct ParameterIds
 {
@@ -36,13 +42,26 @@ struct ParameterIds
     static constexpr const char *MasterMix   = "par_master_mix";
     static constexpr const char *MasterPan   = "par_master_pan";
     
-    static constexpr const char *PropertyPanningMode = "property_panning_law";
-    static constexpr const char *PropertyProcessMode = "property_process_mode";
+    static constexpr const char *DuckerThreshold = "par_ducker_threshold";
+    static constexpr const char *DuckerRatio     = "par_ducker_ratio";
+    static constexpr const char *DuckerAttack    = "par_ducker_attack";
+    static constexpr const char *DuckerRelease   = "par_ducker_release";
+    static constexpr const char *DuckerKeyFilter = "par_ducker_key_filter";
+    static constexpr const char *DuckerKeyLow    = "par_ducker_key_low";
+    static constexpr const char *DuckerKeyHigh   = "par_ducker_key_high";
+    
+    static constexpr const char *PropertyPanningMode  = "property_panning_law";
+    static constexpr const char *PropertyProcessMode  = "property_process_mode";
+    static constexpr const char *PropertyGraphWorkers = "property_graph_workers";
+    
+    // Every module in the chains has a bypass and a mix parameter, "par_chain_<module>_bypass" and "..._mix" with the
+    // module id in lower case
+    static constexpr const char *ChainSlotPrefix = "par_chain_";
 };
 
 class SharedData;
 
-class CossinAudioProcessor final : public juce::AudioProcessor
+class CossinAudioProcessor final : public juce::AudioProcessor, private juce::AsyncUpdater
 {
 public:
     CossinAudioProcessor();
@@ -55,7 +74,9 @@ public:
     void prepareToPlay(double, int) override;
     void releaseResources() override;
     bool isBusesLayoutSupported(const BusesLayout&) const override;
-    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<float>&,  juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==================================================================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -63,12 +84,12 @@ public:
 
     //==================================================================================================================
     const juce::String getName() const override;
+    double getTailLengthSeconds() const override;
     
     // region Unused
-    bool   acceptsMidi() const override  { return false; }
-    bool   producesMidi() const override { return false; }
-    bool   isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0; }
+    bool acceptsMidi() const override  { return false; }
+    bool producesMidi() const override { return false; }
+    bool isMidiEffect() const override { return false; }
 
     //==================================================================================================================
     int  getNumPrograms() override    { return 0; }
@@ -85,8 +106,28 @@ public:
     //==================================================================================================================
     // GUI FUNCTIONS
     juce::Rectangle<int> &getWindowSize() noexcept;
+    
+    //==================================================================================================================
+    /** The loudness of the main output, for the editor's readout and for logging in the standalone. */
+    LoudnessMeter& getLoudnessMeter() noexcept { return loudnessMeter; }
+    
+    /** The spectrum of the main output, only analysed while the editor has it activated. */
+    SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+    
+    /** How many blocks were skipped entirely because there was nothing to hear, since the plugin was created. */
+    std::uint64_t getNumSkippedBlocks() const noexcept { return numSkippedBlocks.load(std::memory_order_relaxed); }
+    
+    /** The "Sidechain" bus of the block being processed, for the modules keyed from it. */
+    const SidechainKey& getSidechainKey() const noexcept { return sidechainKey; }
+
+    /** The tempo of the host, for the modules synced to it. */
+    const HostTempo& getHostTempo() const noexcept { return hostTempo; }
 
 private:
+    template<class SampleType>
+    using Core = ProcessingCore<SampleType, EffectModuleRegistry::Slot>;
+
+    //==================================================================================================================
     static BusesProperties getDefaultBusesLayout()
     {
         return BusesProperties()
@@ -95,6 +136,27 @@ private:
                    .withInput ("Sidechain", juce::AudioChannelSet::mono());
     }
     
+    // The positions of the parameters in the parameter store
+    enum StoreIndex
+    {
+        IndexGain,
+        IndexPanning,
+        IndexMix,
+        IndexPanMode,
+        IndexDuckThreshold,
+        IndexDuckRatio,
+        IndexDuckAttack,
+        IndexDuckRelease,
+        IndexDuckKeyFilter,
+        IndexDuckKeyLow,
+        IndexDuckKeyHigh,
+        IndexProcessMode,
+        IndexGraphWorkers,
+        
+        // Followed by the bypass and the mix of every slot of the chains, in chain order
+        IndexChainSlots
+    };
+    
     //==================================================================================================================
     juce::SharedResourcePointer<SharedData> sharedData;
     
@@ -103,12 +165,38 @@ private:
     juce::AudioParameterFloat *parMix      { nullptr };
     juce::AudioParameterInt   *parPanMode  { nullptr };
     juce::AudioParameterInt   *parProcMode { nullptr };
+    juce::AudioParameterInt   *parGraphWorkers { nullptr };
+    
+    std::vector<juce::AudioParameterBool*>  parSlotBypass;
+    std::vector<juce::AudioParameterFloat*> parSlotMix;
+    
+    juce::AudioParameterFloat *parDuckThreshold { nullptr };
+    juce::AudioParameterFloat *parDuckRatio     { nullptr };
+    juce::AudioParameterFloat *parDuckAttack    { nullptr };
+    juce::AudioParameterFloat *parDuckRelease   { nullptr };
+    juce::AudioParameterBool  *parDuckKeyFilter { nullptr };
+    juce::AudioParameterFloat *parDuckKeyLow    { nullptr };
+    juce::AudioParameterFloat *parDuckKeyHigh   { nullptr };
     
     juce::UndoManager undoManager;
-    foleys::LevelMeterSource metreSource;
+    MeteringEngine metering;
+    LoudnessMeter loudnessMeter;
+    SpectrumAnalyser spectrumAnalyser;
     juce::AudioProcessorValueTreeState parameters;
-    
-    float previousGain[Const_NumChannels] { 0.0f, 0.0f };
+    ParameterStore parameterStore;
+
+    // The unit the effect modules are registered with, and one slot per module type for those the chains run
+    jaut::DspUnit moduleUnit { *this, parameters, &undoManager };
+    std::unique_ptr<EffectModuleRegistry::Slot[]> modules;
+
+    SidechainKey           sidechainKey;
+    HostTempo              hostTempo;
+    Core<float>            floatCore  { sidechainKey };
+    Core<double>           doubleCore { sidechainKey };
+    SubBlockScheduler      scheduler;
+    std::atomic<std::uint64_t> numSkippedBlocks { 0 };
+    std::atomic<int> moduleLatency { 0 };
+    std::atomic<int> graphWorkers  { 0 };
 
     //==================================================================================================================
     // GUI DATA (only data which is solely considered while loading and saving)
@@ -116,7 +204,21 @@ private:
 
     //==================================================================================================================
     void initialize();
-    float calculatePanningGain(int, int) const noexcept;
+    void createModules();
+    std::vector<juce::RangedAudioParameter*> getStoredParameters() const;
+    ProcessingParameters getProcessingParameters() const noexcept;
+    int getNumGraphWorkers(const ProcessingParameters&) const noexcept;
+
+    // Builds the chains from the created modules and hands them to a core, from the message thread
+    template<class SampleType>
+    void publishModuleChains(Core<SampleType>&);
+
+    template<class SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>&, Core<SampleType>&);
+    
+    // Re-reads the latency of the modules into the chains and re-reports it to the host, and starts or stops the
+    // graph's workers, off the audio thread
+    void handleAsyncUpdate() override;
     
     //======================================================================================================================
     juce::AudioProcessorValueTreeState::ParameterLayout getParameters();
@@ -0,0 +1,518 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ProcessingCore.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include "EpochReclaimer.h"
+#include "LiveChain.h"
+#include "MasterGainPan.h"
+#include "MasterMix.h"
+#include "ModuleGraph.h"
+#include "ModuleStack.h"
+#include "SidechainDucker.h"
+#include "SidechainKey.h"
+#include "SimdOps.h"
+
+#include <memory>
+#include <type_traits>
+
+/** The process modes as listed in res::List_ProcessModes. */
+enum class ProcessMode
+{
+    Solo,
+    Stack,
+    Graph
+};
+
+/** The parameter values the processing core needs for a block or sub-block. */
+struct ProcessingParameters
+{
+    float gain        { 1.0f };
+    float panning     { 0.0f };
+    float mix         { 1.0f };
+    int   panMode     { 0 };
+    int   processMode { static_cast<int>(ProcessMode::Solo) };
+
+    DuckerParameters ducker;
+
+    //==================================================================================================================
+    /**
+     *  Interpolates between two parameter sets.
+     *  Continuous values are blended linearly, discrete ones switch to the target straight away.
+     *
+     *  @param from       The parameters at proportion 0
+     *  @param to         The parameters at proportion 1
+     *  @param proportion How far to go from one set to the other, between 0 and 1
+     *  @return The interpolated parameters
+     */
+    static ProcessingParameters interpolate(const ProcessingParameters &from, const ProcessingParameters &to,
+                                            float proportion) noexcept
+    {
+        const auto blend = [proportion](float start, float end) { return start + (end - start) * proportion; };
+
+        ProcessingParameters result = to;
+        result.gain    = blend(from.gain,    to.gain);
+        result.panning = blend(from.panning, to.panning);
+        result.mix     = blend(from.mix,     to.mix);
+
+        result.ducker.threshold = blend(from.ducker.threshold, to.ducker.threshold);
+        result.ducker.ratio     = blend(from.ducker.ratio,     to.ducker.ratio);
+        result.ducker.attack    = blend(from.ducker.attack,    to.ducker.attack);
+        result.ducker.release   = blend(from.ducker.release,   to.ducker.release);
+        result.ducker.keyLow    = blend(from.ducker.keyLow,    to.ducker.keyLow);
+        result.ducker.keyHigh   = blend(from.ducker.keyHigh,   to.ducker.keyHigh);
+
+        return result;
+    }
+
+    //==================================================================================================================
+    bool operator==(const ProcessingParameters &other) const noexcept
+    {
+        return gain == other.gain && panning == other.panning && mix == other.mix && panMode == other.panMode
+            && processMode == other.processMode && ducker == other.ducker;
+    }
+
+    bool operator!=(const ProcessingParameters &other) const noexcept { return !(*this == other); }
+};
+
+/**
+ *  The sample-type agnostic processing path of Cossin.
+ *  The processor owns one core per precision and only prepares the one the host asked for, so that a host running
+ *  a 64-bit engine doesn't need to convert every block to float and back.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ *  @tparam ModuleType The module type the chains run, as for ModuleStack and ModuleGraph; it also needs
+ *                     beginPlayback(int, double, int) and finishPlayback(int), which the plugin gets from
+ *                     EffectModuleRegistry::Slot
+ */
+template<class SampleType, class ModuleType>
+class ProcessingCore final
+{
+public:
+    using Stack = ModuleStack<SampleType, ModuleType>;
+    using Graph = ModuleGraph<SampleType, ModuleType>;
+
+    //==================================================================================================================
+    /** @param key Where the sidechain of each block is handed to the modules, shared with the other precision's core */
+    explicit ProcessingCore(SidechainKey &key) noexcept
+        : sidechainKey(key)
+    {}
+
+    //==================================================================================================================
+    void prepare(double sampleRate, const juce::AudioChannelSet &layout, int maximumBlockSize,
+                 const ProcessingParameters &parameters);
+    void release();
+
+    //==================================================================================================================
+    /**
+     *  Processes a block or sub-block.
+     *
+     *  Silent input is passed on to the module chain, which lets modules that rang out sleep. Once neither the chain
+     *  nor the dry delay has anything left to give, the remaining stages are skipped and the block is cleared; they
+     *  pick up from the state they went to sleep with as soon as there is something to hear again.
+     *
+     *  @param main        The block to process in place
+     *  @param sidechain   The key of the ducker and of the modules keyed from the sidechain, may have no channels
+     *  @param parameters  The parameters for this block
+     *  @param inputSilent Whether the main input is silent, as determined by isSilent()
+     *  @return True if the block was skipped and now holds nothing but zeros
+     */
+    bool process(juce::AudioBuffer<SampleType> &main, const juce::AudioBuffer<SampleType> &sidechain,
+                 const ProcessingParameters &parameters, bool inputSilent = false) noexcept;
+
+    /**
+     *  Gets the latency of the modules that are run in the given process mode, which is also what the dry signal
+     *  gets delayed by. Changes of the module latencies are picked up here, so this must only be called from the audio
+     *  thread or while not processing.
+     *
+     *  @param processMode The process mode to get the latency for
+     *  @return The latency in samples
+     */
+    int getLatencySamples(int processMode) noexcept;
+
+    /**
+     *  Gets how long the output keeps sounding after the input went silent, in samples.
+     *
+     *  @param processMode The process mode to get the tail for
+     *  @return The tail of the modules that are run in that mode
+     */
+    int getTailSamples(int processMode) const;
+
+    //==================================================================================================================
+    /** Determines whether a block is quiet enough to count as silence, that is all samples below -120 dB. */
+    static bool isSilent(const juce::AudioBuffer<SampleType> &buffer) noexcept;
+
+    //==================================================================================================================
+    /**
+     *  Replaces the chain of modules that runs in place of the wet signal while in ProcessMode::Stack, safe while
+     *  processing. The stack gets prepared and its modules' instances get beginPlayback called here, on the calling
+     *  thread; the audio thread crossfades to it with its next block.
+     *  Always call this from the message thread. The instances must not be used by the stack that is replaced.
+     *
+     *  @param newStack The new stack with its slots set, or nullptr for none
+     */
+    void publishModuleStack(std::unique_ptr<Stack> newStack);
+
+    /** Same as publishModuleStack(), for the graph of modules that runs while in ProcessMode::Graph. */
+    void publishModuleGraph(std::unique_ptr<Graph> newGraph);
+
+    /** The stack that was last published, only for the message thread to change its mix and bypass settings. */
+    Stack* getModuleStack() const noexcept { return stackChain.getPublished(); }
+
+    /** The graph that was last published, only for the message thread to change its node settings. */
+    Graph* getModuleGraph() const noexcept { return graphChain.getPublished(); }
+
+    /**
+     *  Sets the mix and bypass of a slot of the published stack and graph, the latter built with
+     *  ModuleGraph::setChain(); see ModuleStack::setMix() and ModuleStack::setBypassed().
+     *  Safe to call from any thread, as long as no chain is published at the same time.
+     *
+     *  @param slot       The index of the slot in the chain
+     *  @param mix        The wet proportion between 0 and 1
+     *  @param isBypassed Whether the slot is bypassed
+     */
+    void setChainMix(int slot, float mix, bool isBypassed) noexcept;
+
+    /**
+     *  Sets how many worker threads the graph runs on besides the audio thread, starting or stopping them right away
+     *  if the core is prepared; safe while processing, call this from the message thread.
+     *  This starts out at 0, so that no threads are kept around while ProcessMode::Graph isn't even in use.
+     *
+     *  @param numWorkers The number of workers, 0 to run the graph on the audio thread alone
+     */
+    void setGraphWorkers(int numWorkers);
+
+private:
+    static constexpr double SilenceThreshold = 1e-6; // -120 dB
+
+    //==================================================================================================================
+    // Declared first so that it outlives the chains retiring into it
+    EpochReclaimer reclaimer;
+    LiveChain<SampleType, Stack> stackChain { reclaimer };
+    LiveChain<SampleType, Graph> graphChain { reclaimer };
+
+    SidechainKey &sidechainKey;
+
+    // What the core was last prepared with, for chains published while playing
+    double preparedSampleRate { 0.0 };
+    int preparedChannels      { 0 };
+    int preparedBlockSize     { 0 };
+    int graphWorkers          { 0 };
+
+    MasterMix<SampleType>       mixStage;
+    SidechainDucker<SampleType> duckerStage;
+    MasterGainPan<SampleType>   masterStage;
+
+    // How many silent samples the dry delay of the mix stage got fed in a row, up to its latency
+    int silentSamples { 0 };
+
+    //==================================================================================================================
+    template<class Chain>
+    void prepareChain(Chain&);
+    void enterChains(int processMode) noexcept;
+};
+
+//======================================================================================================================
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::prepare(double sampleRate, const juce::AudioChannelSet &layout,
+                                                     int maximumBlockSize, const ProcessingParameters &parameters)
+{
+    const auto max_latency = static_cast<int>(sampleRate * MasterMix<SampleType>::MaxLatencySeconds);
+
+    preparedSampleRate = sampleRate;
+    preparedChannels   = layout.size();
+    preparedBlockSize  = maximumBlockSize;
+
+    reclaimer.start();
+    stackChain.prepare(sampleRate, layout.size(), maximumBlockSize);
+    graphChain.prepare(sampleRate, layout.size(), maximumBlockSize);
+
+    if (Stack *const stack = stackChain.getPublished())
+    {
+        prepareChain(*stack);
+    }
+
+    if (Graph *const graph = graphChain.getPublished())
+    {
+        prepareChain(*graph);
+    }
+
+    mixStage.prepare(sampleRate, layout.size(), maximumBlockSize);
+    mixStage.setLatency(juce::jmin(getLatencySamples(parameters.processMode), max_latency));
+    mixStage.reset(parameters.mix);
+
+    duckerStage.prepare(sampleRate, maximumBlockSize);
+    duckerStage.setParameters(parameters.ducker);
+
+    masterStage.prepare(sampleRate, maximumBlockSize, layout);
+    masterStage.reset(parameters.gain, parameters.panning, parameters.panMode);
+
+    silentSamples = 0;
+}
+
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::release()
+{
+    mixStage    = MasterMix<SampleType>();
+    duckerStage = SidechainDucker<SampleType>();
+    masterStage = MasterGainPan<SampleType>();
+
+    stackChain.release();
+    graphChain.release();
+
+    // The other precision's core shares the modules, only let go of them if they were started from this one
+    const bool was_prepared = preparedBlockSize > 0;
+    const auto finish = [](ModuleType &module, int instance) { module.finishPlayback(instance); };
+
+    if (Stack *const stack = stackChain.getPublished())
+    {
+        stack->release();
+
+        if (was_prepared)
+        {
+            stack->forEachModule(finish);
+        }
+    }
+
+    if (Graph *const graph = graphChain.getPublished())
+    {
+        graph->release();
+
+        if (was_prepared)
+        {
+            graph->forEachModule(finish);
+        }
+    }
+
+    // Nothing reads any retired chain anymore, they are all freed right away
+    reclaimer.stop();
+    preparedBlockSize = 0;
+}
+
+//======================================================================================================================
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::publishModuleStack(std::unique_ptr<Stack> newStack)
+{
+    if (newStack && preparedBlockSize > 0)
+    {
+        prepareChain(*newStack);
+    }
+
+    stackChain.publish(std::move(newStack));
+}
+
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::publishModuleGraph(std::unique_ptr<Graph> newGraph)
+{
+    if (newGraph && preparedBlockSize > 0)
+    {
+        prepareChain(*newGraph);
+    }
+
+    graphChain.publish(std::move(newGraph));
+}
+
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::setChainMix(int slot, float mix, bool isBypassed) noexcept
+{
+    if (Stack *const stack = stackChain.getPublished())
+    {
+        stack->setMix(slot, mix);
+        stack->setBypassed(slot, isBypassed);
+    }
+
+    if (Graph *const graph = graphChain.getPublished())
+    {
+        graph->setChainMix(slot, mix, isBypassed);
+    }
+}
+
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::setGraphWorkers(int numWorkers)
+{
+    graphWorkers = numWorkers;
+
+    // Graphs that were replaced keep theirs until they are freed, they only run for the crossfade anyway
+    if (Graph *const graph = graphChain.getPublished())
+    {
+        graph->setNumWorkers(numWorkers);
+    }
+}
+
+//======================================================================================================================
+template<class SampleType, class ModuleType>
+bool ProcessingCore<SampleType, ModuleType>::process(juce::AudioBuffer<SampleType> &buffer,
+                                                     const juce::AudioBuffer<SampleType> &sidechain,
+                                                     const ProcessingParameters &parameters, bool inputSilent) noexcept
+{
+    // The dry signal follows the modules when their latency changes, it's a jump either way; this also picks up newly
+    // published chains
+    mixStage.setLatency(getLatencySamples(parameters.processMode));
+
+    // The dry delay only holds silence once it got fed at least as much of it as it delays by
+    const int latency      = mixStage.getLatency();
+    const bool dry_flushed = inputSilent && silentSamples >= latency;
+
+    mixStage.setMix(parameters.mix);
+
+    if (!dry_flushed)
+    {
+        mixStage.pushDrySamples(buffer);
+        silentSamples = inputSilent ? juce::jmin(silentSamples + buffer.getNumSamples(), latency) : 0;
+    }
+    else
+    {
+        // Whatever the dry buffer still holds is from the last block that was pushed, it must not be mixed in again
+        mixStage.pushSilentSamples(buffer.getNumSamples());
+    }
+
+    bool output_silent = inputSilent;
+    sidechainKey.set(&sidechain);
+
+    if (parameters.processMode == static_cast<int>(ProcessMode::Stack))
+    {
+        output_silent = stackChain.process(buffer, inputSilent);
+    }
+    else if (parameters.processMode == static_cast<int>(ProcessMode::Graph))
+    {
+        output_silent = graphChain.process(buffer, inputSilent);
+    }
+
+    sidechainKey.set<SampleType>(nullptr);
+
+    if (dry_flushed && output_silent)
+    {
+        buffer.clear();
+        return true;
+    }
+
+    // The chain may still ring while the input is silent, its tail gets scaled by the mix with nothing dry added
+    mixStage.mixWetSamples(buffer);
+
+    duckerStage.setParameters(parameters.ducker);
+    duckerStage.process(buffer, sidechain);
+
+    masterStage.setTargets(parameters.gain, parameters.panning, parameters.panMode);
+    masterStage.process(buffer);
+
+    return false;
+}
+
+template<class SampleType, class ModuleType>
+int ProcessingCore<SampleType, ModuleType>::getLatencySamples(int processMode) noexcept
+{
+    enterChains(processMode);
+
+    if (processMode == static_cast<int>(ProcessMode::Stack))
+    {
+        Stack *const stack = stackChain.getCurrent();
+        return stack ? stack->getLatencySamples() : 0;
+    }
+
+    if (processMode == static_cast<int>(ProcessMode::Graph))
+    {
+        Graph *const graph = graphChain.getCurrent();
+        return graph ? graph->updateLatency() : 0;
+    }
+
+    return 0;
+}
+
+template<class SampleType, class ModuleType>
+int ProcessingCore<SampleType, ModuleType>::getTailSamples(int processMode) const
+{
+    if (processMode == static_cast<int>(ProcessMode::Stack))
+    {
+        return stackChain.read([](const Stack *stack) { return stack ? stack->getTailSamples() : 0; });
+    }
+
+    if (processMode == static_cast<int>(ProcessMode::Graph))
+    {
+        return graphChain.read([](const Graph *graph) { return graph ? graph->getTailSamples() : 0; });
+    }
+
+    return 0;
+}
+
+//======================================================================================================================
+template<class SampleType, class ModuleType>
+template<class Chain>
+void ProcessingCore<SampleType, ModuleType>::prepareChain(Chain &chain)
+{
+    const auto max_latency = static_cast<int>(preparedSampleRate * MasterMix<SampleType>::MaxLatencySeconds);
+
+    chain.forEachModule([this](ModuleType &module, int instance)
+    {
+        module.beginPlayback(instance, preparedSampleRate, preparedBlockSize);
+    });
+
+    // Starting the instances may have changed their latencies and tails, like by setting up oversampling
+    chain.updateFromModules();
+
+    if constexpr (std::is_same_v<Chain, Graph>)
+    {
+        chain.prepare(preparedChannels, preparedBlockSize, max_latency, graphWorkers);
+    }
+    else
+    {
+        chain.prepare(preparedChannels, preparedBlockSize, max_latency);
+    }
+}
+
+template<class SampleType, class ModuleType>
+void ProcessingCore<SampleType, ModuleType>::enterChains(int processMode) noexcept
+{
+    // Only the chain in use holds on to anything, so that the other one's retired chains can be freed
+    if (processMode == static_cast<int>(ProcessMode::Stack))
+    {
+        stackChain.enter();
+        graphChain.leave();
+    }
+    else if (processMode == static_cast<int>(ProcessMode::Graph))
+    {
+        graphChain.enter();
+        stackChain.leave();
+    }
+    else
+    {
+        stackChain.leave();
+        graphChain.leave();
+    }
+}
+
+//======================================================================================================================
+template<class SampleType, class ModuleType>
+bool ProcessingCore<SampleType, ModuleType>::isSilent(const juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    for (int i = 0; i < buffer.getNumChannels(); ++i)
+    {
+        if (simd::getMaxAbs(buffer.getReadPointer(i), buffer.getNumSamples()) > SampleType(SilenceThreshold))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -138,14 +138,16 @@ inline constexpr CString Prop_StandaloneDevicesOutput   = "output";
 inline constexpr JAUT_DECLARE_AUTOMATIC_STD_ARRAY(List_PanningModes,
     "Linear",
     "Square",
-    "Sinusoidal"
+    "Sinusoidal",
+    "Sine -3dB",
+    "Hybrid -4.5dB",
+    "Linear -6dB"
 );
 
 /** Processors */
 inline constexpr JAUT_DECLARE_AUTOMATIC_STD_ARRAY(List_ProcessModes,
-    "Solo"/*,
+    "Solo",
     "Stack",
     "Graph"
-    */
 );
 }
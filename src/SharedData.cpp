@@ -155,6 +155,7 @@ void SharedData::initAppdata() const
         (void) appData.dirLang     .createDirectory();
         (void) appData.dirPresets  .createDirectory();
         (void) appData.dirThemes   .createDirectory();
+        (void) appData.dirImpulses .createDirectory();
         (void) appData.dirDataLogs .createDirectory();
         (void) appData.dirDataSaves.createDirectory();
     }
@@ -54,6 +54,9 @@ public:
         juce::File dirThemes  { dirRoot.getChildFile("Themes")  };
         juce::File dirPresets { dirRoot.getChildFile("Presets") };
     
+        // Impulse responses for the convolution module
+        juce::File dirImpulses { dirRoot.getChildFile("Impulses") };
+    
         juce::File dirData      { dirRoot.getChildFile("Data")  };
         juce::File dirDataLogs  { dirData.getChildFile("Logs")  };
         juce::File dirDataSaves { dirData.getChildFile("Saves") };
@@ -0,0 +1,241 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SidechainDucker.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "SidechainDucker.h"
+#include "SimdOps.h"
+
+namespace
+{
+//======================================================================================================================
+// levels = max(levels, |key|)
+template<class SampleType>
+void rectifyMax(SampleType *levels, const SampleType *key, int numSamples) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        max(Vec::load(levels + i), abs(Vec::load(key + i))).store(levels + i);
+    }
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        levels[i] = std::max(levels[i], std::abs(key[i]));
+    }
+}
+
+// levels = |levels|
+template<class SampleType>
+void rectify(SampleType *levels, int numSamples) noexcept
+{
+    using Vec = simd::Vec<SampleType>;
+
+    constexpr int step = Vec::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        abs(Vec::load(levels + i)).store(levels + i);
+    }
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        levels[i] = std::abs(levels[i]);
+    }
+}
+
+template<class SampleType>
+SampleType getSmoothingCoefficient(double sampleRate, float milliseconds) noexcept
+{
+    const double samples = juce::jmax(1.0, static_cast<double>(milliseconds) * 0.001 * sampleRate);
+    return static_cast<SampleType>(std::exp(-1.0 / samples));
+}
+}
+
+//======================================================================================================================
+template<class SampleType>
+void SidechainDucker<SampleType>::Biquad::process(SampleType *data, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const SampleType input  = data[i];
+        const SampleType output = b0 * input + s1;
+        s1 = b1 * input - a1 * output + s2;
+        s2 = b2 * input - a2 * output;
+        data[i] = output;
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void SidechainDucker<SampleType>::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate  = newSampleRate;
+    scratchSize = juce::jmax(1, maximumBlockSize);
+    keyLevels.allocate(static_cast<std::size_t>(scratchSize), true);
+
+    updateCoefficients();
+    reset();
+}
+
+template<class SampleType>
+void SidechainDucker<SampleType>::reset() noexcept
+{
+    envelope = 0;
+    keyHighPass.s1 = keyHighPass.s2 = 0;
+    keyLowPass .s1 = keyLowPass .s2 = 0;
+}
+
+//======================================================================================================================
+template<class SampleType>
+void SidechainDucker<SampleType>::setParameters(const DuckerParameters &newParameters) noexcept
+{
+    if (newParameters != parameters)
+    {
+        parameters = newParameters;
+        updateCoefficients();
+    }
+}
+
+template<class SampleType>
+void SidechainDucker<SampleType>::process(juce::AudioBuffer<SampleType> &main,
+                                          const juce::AudioBuffer<SampleType> &key) noexcept
+{
+    if (key.getNumChannels() == 0 || parameters.ratio <= 1.0f)
+    {
+        envelope = 0;
+        return;
+    }
+
+    const int num_samples = main.getNumSamples();
+
+    for (int position = 0; position < num_samples; position += scratchSize)
+    {
+        processChunk(main, key, position, juce::jmin(scratchSize, num_samples - position));
+    }
+}
+
+//======================================================================================================================
+template<class SampleType>
+void SidechainDucker<SampleType>::updateCoefficients() noexcept
+{
+    attackCoeff  = ::getSmoothingCoefficient<SampleType>(sampleRate, parameters.attack);
+    releaseCoeff = ::getSmoothingCoefficient<SampleType>(sampleRate, parameters.release);
+    thresholdLin = static_cast<SampleType>(juce::Decibels::decibelsToGain(parameters.threshold));
+    slope        = static_cast<SampleType>(1.0 / juce::jmax(1.0f, parameters.ratio) - 1.0);
+
+    // Butterworth high and low pass, the RBJ way
+    const auto design = [this](Biquad &filter, float frequency, bool highPass)
+    {
+        const double nyquist = sampleRate * 0.5;
+        const double omega   = juce::MathConstants<double>::twoPi * juce::jlimit(10.0, nyquist * 0.95,
+                                                                                 static_cast<double>(frequency))
+                                                                   / sampleRate;
+        const double cos_w   = std::cos(omega);
+        const double alpha   = std::sin(omega) / juce::MathConstants<double>::sqrt2; // q = 1/sqrt(2)
+        const double a0      = 1.0 + alpha;
+        const double b_mid   = highPass ? -(1.0 + cos_w) : 1.0 - cos_w;
+        const double b_side  = highPass ? (1.0 + cos_w) * 0.5 : (1.0 - cos_w) * 0.5;
+
+        filter.b0 = static_cast<SampleType>(b_side / a0);
+        filter.b1 = static_cast<SampleType>(b_mid  / a0);
+        filter.b2 = static_cast<SampleType>(b_side / a0);
+        filter.a1 = static_cast<SampleType>(-2.0 * cos_w / a0);
+        filter.a2 = static_cast<SampleType>((1.0 - alpha) / a0);
+    };
+
+    design(keyHighPass, parameters.keyLow,  true);
+    design(keyLowPass,  parameters.keyHigh, false);
+}
+
+template<class SampleType>
+void SidechainDucker<SampleType>::processChunk(juce::AudioBuffer<SampleType> &main,
+                                               const juce::AudioBuffer<SampleType> &key,
+                                               int start, int numSamples) noexcept
+{
+    SampleType *levels = keyLevels.get();
+    const int num_key_channels = key.getNumChannels();
+
+    // Key detection
+    if (parameters.keyFilter)
+    {
+        juce::FloatVectorOperations::copy(levels, key.getReadPointer(0, start), numSamples);
+
+        for (int i = 1; i < num_key_channels; ++i)
+        {
+            juce::FloatVectorOperations::add(levels, key.getReadPointer(i, start), numSamples);
+        }
+
+        if (num_key_channels > 1)
+        {
+            juce::FloatVectorOperations::multiply(levels, SampleType(1) / static_cast<SampleType>(num_key_channels),
+                                                  numSamples);
+        }
+
+        keyHighPass.process(levels, numSamples);
+        keyLowPass .process(levels, numSamples);
+        ::rectify(levels, numSamples);
+    }
+    else
+    {
+        juce::FloatVectorOperations::clear(levels, numSamples);
+
+        for (int i = 0; i < num_key_channels; ++i)
+        {
+            ::rectifyMax(levels, key.getReadPointer(i, start), numSamples);
+        }
+    }
+
+    // Envelope and gain computer, the key levels get replaced by the gain to apply
+    SampleType min_gain = 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const SampleType level = levels[i];
+        const SampleType coeff = level > envelope ? attackCoeff : releaseCoeff;
+        envelope = level + coeff * (envelope - level);
+
+        const SampleType gain = envelope > thresholdLin ? std::pow(envelope / thresholdLin, slope) : SampleType(1);
+        levels[i] = gain;
+        min_gain  = juce::jmin(min_gain, gain);
+    }
+
+    if (min_gain >= SampleType(1))
+    {
+        return;
+    }
+
+    for (int i = 0; i < main.getNumChannels(); ++i)
+    {
+        juce::FloatVectorOperations::multiply(main.getWritePointer(i, start), levels, numSamples);
+    }
+}
+
+//======================================================================================================================
+template class SidechainDucker<float>;
+template class SidechainDucker<double>;
@@ -0,0 +1,97 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SidechainDucker.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/** The settings of the sidechain ducker. */
+struct DuckerParameters
+{
+    float threshold { 0.0f };    // in dB
+    float ratio     { 1.0f };
+    float attack    { 10.0f };   // in ms
+    float release   { 200.0f };  // in ms
+    float keyLow    { 150.0f };  // in Hz
+    float keyHigh   { 4000.0f }; // in Hz
+    bool  keyFilter { false };
+
+    //==================================================================================================================
+    bool operator==(const DuckerParameters &other) const noexcept
+    {
+        return threshold == other.threshold && ratio   == other.ratio   && attack    == other.attack
+            && release   == other.release   && keyLow  == other.keyLow  && keyHigh   == other.keyHigh
+            && keyFilter == other.keyFilter;
+    }
+
+    bool operator!=(const DuckerParameters &other) const noexcept { return !(*this == other); }
+};
+
+/**
+ *  Ducks the main signal by the level of the "Sidechain" input bus.
+ *  The key is rectified across all of its channels in a vectorised pass, optionally band-limited beforehand,
+ *  and then fed through a peak envelope follower with separate attack and release times.
+ *  A ratio of 1 or a missing key leaves the signal untouched and costs nothing.
+ *
+ *  @tparam SampleType The sample type of the processed buffers, either float or double
+ */
+template<class SampleType>
+class SidechainDucker final
+{
+public:
+    void prepare(double sampleRate, int maximumBlockSize);
+    void reset() noexcept;
+
+    //==================================================================================================================
+    void setParameters(const DuckerParameters&) noexcept;
+    void process(juce::AudioBuffer<SampleType> &main, const juce::AudioBuffer<SampleType> &key) noexcept;
+
+private:
+    struct Biquad
+    {
+        SampleType b0 { 1 }, b1 { 0 }, b2 { 0 }, a1 { 0 }, a2 { 0 };
+        SampleType s1 { 0 }, s2 { 0 };
+
+        //==============================================================================================================
+        void process(SampleType*, int) noexcept;
+    };
+
+    //==================================================================================================================
+    DuckerParameters parameters;
+    juce::HeapBlock<SampleType> keyLevels;
+    Biquad keyHighPass;
+    Biquad keyLowPass;
+    double sampleRate       { 44100.0 };
+    SampleType envelope     { 0 };
+    SampleType attackCoeff  { 0 };
+    SampleType releaseCoeff { 0 };
+    SampleType thresholdLin { 1 };
+    SampleType slope        { 0 };
+    int scratchSize         { 0 };
+
+    //==================================================================================================================
+    void updateCoefficients() noexcept;
+    void processChunk(juce::AudioBuffer<SampleType>&, const juce::AudioBuffer<SampleType>&, int, int) noexcept;
+};
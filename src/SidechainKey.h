@@ -0,0 +1,77 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SidechainKey.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <type_traits>
+
+/**
+ *  Hands the block of the "Sidechain" input bus to the modules that are keyed from it.
+ *
+ *  The processing core sets the key before it runs the module chain and clears it again afterwards, modules look it
+ *  up while they process that same block; on whichever thread runs them, the graph's workers pick it up along with the
+ *  rest of the block. There is one per processor, shared by both precisions.
+ */
+class SidechainKey final
+{
+public:
+    /** Sets the key for the block about to be processed, or nullptr once it's done; audio thread only. */
+    template<class SampleType>
+    void set(const juce::AudioBuffer<SampleType> *key) noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            floatKey = key;
+        }
+        else
+        {
+            doubleKey = key;
+        }
+    }
+
+    /** Gets the key of the block being processed, nullptr if there is none or it has no channels. */
+    template<class SampleType>
+    const juce::AudioBuffer<SampleType>* get() const noexcept
+    {
+        const juce::AudioBuffer<SampleType> *key = nullptr;
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            key = floatKey;
+        }
+        else
+        {
+            key = doubleKey;
+        }
+
+        return key != nullptr && key->getNumChannels() > 0 ? key : nullptr;
+    }
+
+private:
+    const juce::AudioBuffer<float>  *floatKey  { nullptr };
+    const juce::AudioBuffer<double> *doubleKey { nullptr };
+};
@@ -0,0 +1,359 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SimdOps.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define COSSIN_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#   define COSSIN_SIMD_NEON 1
+#   if defined(__aarch64__)
+#       define COSSIN_SIMD_NEON_F64 1
+#   endif
+#endif
+
+namespace simd
+{
+/**
+ *  A thin wrapper around the native 128-bit float register of the target platform.
+ *  All loads and stores are unaligned, as host buffers give us no alignment guarantees.
+ *  If neither SSE2 nor NEON are available, this falls back to a plain 4-float array.
+ */
+struct VecF
+{
+    static constexpr int Size = 4;
+
+#if COSSIN_SIMD_SSE
+    __m128 value;
+
+    //==================================================================================================================
+    static VecF load(const float *data) noexcept   { return { _mm_loadu_ps(data) }; }
+    static VecF broadcast(float scalar) noexcept   { return { _mm_set1_ps(scalar) }; }
+    static VecF zero() noexcept                    { return { _mm_setzero_ps() }; }
+    void store(float *data) const noexcept         { _mm_storeu_ps(data, value); }
+
+    //==================================================================================================================
+    friend VecF operator+(VecF a, VecF b) noexcept { return { _mm_add_ps(a.value, b.value) }; }
+    friend VecF operator-(VecF a, VecF b) noexcept { return { _mm_sub_ps(a.value, b.value) }; }
+    friend VecF operator*(VecF a, VecF b) noexcept { return { _mm_mul_ps(a.value, b.value) }; }
+    friend VecF min(VecF a, VecF b) noexcept       { return { _mm_min_ps(a.value, b.value) }; }
+    friend VecF max(VecF a, VecF b) noexcept       { return { _mm_max_ps(a.value, b.value) }; }
+    friend VecF abs(VecF a) noexcept               { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.value) }; }
+#elif COSSIN_SIMD_NEON
+    float32x4_t value;
+
+    //==================================================================================================================
+    static VecF load(const float *data) noexcept   { return { vld1q_f32(data) }; }
+    static VecF broadcast(float scalar) noexcept   { return { vdupq_n_f32(scalar) }; }
+    static VecF zero() noexcept                    { return { vdupq_n_f32(0.0f) }; }
+    void store(float *data) const noexcept         { vst1q_f32(data, value); }
+
+    //==================================================================================================================
+    friend VecF operator+(VecF a, VecF b) noexcept { return { vaddq_f32(a.value, b.value) }; }
+    friend VecF operator-(VecF a, VecF b) noexcept { return { vsubq_f32(a.value, b.value) }; }
+    friend VecF operator*(VecF a, VecF b) noexcept { return { vmulq_f32(a.value, b.value) }; }
+    friend VecF min(VecF a, VecF b) noexcept       { return { vminq_f32(a.value, b.value) }; }
+    friend VecF max(VecF a, VecF b) noexcept       { return { vmaxq_f32(a.value, b.value) }; }
+    friend VecF abs(VecF a) noexcept               { return { vabsq_f32(a.value) }; }
+#else
+    float value[Size];
+
+    //==================================================================================================================
+    static VecF load(const float *data) noexcept   { return { { data[0], data[1], data[2], data[3] } }; }
+    static VecF broadcast(float scalar) noexcept   { return { { scalar, scalar, scalar, scalar } }; }
+    static VecF zero() noexcept                    { return broadcast(0.0f); }
+    void store(float *data) const noexcept         { std::copy(value, value + Size, data); }
+
+    //==================================================================================================================
+    template<class Fn>
+    static VecF map(VecF a, VecF b, Fn &&fn) noexcept
+    {
+        return { { fn(a.value[0], b.value[0]), fn(a.value[1], b.value[1]),
+                   fn(a.value[2], b.value[2]), fn(a.value[3], b.value[3]) } };
+    }
+
+    friend VecF operator+(VecF a, VecF b) noexcept { return map(a, b, [](float x, float y) { return x + y; }); }
+    friend VecF operator-(VecF a, VecF b) noexcept { return map(a, b, [](float x, float y) { return x - y; }); }
+    friend VecF operator*(VecF a, VecF b) noexcept { return map(a, b, [](float x, float y) { return x * y; }); }
+    friend VecF min(VecF a, VecF b) noexcept       { return map(a, b, [](float x, float y) { return std::min(x, y); }); }
+    friend VecF max(VecF a, VecF b) noexcept       { return map(a, b, [](float x, float y) { return std::max(x, y); }); }
+    friend VecF abs(VecF a) noexcept               { return map(a, a, [](float x, float)   { return std::abs(x); }); }
+#endif
+};
+
+/**
+ *  The double precision counterpart of VecF, holding two lanes.
+ *  32-bit ARM has no double precision NEON, there this falls back to a plain 2-double array.
+ */
+struct VecD
+{
+    static constexpr int Size = 2;
+
+#if COSSIN_SIMD_SSE
+    __m128d value;
+
+    //==================================================================================================================
+    static VecD load(const double *data) noexcept  { return { _mm_loadu_pd(data) }; }
+    static VecD broadcast(double scalar) noexcept  { return { _mm_set1_pd(scalar) }; }
+    static VecD zero() noexcept                    { return { _mm_setzero_pd() }; }
+    void store(double *data) const noexcept        { _mm_storeu_pd(data, value); }
+
+    //==================================================================================================================
+    friend VecD operator+(VecD a, VecD b) noexcept { return { _mm_add_pd(a.value, b.value) }; }
+    friend VecD operator-(VecD a, VecD b) noexcept { return { _mm_sub_pd(a.value, b.value) }; }
+    friend VecD operator*(VecD a, VecD b) noexcept { return { _mm_mul_pd(a.value, b.value) }; }
+    friend VecD min(VecD a, VecD b) noexcept       { return { _mm_min_pd(a.value, b.value) }; }
+    friend VecD max(VecD a, VecD b) noexcept       { return { _mm_max_pd(a.value, b.value) }; }
+    friend VecD abs(VecD a) noexcept               { return { _mm_andnot_pd(_mm_set1_pd(-0.0), a.value) }; }
+#elif COSSIN_SIMD_NEON_F64
+    float64x2_t value;
+
+    //==================================================================================================================
+    static VecD load(const double *data) noexcept  { return { vld1q_f64(data) }; }
+    static VecD broadcast(double scalar) noexcept  { return { vdupq_n_f64(scalar) }; }
+    static VecD zero() noexcept                    { return { vdupq_n_f64(0.0) }; }
+    void store(double *data) const noexcept        { vst1q_f64(data, value); }
+
+    //==================================================================================================================
+    friend VecD operator+(VecD a, VecD b) noexcept { return { vaddq_f64(a.value, b.value) }; }
+    friend VecD operator-(VecD a, VecD b) noexcept { return { vsubq_f64(a.value, b.value) }; }
+    friend VecD operator*(VecD a, VecD b) noexcept { return { vmulq_f64(a.value, b.value) }; }
+    friend VecD min(VecD a, VecD b) noexcept       { return { vminq_f64(a.value, b.value) }; }
+    friend VecD max(VecD a, VecD b) noexcept       { return { vmaxq_f64(a.value, b.value) }; }
+    friend VecD abs(VecD a) noexcept               { return { vabsq_f64(a.value) }; }
+#else
+    double value[Size];
+
+    //==================================================================================================================
+    static VecD load(const double *data) noexcept  { return { { data[0], data[1] } }; }
+    static VecD broadcast(double scalar) noexcept  { return { { scalar, scalar } }; }
+    static VecD zero() noexcept                    { return broadcast(0.0); }
+    void store(double *data) const noexcept        { std::copy(value, value + Size, data); }
+
+    //==================================================================================================================
+    template<class Fn>
+    static VecD map(VecD a, VecD b, Fn &&fn) noexcept
+    {
+        return { { fn(a.value[0], b.value[0]), fn(a.value[1], b.value[1]) } };
+    }
+
+    friend VecD operator+(VecD a, VecD b) noexcept { return map(a, b, [](double x, double y) { return x + y; }); }
+    friend VecD operator-(VecD a, VecD b) noexcept { return map(a, b, [](double x, double y) { return x - y; }); }
+    friend VecD operator*(VecD a, VecD b) noexcept { return map(a, b, [](double x, double y) { return x * y; }); }
+    friend VecD min(VecD a, VecD b) noexcept { return map(a, b, [](double x, double y) { return std::min(x, y); }); }
+    friend VecD max(VecD a, VecD b) noexcept { return map(a, b, [](double x, double y) { return std::max(x, y); }); }
+    friend VecD abs(VecD a) noexcept         { return map(a, a, [](double x, double)    { return std::abs(x); }); }
+#endif
+};
+
+//======================================================================================================================
+/** Adds up all lanes of a vector, meant for the end of a reduction and not for inner loops. */
+inline float sum(VecF vector) noexcept
+{
+    float lanes[VecF::Size];
+    vector.store(lanes);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+inline double sum(VecD vector) noexcept
+{
+    double lanes[VecD::Size];
+    vector.store(lanes);
+    return lanes[0] + lanes[1];
+}
+
+//======================================================================================================================
+/**
+ *  Approximates the base-2 logarithm of positive values, to within 2e-5 or about 0.0001 dB.
+ *  Zero and denormals come out at around -127 rather than minus infinity, negative values are not allowed.
+ */
+inline VecF fastLog2(VecF x) noexcept
+{
+#if COSSIN_SIMD_SSE
+    const __m128i bits    = _mm_castps_si128(x.value);
+    const VecF exponent   { _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127))) };
+    const VecF mantissa   { _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                                          _mm_set1_epi32(0x3f800000))) };
+#elif COSSIN_SIMD_NEON
+    const uint32x4_t bits = vreinterpretq_u32_f32(x.value);
+    const VecF exponent   { vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127))) };
+    const VecF mantissa   { vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)),
+                                                            vdupq_n_u32(0x3f800000))) };
+#else
+    VecF exponent, mantissa;
+
+    for (int i = 0; i < VecF::Size; ++i)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x.value[i], sizeof(bits));
+        exponent.value[i] = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+        std::memcpy(&mantissa.value[i], &bits, sizeof(bits));
+    }
+#endif
+
+    // The mantissa is in [1, 2), its logarithm is a fitted polynomial that goes through 0 at 1
+    const VecF t = mantissa - VecF::broadcast(1.0f);
+    VecF p = VecF::broadcast(0.0463846915f);
+    p = p * t + VecF::broadcast(-0.19626801f);
+    p = p * t + VecF::broadcast(0.417594419f);
+    p = p * t + VecF::broadcast(-0.709662369f);
+    p = p * t + VecF::broadcast(1.44196557f);
+
+    return exponent + p * t;
+}
+
+/**
+ *  Approximates two to the power of a value, to within 2e-7 relative.
+ *  The value is clamped to [-126, 126], which keeps the result a normal float.
+ */
+inline VecF fastExp2(VecF x) noexcept
+{
+    x = min(max(x, VecF::broadcast(-126.0f)), VecF::broadcast(126.0f));
+
+#if COSSIN_SIMD_SSE
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.value));
+    const VecF floored     { _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x.value), _mm_set1_ps(1.0f))) };
+    const VecF scale       { _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(floored.value),
+                                                                           _mm_set1_epi32(127)), 23)) };
+#elif COSSIN_SIMD_NEON
+    const float32x4_t truncated = vcvtq_f32_s32(vcvtq_s32_f32(x.value));
+    const uint32x4_t  one_bits  = vreinterpretq_u32_f32(vdupq_n_f32(1.0f));
+    const VecF floored { vsubq_f32(truncated, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(truncated, x.value),
+                                                                              one_bits))) };
+    const VecF scale   { vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(floored.value),
+                                                                     vdupq_n_s32(127)), 23)) };
+#else
+    VecF floored, scale;
+
+    for (int i = 0; i < VecF::Size; ++i)
+    {
+        floored.value[i] = std::floor(x.value[i]);
+
+        const auto bits = static_cast<std::uint32_t>(static_cast<int>(floored.value[i]) + 127) << 23;
+        std::memcpy(&scale.value[i], &bits, sizeof(bits));
+    }
+#endif
+
+    // The integer part goes straight into the exponent, the fraction in [0, 1) is a fitted polynomial
+    const VecF f = x - floored;
+    VecF p = VecF::broadcast(0.00188529822f);
+    p = p * f + VecF::broadcast(0.00897337651f);
+    p = p * f + VecF::broadcast(0.0558359289f);
+    p = p * f + VecF::broadcast(0.240152807f);
+    p = p * f + VecF::broadcast(0.693152472f);
+
+    return scale * (p * f + VecF::broadcast(1.0f));
+}
+
+//======================================================================================================================
+template<class> struct VecSelector;
+template<> struct VecSelector<float>  { using Type = VecF; };
+template<> struct VecSelector<double> { using Type = VecD; };
+
+/** Resolves to the vector type matching the given sample type. */
+template<class SampleType>
+using Vec = typename VecSelector<SampleType>::Type;
+
+//======================================================================================================================
+/** Finds the largest magnitude in a run of samples. */
+template<class SampleType>
+SampleType getMaxAbs(const SampleType *data, int numSamples) noexcept
+{
+    using Vector = Vec<SampleType>;
+
+    constexpr int step = Vector::Size;
+    const int vector_end = numSamples - numSamples % step;
+
+    Vector peaks = Vector::zero();
+
+    for (int i = 0; i < vector_end; i += step)
+    {
+        peaks = max(peaks, abs(Vector::load(data + i)));
+    }
+
+    SampleType lanes[step];
+    peaks.store(lanes);
+    SampleType peak = *std::max_element(lanes, lanes + step);
+
+    for (int i = vector_end; i < numSamples; ++i)
+    {
+        peak = std::max(peak, std::abs(data[i]));
+    }
+
+    return peak;
+}
+
+//======================================================================================================================
+/** The alignment of all scratch storage, the width of the native vector register. */
+inline constexpr std::size_t Alignment = 16;
+
+/** Rounds a number of elements up so that consecutive rows of it stay aligned. */
+template<class T>
+constexpr int getAlignedSize(int numElements) noexcept
+{
+    constexpr int lanes = static_cast<int>(Alignment / sizeof(T));
+    return (numElements + lanes - 1) / lanes * lanes;
+}
+
+/**
+ *  Dynamically sized storage whose first element sits on a vector boundary, or any larger boundary asked for.
+ *  Allocating is not realtime safe, it is meant to be done in prepareToPlay only.
+ */
+template<class T, std::size_t BlockAlignment = Alignment>
+class AlignedBlock
+{
+public:
+    AlignedBlock() = default;
+    AlignedBlock(AlignedBlock&&) noexcept = default;
+    AlignedBlock& operator=(AlignedBlock&&) noexcept = default;
+
+    //==================================================================================================================
+    void allocate(std::size_t numElements)
+    {
+        storage.assign(numElements + BlockAlignment / sizeof(T), T());
+
+        const auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        data = storage.data() + (BlockAlignment - address % BlockAlignment) % BlockAlignment / sizeof(T);
+    }
+
+    //==================================================================================================================
+    T* get() const noexcept { return data; }
+    T& operator[](std::size_t index) const noexcept { return data[index]; }
+
+private:
+    std::vector<T> storage;
+    T *data { nullptr };
+};
+}
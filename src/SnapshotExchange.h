@@ -0,0 +1,93 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SnapshotExchange.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ *  Hands snapshots of some trivially copyable state from one thread to another without locks or allocation,
+ *  usually from the audio thread to the editor.
+ *
+ *  A triple buffer: the producer and the consumer each own one slot, the third one sits in between and is swapped
+ *  atomically by either side. The producer never waits and never sees its slot read from, the consumer always gets
+ *  the latest complete snapshot and skips whichever it was too slow for.
+ *  There must be exactly one producer and one consumer thread.
+ *
+ *  @tparam Snapshot The snapshot type, slots are default constructed and then only ever assigned by the producer
+ */
+template<class Snapshot>
+class SnapshotExchange final
+{
+public:
+    //==================================================================================================================
+    /** Producer only, the slot to fill before calling publish(). */
+    Snapshot& getWriteSnapshot() noexcept { return slots[static_cast<std::size_t>(writeIndex)]; }
+
+    /** Producer only, hands the filled slot over. */
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange(writeIndex | FreshBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /** Producer only, determines whether the consumer picked up the last published snapshot. */
+    bool wasPickedUp() const noexcept
+    {
+        return (middle.load(std::memory_order_acquire) & FreshBit) == 0;
+    }
+
+    //==================================================================================================================
+    /** Consumer only, determines whether a pull() would fetch a new snapshot. */
+    bool hasUpdate() const noexcept
+    {
+        return (middle.load(std::memory_order_relaxed) & FreshBit) != 0;
+    }
+
+    /** Consumer only, fetches the latest snapshot if there is one and returns whether there was. */
+    bool pull() noexcept
+    {
+        if (!hasUpdate())
+        {
+            return false;
+        }
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /** Consumer only, the snapshot fetched with the last successful pull(). */
+    const Snapshot& getReadSnapshot() const noexcept { return slots[static_cast<std::size_t>(readIndex)]; }
+
+private:
+    static constexpr int IndexMask = 0b011;
+    static constexpr int FreshBit  = 0b100;
+
+    //==================================================================================================================
+    std::array<Snapshot, 3> slots;
+    alignas(64) std::atomic<int> middle { 1 };
+    alignas(64) int writeIndex { 0 };
+    alignas(64) int readIndex  { 2 };
+};
@@ -0,0 +1,296 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SpectrumAnalyser.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "SpectrumAnalyser.h"
+
+#include <numeric>
+
+//======================================================================================================================
+SpectrumAnalyser::SpectrumAnalyser()
+    : juce::Thread("Spectrum Analyser")
+{
+    fifoBuffer.resize(FifoSize);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopThread(1000);
+}
+
+//======================================================================================================================
+void SpectrumAnalyser::prepare(double newSampleRate) noexcept
+{
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+}
+
+template<class SampleType>
+void SpectrumAnalyser::push(const juce::AudioBuffer<SampleType> &buffer) noexcept
+{
+    const int num_channels = buffer.getNumChannels();
+
+    if (!active.load(std::memory_order_relaxed) || num_channels == 0)
+    {
+        return;
+    }
+
+    // Should the worker fall behind, whatever doesn't fit is dropped rather than waited for
+    const juce::AbstractFifo::ScopedWrite scope = fifo.write(buffer.getNumSamples());
+    const float gain = 1.0f / static_cast<float>(num_channels);
+
+    const auto mix_down = [&](int fifoIndex, int numSamples, int offset)
+    {
+        float *destination = fifoBuffer.data() + fifoIndex;
+
+        for (int i = 0; i < num_channels; ++i)
+        {
+            const SampleType *source = buffer.getReadPointer(i, offset);
+
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                if (i == 0)
+                {
+                    juce::FloatVectorOperations::multiply(destination, source, gain, numSamples);
+                }
+                else
+                {
+                    juce::FloatVectorOperations::addWithMultiply(destination, source, gain, numSamples);
+                }
+            }
+            else
+            {
+                for (int j = 0; j < numSamples; ++j)
+                {
+                    destination[j] = (i == 0 ? 0.0f : destination[j]) + static_cast<float>(source[j]) * gain;
+                }
+            }
+        }
+    };
+
+    mix_down(scope.startIndex1, scope.blockSize1, 0);
+    mix_down(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+//======================================================================================================================
+void SpectrumAnalyser::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == active.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    active.store(shouldBeActive, std::memory_order_relaxed);
+
+    if (shouldBeActive)
+    {
+        startThread();
+    }
+    else
+    {
+        stopThread(1000);
+    }
+}
+
+void SpectrumAnalyser::setFftOrder(int newOrder) noexcept
+{
+    fftOrder.store(juce::jlimit(MinFftOrder, MaxFftOrder, newOrder), std::memory_order_relaxed);
+}
+
+void SpectrumAnalyser::setOverlap(int newOverlap) noexcept
+{
+    overlap.store(juce::jmax(1, newOverlap), std::memory_order_relaxed);
+}
+
+void SpectrumAnalyser::setSmoothingSeconds(float newSeconds) noexcept
+{
+    smoothingTime.store(juce::jmax(0.0f, newSeconds), std::memory_order_relaxed);
+}
+
+void SpectrumAnalyser::setPeakHold(float holdSeconds, float decayDecibelsPerSecond) noexcept
+{
+    peakHoldTime .store(juce::jmax(0.0f, holdSeconds),            std::memory_order_relaxed);
+    peakDecayRate.store(juce::jmax(0.0f, decayDecibelsPerSecond), std::memory_order_relaxed);
+}
+
+//======================================================================================================================
+void SpectrumAnalyser::run()
+{
+    // Whatever is still in there was pushed the last time the analyser was active
+    {
+        const juce::AbstractFifo::ScopedRead stale = fifo.read(fifo.getNumReady());
+    }
+
+    fft.reset();
+
+    while (!threadShouldExit())
+    {
+        const int    order = fftOrder  .load(std::memory_order_relaxed);
+        const double rate  = sampleRate.load(std::memory_order_relaxed);
+
+        if (!fft || fft->getSize() != (1 << order) || rate != frameSampleRate)
+        {
+            configure(order, rate);
+        }
+
+        const int fft_size = fft->getSize();
+        const int hop_size = juce::jmax(1, fft_size / juce::jmin(fft_size, overlap.load(std::memory_order_relaxed)));
+        const int to_read  = juce::jmin(fifo.getNumReady(), hop_size - samplesSinceFrame);
+
+        if (to_read <= 0)
+        {
+            wait(10);
+            continue;
+        }
+
+        const juce::AbstractFifo::ScopedRead scope = fifo.read(to_read);
+
+        const auto append = [this, fft_size](int fifoIndex, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                history[static_cast<std::size_t>(historyPosition)] = fifoBuffer[static_cast<std::size_t>(fifoIndex + i)];
+                historyPosition = (historyPosition + 1) % fft_size;
+            }
+        };
+
+        append(scope.startIndex1, scope.blockSize1);
+        append(scope.startIndex2, scope.blockSize2);
+
+        samplesSinceFrame += to_read;
+
+        if (samplesSinceFrame >= hop_size)
+        {
+            samplesSinceFrame = 0;
+            analyse(hop_size);
+        }
+    }
+}
+
+void SpectrumAnalyser::configure(int order, double rate)
+{
+    const int size = 1 << order;
+
+    fft = std::make_unique<juce::dsp::FFT>(order);
+    history.assign(static_cast<std::size_t>(size), 0.0f);
+    window .assign(static_cast<std::size_t>(size), 0.0f);
+    fftData.assign(static_cast<std::size_t>(size) * 2, 0.0f);
+
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<std::size_t>(size),
+                                                             juce::dsp::WindowingFunction<float>::hann, false);
+
+    // Scaled so that a full scale sine reads 0dB
+    windowGain = 2.0f / std::accumulate(window.begin(), window.end(), 0.0f);
+
+    // The edges of the log-spaced output bins, in FFT bins
+    const double bin_width = rate / size;
+
+    for (int i = 0; i <= SpectrumFrame::NumBins; ++i)
+    {
+        const double proportion = static_cast<double>(i) / SpectrumFrame::NumBins;
+        const double frequency  = MinFrequency * std::pow(MaxFrequency / MinFrequency, proportion);
+        binEdges[static_cast<std::size_t>(i)] = static_cast<float>(frequency / bin_width);
+    }
+
+    frame.magnitudes.fill(FloorDecibels);
+    frame.peaks     .fill(FloorDecibels);
+    peakAges.fill(0.0f);
+
+    frameSampleRate   = rate;
+    historyPosition   = 0;
+    samplesSinceFrame = 0;
+}
+
+void SpectrumAnalyser::analyse(int hopSize)
+{
+    const int size     = fft->getSize();
+    const int nyquist  = size / 2;
+    const int oldest   = historyPosition;
+    const int num_tail = size - oldest;
+
+    // Unroll the history oldest first while applying the window, the upper half is the FFT's working space
+    juce::FloatVectorOperations::multiply(fftData.data(), history.data() + oldest, window.data(), num_tail);
+    juce::FloatVectorOperations::multiply(fftData.data() + num_tail, history.data(), window.data() + num_tail,
+                                          oldest);
+    std::fill(fftData.begin() + size, fftData.end(), 0.0f);
+
+    fft->performFrequencyOnlyForwardTransform(fftData.data());
+
+    const float hop_seconds = static_cast<float>(hopSize / frameSampleRate);
+    const float smoothing   = std::exp(-hop_seconds / juce::jmax(1e-3f, smoothingTime.load(std::memory_order_relaxed)));
+    const float hold_time   = peakHoldTime .load(std::memory_order_relaxed);
+    const float decay       = peakDecayRate.load(std::memory_order_relaxed) * hop_seconds;
+
+    for (std::size_t i = 0; i < SpectrumFrame::NumBins; ++i)
+    {
+        const float low  = binEdges[i];
+        const float high = binEdges[i + 1];
+        float magnitude  = 0.0f;
+
+        if (low >= static_cast<float>(nyquist))
+        {
+            magnitude = 0.0f;
+        }
+        else if (static_cast<int>(high) - static_cast<int>(low) < 1)
+        {
+            // Down low, output bins are narrower than FFT bins, so these are interpolated at their centre
+            const float centre    = std::sqrt(low * high);
+            const int   index     = static_cast<int>(centre);
+            const float fraction  = centre - static_cast<float>(index);
+            const float magnitude_low  = fftData[static_cast<std::size_t>(index)];
+            const float magnitude_high = fftData[static_cast<std::size_t>(juce::jmin(index + 1, nyquist))];
+            magnitude = magnitude_low + (magnitude_high - magnitude_low) * fraction;
+        }
+        else
+        {
+            // Further up, many FFT bins fall into one output bin and the loudest of them stands for all
+            const int first = static_cast<int>(std::ceil(low));
+            const int last  = juce::jmin(static_cast<int>(high), nyquist);
+            magnitude = *std::max_element(fftData.begin() + first, fftData.begin() + last + 1);
+        }
+
+        const float decibels = juce::Decibels::gainToDecibels(magnitude * windowGain, FloorDecibels);
+        float &smoothed = frame.magnitudes[i];
+        float &peak     = frame.peaks[i];
+
+        // Rises are shown right away, falls are smoothed
+        smoothed = decibels >= smoothed ? decibels : decibels + (smoothed - decibels) * smoothing;
+
+        if (decibels >= peak)
+        {
+            peak        = decibels;
+            peakAges[i] = 0.0f;
+        }
+        else if ((peakAges[i] += hop_seconds) > hold_time)
+        {
+            peak = juce::jmax(smoothed, peak - decay);
+        }
+    }
+
+    frames.getWriteSnapshot() = frame;
+    frames.publish();
+}
+
+//======================================================================================================================
+template void SpectrumAnalyser::push(const juce::AudioBuffer<float>&) noexcept;
+template void SpectrumAnalyser::push(const juce::AudioBuffer<double>&) noexcept;
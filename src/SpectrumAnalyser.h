@@ -0,0 +1,135 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SpectrumAnalyser.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include "SnapshotExchange.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/** One analysed frame, in dBFS on a logarithmic frequency axis from MinFrequency to MaxFrequency. */
+struct SpectrumFrame
+{
+    static constexpr int NumBins = 256;
+
+    //==================================================================================================================
+    /** The smoothed spectrum. */
+    std::array<float, NumBins> magnitudes {};
+
+    /** The held peaks of the spectrum. */
+    std::array<float, NumBins> peaks {};
+};
+
+/**
+ *  A real-time spectrum analyser, split between the audio thread and a background worker.
+ *
+ *  The audio thread only mixes the block down to mono and writes it into a lock-free FIFO, nothing else.
+ *  The worker thread reads from it, runs a Hann-windowed FFT every hop, smooths the result, holds its peaks and
+ *  reduces it to a fixed number of log-spaced bins, which it publishes as a SpectrumFrame.
+ *
+ *  The analyser is only active while someone looks at it; inactive, push() returns right away and no worker runs.
+ *  Transform size and overlap can be changed at any time, the worker picks them up with its next frame and is the only
+ *  one ever allocating.
+ */
+class SpectrumAnalyser final : private juce::Thread
+{
+public:
+    static constexpr int   MinFftOrder     = 9;
+    static constexpr int   MaxFftOrder     = 14;
+    static constexpr int   DefaultFftOrder = 12;
+    static constexpr int   DefaultOverlap  = 4;
+    static constexpr int   FifoSize        = 1 << 15;
+    static constexpr float MinFrequency    = 20.0f;
+    static constexpr float MaxFrequency    = 20000.0f;
+    static constexpr float FloorDecibels   = -120.0f;
+
+    //==================================================================================================================
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    //==================================================================================================================
+    void prepare(double sampleRate) noexcept;
+
+    /** Feeds a block to the analyser, realtime safe and free while the analyser is inactive. */
+    template<class SampleType>
+    void push(const juce::AudioBuffer<SampleType>&) noexcept;
+
+    //==================================================================================================================
+    /** Starts or stops the worker, call this from the message thread whenever a view opens or closes. */
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept { return active.load(std::memory_order_relaxed); }
+
+    /** Sets the transform size as a power of two, between MinFftOrder and MaxFftOrder. */
+    void setFftOrder(int newOrder) noexcept;
+
+    /** Sets how many transforms overlap each window, 1 meaning none. */
+    void setOverlap(int newOverlap) noexcept;
+
+    /** Sets the time it takes the spectrum to fall by about two thirds of the way to a lower reading. */
+    void setSmoothingSeconds(float newSeconds) noexcept;
+
+    /** Sets how long peaks are held, and how fast in dB per second they fall afterwards. */
+    void setPeakHold(float holdSeconds, float decayDecibelsPerSecond) noexcept;
+
+    //==================================================================================================================
+    SnapshotExchange<SpectrumFrame>& getFrames() noexcept { return frames; }
+
+private:
+    SnapshotExchange<SpectrumFrame> frames;
+    juce::AbstractFifo fifo { FifoSize };
+    std::vector<float> fifoBuffer;
+
+    std::atomic<bool>   active          { false };
+    std::atomic<double> sampleRate      { 44100.0 };
+    std::atomic<int>    fftOrder        { DefaultFftOrder };
+    std::atomic<int>    overlap         { DefaultOverlap };
+    std::atomic<float>  smoothingTime   { 0.2f };
+    std::atomic<float>  peakHoldTime    { 1.0f };
+    std::atomic<float>  peakDecayRate   { 20.0f };
+
+    // Worker thread only from here on
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> history;
+    std::vector<float> window;
+    std::vector<float> fftData;
+    std::array<float, SpectrumFrame::NumBins + 1> binEdges {};
+    std::array<float, SpectrumFrame::NumBins> peakAges {};
+    SpectrumFrame frame;
+    double frameSampleRate { 0.0 };
+    float windowGain { 1.0f };
+    int historyPosition { 0 };
+    int samplesSinceFrame { 0 };
+
+    //==================================================================================================================
+    void run() override;
+    void configure(int order, double rate);
+    void analyse(int hopSize);
+};
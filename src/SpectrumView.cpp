@@ -0,0 +1,88 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SpectrumView.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "SpectrumView.h"
+#include "PluginEditor.h"
+
+//======================================================================================================================
+void SpectrumView::setFrame(const SpectrumFrame &newFrame)
+{
+    frame = newFrame;
+    repaint();
+}
+
+//======================================================================================================================
+void SpectrumView::paint(juce::Graphics &g)
+{
+    const juce::LookAndFeel &lf = getLookAndFeel();
+    const juce::Colour colour_curve = lf.findColour(CossinAudioProcessorEditor::ColourComponentForegroundId);
+    
+    g.setColour(colour_curve.withAlpha(0.25f));
+    g.fillPath(createPath(frame.magnitudes, true));
+    g.setColour(colour_curve);
+    g.strokePath(createPath(frame.magnitudes, false), juce::PathStrokeType(1.5f));
+    
+    g.setColour(lf.findColour(CossinAudioProcessorEditor::ColourFontId).withAlpha(0.5f));
+    g.strokePath(createPath(frame.peaks, false), juce::PathStrokeType(1.0f));
+}
+
+//======================================================================================================================
+juce::Path SpectrumView::createPath(const std::array<float, SpectrumFrame::NumBins> &decibels, bool closed) const
+{
+    const auto width  = static_cast<float>(getWidth());
+    const auto height = static_cast<float>(getHeight());
+    const float bin_width = width / static_cast<float>(SpectrumFrame::NumBins);
+    
+    juce::Path path;
+    
+    if (closed)
+    {
+        path.startNewSubPath(0.0f, height);
+    }
+    
+    for (std::size_t i = 0; i < decibels.size(); ++i)
+    {
+        const float x = (static_cast<float>(i) + 0.5f) * bin_width;
+        const float y = juce::jmap(juce::jlimit(MinDecibels, MaxDecibels, decibels[i]), MinDecibels, MaxDecibels,
+                                   height, 0.0f);
+        
+        if (i == 0 && !closed)
+        {
+            path.startNewSubPath(x, y);
+        }
+        else
+        {
+            path.lineTo(x, y);
+        }
+    }
+    
+    if (closed)
+    {
+        path.lineTo(width, height);
+        path.closeSubPath();
+    }
+    
+    return path;
+}
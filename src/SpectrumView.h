@@ -0,0 +1,53 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SpectrumView.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "SpectrumAnalyser.h"
+
+/**
+ *  Draws the frames of a SpectrumAnalyser, the smoothed spectrum as a filled curve and its peaks as a line above.
+ *  The view only displays what it is handed, pulling frames is up to its owner.
+ */
+class SpectrumView final : public juce::Component
+{
+public:
+    static constexpr float MinDecibels = -96.0f;
+    static constexpr float MaxDecibels =   6.0f;
+    
+    //==================================================================================================================
+    void setFrame(const SpectrumFrame&);
+    
+    //==================================================================================================================
+    void paint(juce::Graphics&) override;
+    
+private:
+    SpectrumFrame frame;
+    
+    //==================================================================================================================
+    juce::Path createPath(const std::array<float, SpectrumFrame::NumBins>&, bool closed) const;
+};
@@ -0,0 +1,108 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   SubBlockScheduler.h
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#pragma once
+
+#include "ProcessingCore.h"
+
+/**
+ *  Splits host blocks into sub-blocks whenever the parameters moved since the previous block.
+ *
+ *  Hosts hand over automation as one value per block, which belongs to the end of the block. Jumping to it at the
+ *  start of a 2048 sample render block would put every change up to a block too early, so instead the block is cut
+ *  into sub-blocks of at most the maximum sub-block size, each getting the parameters interpolated to its own end.
+ *  If nothing changed the whole block is passed through in one go.
+ *
+ *  Sub-blocks are views onto the host buffer, nothing is copied or allocated.
+ */
+class SubBlockScheduler final
+{
+public:
+    static constexpr int DefaultMaxSubBlockSize = 32;
+
+    //==================================================================================================================
+    void setMaximumSubBlockSize(int newSize) noexcept
+    {
+        jassert(newSize > 0);
+        maxSubBlockSize = juce::jmax(1, newSize);
+    }
+
+    int getMaximumSubBlockSize() const noexcept { return maxSubBlockSize; }
+
+    /** Sets the parameters the next block starts from, without any interpolation. */
+    void reset(const ProcessingParameters &parameters) noexcept
+    {
+        lastParameters = parameters;
+    }
+
+    //==================================================================================================================
+    /**
+     *  Processes a block, invoking the callback once per sub-block.
+     *
+     *  @param main       The main bus buffer
+     *  @param sidechain  The sidechain bus buffer, may have no channels
+     *  @param parameters The parameters as read at the start of this block
+     *  @param callback   The callback taking the main and sidechain sub-buffers and their parameters
+     */
+    template<class SampleType, class Callback>
+    void process(juce::AudioBuffer<SampleType> &main, const juce::AudioBuffer<SampleType> &sidechain,
+                 const ProcessingParameters &parameters, Callback &&callback)
+    {
+        const int num_samples = main.getNumSamples();
+
+        if (parameters == lastParameters || num_samples <= maxSubBlockSize)
+        {
+            lastParameters = parameters;
+            callback(main, sidechain, parameters);
+            return;
+        }
+
+        const int num_sub_blocks = (num_samples + maxSubBlockSize - 1) / maxSubBlockSize;
+
+        for (int i = 0; i < num_sub_blocks; ++i)
+        {
+            const int start       = i * maxSubBlockSize;
+            const int sub_samples = juce::jmin(maxSubBlockSize, num_samples - start);
+
+            juce::AudioBuffer<SampleType> main_view(main.getArrayOfWritePointers(), main.getNumChannels(), start,
+                                                    sub_samples);
+
+            // The view needs non-const pointers, it is never written to though
+            const juce::AudioBuffer<SampleType> sidechain_view(
+                const_cast<SampleType* const*>(sidechain.getArrayOfReadPointers()), sidechain.getNumChannels(),
+                start, sub_samples);
+
+            const float proportion = static_cast<float>(start + sub_samples) / static_cast<float>(num_samples);
+            callback(main_view, sidechain_view, ProcessingParameters::interpolate(lastParameters, parameters,
+                                                                                  proportion));
+        }
+
+        lastParameters = parameters;
+    }
+
+private:
+    ProcessingParameters lastParameters;
+    int maxSubBlockSize { DefaultMaxSubBlockSize };
+};
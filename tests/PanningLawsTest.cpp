@@ -0,0 +1,140 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   PanningLawsTest.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+#include "PanningLaws.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+// How many panning positions the sweep checks between -1 and 1, not a multiple of the table resolution so that most
+// of them fall between two table entries
+constexpr int NumSweepSteps = 200001;
+
+// What interpolating in float may be off by from the closed form, about -120 dB relative to unity
+constexpr double Tolerance = 1e-6;
+
+constexpr const char *lawNames[] {
+    "Linear", "Square", "Sinusoidal", "Constant Power", "Compromise", "Linear Attenuated"
+};
+
+static_assert(std::size(lawNames) == panlaw::NumLaws, "Every panning law needs a name");
+
+//======================================================================================================================
+// The laws written out again with the standard library, independent of the constexpr approximations the tables use
+double getClosedForm(int law, double position)
+{
+    const double pi   = 3.14159265358979323846;
+    const double sine = std::sin(position * pi / 2.0);
+
+    switch (law)
+    {
+        case panlaw::Linear:           return position * 2.0;
+        case panlaw::Square:           return std::sqrt(position * 2.0);
+        case panlaw::Sinusoidal:       return sine * std::sqrt(2.0);
+        case panlaw::ConstantPower:    return sine;
+        case panlaw::Compromise:       return std::sqrt(position * sine);
+        case panlaw::LinearAttenuated: return position;
+        default:                       return 0.0;
+    }
+}
+
+// The square root's slope is unbounded towards 0, so linear interpolation can't get within the tolerance there; the
+// Square law is held to the error bound of interpolating it over the table segment the position falls into instead
+double getInterpolationBound(int law, double position)
+{
+    if (law != panlaw::Square)
+    {
+        return 0.0;
+    }
+
+    const double step  = 1.0 / panlaw::TableResolution;
+    const double start = std::floor(position / step) * step;
+
+    // On the first segment the largest distance between sqrt(x) and its chord is sqrt(step) / 4, further along it is
+    // step^2 / 8 times the largest curvature |sqrt''(x)| = x^(-3/2) / 4 on the segment
+    const double bound = start == 0.0 ? std::sqrt(step) / 4.0 : step * step / (32.0 * start * std::sqrt(start));
+    return bound * std::sqrt(2.0);
+}
+
+//======================================================================================================================
+/**
+ *  Sweeps the panning from left to right and compares the interpolated gain of a left and a right channel with the
+ *  closed form of the law at every step.
+ */
+bool testSweep(int law)
+{
+    double max_error = 0.0;
+    bool passed      = true;
+
+    for (int i = 0; i < NumSweepSteps; ++i)
+    {
+        const float panning = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(NumSweepSteps - 1);
+
+        for (const float side : { -1.0f, 1.0f })
+        {
+            const double position = std::clamp((static_cast<double>(panning) * side + 1.0) * 0.5, 0.0, 1.0);
+            const double expected = getClosedForm(law, position);
+            const double gain     = panlaw::getGain(law, side, panning);
+            const double error    = std::abs(gain - expected);
+
+            max_error = std::max(max_error, error);
+
+            if (error > Tolerance + getInterpolationBound(law, position))
+            {
+                std::printf("  %s, panning %f, side %+.0f: %.9f instead of %.9f\n", lawNames[law],
+                            static_cast<double>(panning), static_cast<double>(side), gain, expected);
+                passed = false;
+            }
+        }
+
+        if (!passed)
+        {
+            break;
+        }
+    }
+
+    std::printf("  %s, largest error %.3g\n", lawNames[law], max_error);
+    return passed;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    int failures = 0;
+
+    for (int law = 0; law < panlaw::NumLaws; ++law)
+    {
+        const bool passed = testSweep(law);
+        std::printf("%s matches its closed form across the sweep: %s\n", lawNames[law], passed ? "passed" : "FAILED");
+
+        failures += !passed;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,437 @@
+/**
+    ===============================================================
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any internal version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+    Copyright (c) 2019 ElandaSunshine
+    ===============================================================
+
+    @author Elanda (elanda@elandasunshine.xyz)
+    @file   ProcessingCoreTest.cpp
+    @date   17, October 2026
+
+    ===============================================================
+ */
+
+
+#include "ProcessingCore.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr int    BlockSize  = 256;
+constexpr float  Mix        = 0.5f;
+
+// What the module adds to every sample, independent of its input
+constexpr float TailLevel = 0.25f;
+
+//======================================================================================================================
+// A module that never rings out, like a reverb with an endless tail; it may also report latency without adding any
+class TailModule
+{
+public:
+    explicit TailModule(int latency) noexcept
+        : latencySamples(latency)
+    {}
+
+    template<class SampleType>
+    void processEffect(int, juce::AudioBuffer<SampleType> &buffer, juce::MidiBuffer&)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                buffer.setSample(ch, i, buffer.getSample(ch, i) + static_cast<SampleType>(TailLevel));
+            }
+        }
+    }
+
+    void beginPlayback(int, double, int) {}
+    void finishPlayback(int) {}
+
+    int getLatencySamples(int) const noexcept { return latencySamples; }
+    int getTailSamples(int) const noexcept { return 1 << 30; }
+
+private:
+    int latencySamples;
+};
+
+//======================================================================================================================
+/**
+ *  One block of loud input, then silence with the chain still ringing. Once the dry delay ran empty the output must be
+ *  the wet tail scaled by the mix, with nothing of the loud block blended in again.
+ */
+template<class SampleType>
+bool testNoDryResidue(int latency)
+{
+    using Core = ProcessingCore<SampleType, TailModule>;
+
+    TailModule module(latency);
+    SidechainKey key;
+    Core core(key);
+
+    auto stack = std::make_unique<typename Core::Stack>();
+    stack->setSlots({ { &module, 0, module.getTailSamples(0), latency } });
+    core.publishModuleStack(std::move(stack));
+
+    ProcessingParameters parameters;
+    parameters.mix         = Mix;
+    parameters.processMode = static_cast<int>(ProcessMode::Stack);
+
+    core.prepare(SampleRate, juce::AudioChannelSet::stereo(), BlockSize, parameters);
+
+    juce::AudioBuffer<SampleType> buffer(2, BlockSize);
+    const juce::AudioBuffer<SampleType> sidechain;
+
+    // Enough loud blocks to get past the crossfade to the published stack, the last of them being the one that counts
+    for (int i = 0; i < 8; ++i)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), SampleType(1), BlockSize);
+        }
+
+        core.process(buffer, sidechain, parameters, Core::isSilent(buffer));
+    }
+
+    const int num_silent_blocks = latency / BlockSize + 4;
+    const SampleType expected   = static_cast<SampleType>(TailLevel * Mix);
+    bool passed = true;
+
+    for (int block = 0; block < num_silent_blocks; ++block)
+    {
+        buffer.clear();
+        core.process(buffer, sidechain, parameters, true);
+
+        for (int i = 0; i < BlockSize; ++i)
+        {
+            // Until the latency passed, the dry delay still legitimately plays back the loud block
+            if (block * BlockSize + i < latency)
+            {
+                continue;
+            }
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                const SampleType sample = buffer.getSample(ch, i);
+
+                if (std::abs(sample - expected) > SampleType(1e-5))
+                {
+                    std::printf("  latency %d, silent block %d, sample %d, channel %d: %f instead of %f\n", latency,
+                                block, i, ch, static_cast<double>(sample), static_cast<double>(expected));
+                    passed = false;
+                    break;
+                }
+            }
+
+            if (!passed)
+            {
+                break;
+            }
+        }
+    }
+
+    core.release();
+    return passed;
+}
+
+//======================================================================================================================
+/**
+ *  Loud input, then silence until the dry delay ran empty, then the latency grows while silent and loud input resumes.
+ *  Until the new latency passed, the dry share must be silence and not the loud block that preceded the silence.
+ */
+template<class SampleType>
+bool testNoResidueAfterLatencyIncrease(int latency, int newLatency)
+{
+    using Core = ProcessingCore<SampleType, TailModule>;
+
+    TailModule module(latency);
+    SidechainKey key;
+    Core core(key);
+
+    auto stack = std::make_unique<typename Core::Stack>();
+    stack->setSlots({ { &module, 0, module.getTailSamples(0), latency } });
+
+    // Kept to change the latency later on, like the processor does when a module reports a new one
+    typename Core::Stack *const published_stack = stack.get();
+    core.publishModuleStack(std::move(stack));
+
+    ProcessingParameters parameters;
+    parameters.mix         = Mix;
+    parameters.processMode = static_cast<int>(ProcessMode::Stack);
+
+    core.prepare(SampleRate, juce::AudioChannelSet::stereo(), BlockSize, parameters);
+
+    juce::AudioBuffer<SampleType> buffer(2, BlockSize);
+    const juce::AudioBuffer<SampleType> sidechain;
+
+    const auto fill_loud = [&buffer]()
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), SampleType(1), BlockSize);
+        }
+    };
+
+    for (int i = 0; i < 8; ++i)
+    {
+        fill_loud();
+        core.process(buffer, sidechain, parameters, Core::isSilent(buffer));
+    }
+
+    for (int block = 0; block < latency / BlockSize + 4; ++block)
+    {
+        buffer.clear();
+        core.process(buffer, sidechain, parameters, true);
+    }
+
+    published_stack->setLatencySamples(0, newLatency);
+
+    // The input was silent for longer than either latency, so the wet signal is all there is until the new one passed
+    const SampleType expected_wet = static_cast<SampleType>((1.0f + TailLevel) * Mix);
+    bool passed = true;
+
+    for (int block = 0; block < newLatency / BlockSize + 1 && passed; ++block)
+    {
+        fill_loud();
+        core.process(buffer, sidechain, parameters, false);
+
+        for (int i = 0; i < BlockSize && block * BlockSize + i < newLatency && passed; ++i)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                const SampleType sample = buffer.getSample(ch, i);
+
+                if (std::abs(sample - expected_wet) > SampleType(1e-5))
+                {
+                    std::printf("  latency %d to %d, block %d, sample %d, channel %d: %f instead of %f\n", latency,
+                                newLatency, block, i, ch, static_cast<double>(sample),
+                                static_cast<double>(expected_wet));
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    core.release();
+    return passed;
+}
+
+//======================================================================================================================
+// A module with latency and state of its own per instance and channel, either an insert that shapes the whole signal or
+// a wet-only send like a reverb
+class ChainModule
+{
+public:
+    ChainModule(bool shouldBeInsert, int latency)
+        : isInsert(shouldBeInsert),
+          latencySamples(latency)
+    {
+        for (auto &instance_lines : lines)
+        {
+            for (std::vector<double> &line : instance_lines)
+            {
+                line.assign(static_cast<std::size_t>(latency) + 1, 0.0);
+            }
+        }
+    }
+
+    template<class SampleType>
+    void processEffect(int instance, juce::AudioBuffer<SampleType> &buffer, juce::MidiBuffer&)
+    {
+        const auto index = static_cast<std::size_t>(instance);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            std::vector<double> &line = lines[index][static_cast<std::size_t>(ch)];
+            double &state = states[index][static_cast<std::size_t>(ch)];
+            int &position = positions[index][static_cast<std::size_t>(ch)];
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                line[static_cast<std::size_t>(position)] = static_cast<double>(buffer.getSample(ch, i));
+                position = (position + 1) % static_cast<int>(line.size());
+
+                const double delayed = line[static_cast<std::size_t>(position)];
+                state = isInsert ? delayed / (1.0 + std::abs(delayed)) : 0.6 * state + 0.4 * delayed;
+                buffer.setSample(ch, i, static_cast<SampleType>(state));
+            }
+        }
+    }
+
+    int getLatencySamples(int) const noexcept { return latencySamples; }
+    int getTailSamples(int) const noexcept { return isInsert ? latencySamples : latencySamples + 4096; }
+
+private:
+    bool isInsert;
+    int latencySamples;
+
+    // The stack runs instance 0, the graph instance 1, each on two channels
+    std::array<std::array<std::vector<double>, 2>, 2> lines;
+    std::array<std::array<double, 2>, 2> states {};
+    std::array<std::array<int, 2>, 2> positions {};
+};
+
+/**
+ *  The chain the processor runs by default, inserts and sends mixed in at 0.3, run once as a stack and once as the
+ *  graph of it; both must sound the same, also while mix and bypass change.
+ */
+template<class SampleType>
+bool testStackMatchesGraph(int numWorkers)
+{
+    using Stack = ModuleStack<SampleType, ChainModule>;
+    using Graph = ModuleGraph<SampleType, ChainModule>;
+
+    constexpr float SendMix  = 0.3f;
+    constexpr int NumBlocks  = 64;
+    constexpr int MaxLatency = 256;
+
+    std::array<ChainModule, 5> modules {
+        ChainModule(true, 0), ChainModule(false, 37), ChainModule(false, 0), ChainModule(true, 64),
+        ChainModule(false, 5)
+    };
+
+    std::vector<typename Stack::Slot> stack_slots;
+    std::vector<typename Graph::Node> graph_slots;
+
+    for (ChainModule &module : modules)
+    {
+        stack_slots.push_back({ &module, 0, module.getTailSamples(0), module.getLatencySamples(0) });
+        graph_slots.push_back({ &module, 1, module.getTailSamples(1), module.getLatencySamples(1) });
+    }
+
+    Stack stack;
+    Graph graph;
+    stack.setSlots(stack_slots);
+    graph.setChain(graph_slots);
+
+    const auto set_mix = [&stack, &graph](int slot, float mix, bool isBypassed)
+    {
+        stack.setMix(slot, mix);
+        stack.setBypassed(slot, isBypassed);
+        graph.setChainMix(slot, mix, isBypassed);
+    };
+
+    for (int i = 0; i < static_cast<int>(modules.size()); ++i)
+    {
+        set_mix(i, i == 0 || i == 3 ? 1.0f : SendMix, false);
+    }
+
+    stack.prepare(2, BlockSize, MaxLatency);
+    graph.prepare(2, BlockSize, MaxLatency, numWorkers);
+
+    if (stack.getLatencySamples() != graph.updateLatency())
+    {
+        std::printf("  latency %d in the stack, %d in the graph\n", stack.getLatencySamples(), graph.updateLatency());
+        return false;
+    }
+
+    juce::AudioBuffer<SampleType> stack_buffer(2, BlockSize);
+    juce::AudioBuffer<SampleType> graph_buffer(2, BlockSize);
+    juce::Random random(42);
+    bool passed = true;
+
+    for (int block = 0; block < NumBlocks && passed; ++block)
+    {
+        // Bypass a send and an insert for a while and move the mix of another, all ramped
+        if (block == 16) { set_mix(1, SendMix, true); set_mix(3, 1.0f, true); }
+        if (block == 24) { set_mix(4, 0.8f, false); }
+        if (block == 40) { set_mix(1, SendMix, false); set_mix(3, 0.5f, false); }
+
+        const int num_samples = BlockSize - (block % 3) * 50;
+        stack_buffer.setSize(2, num_samples, false, false, true);
+        graph_buffer.setSize(2, num_samples, false, false, true);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < num_samples; ++i)
+            {
+                const auto sample = static_cast<SampleType>(random.nextFloat() * 2.0f - 1.0f);
+                stack_buffer.setSample(ch, i, sample);
+                graph_buffer.setSample(ch, i, sample);
+            }
+        }
+
+        stack.process(stack_buffer);
+        graph.process(graph_buffer);
+
+        for (int ch = 0; ch < 2 && passed; ++ch)
+        {
+            for (int i = 0; i < num_samples; ++i)
+            {
+                const SampleType difference = std::abs(stack_buffer.getSample(ch, i) - graph_buffer.getSample(ch, i));
+
+                if (difference > SampleType(1e-5))
+                {
+                    std::printf("  %d workers, block %d, sample %d, channel %d: %f in the stack, %f in the graph\n",
+                                numWorkers, block, i, ch, static_cast<double>(stack_buffer.getSample(ch, i)),
+                                static_cast<double>(graph_buffer.getSample(ch, i)));
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    graph.release();
+    stack.release();
+    return passed;
+}
+}
+
+//======================================================================================================================
+int main()
+{
+    int failures = 0;
+
+    for (const int latency : { 0, 100, BlockSize, 3 * BlockSize + 17 })
+    {
+        const bool float_passed  = testNoDryResidue<float> (latency);
+        const bool double_passed = testNoDryResidue<double>(latency);
+        std::printf("No dry residue after silence, latency %4d: float %s, double %s\n", latency,
+                    float_passed ? "passed" : "FAILED", double_passed ? "passed" : "FAILED");
+
+        failures += !float_passed + !double_passed;
+    }
+
+    for (const int latency : { 0, 100 })
+    {
+        const int new_latency = 3 * BlockSize + 17;
+
+        const bool float_passed  = testNoResidueAfterLatencyIncrease<float> (latency, new_latency);
+        const bool double_passed = testNoResidueAfterLatencyIncrease<double>(latency, new_latency);
+        std::printf("No residue after latency grew while silent, latency %3d to %d: float %s, double %s\n", latency,
+                    new_latency, float_passed ? "passed" : "FAILED", double_passed ? "passed" : "FAILED");
+
+        failures += !float_passed + !double_passed;
+    }
+
+    for (const int num_workers : { 0, 2 })
+    {
+        const bool float_passed  = testStackMatchesGraph<float> (num_workers);
+        const bool double_passed = testStackMatchesGraph<double>(num_workers);
+        std::printf("Stack and graph sound the same, %d workers: float %s, double %s\n", num_workers,
+                    float_passed ? "passed" : "FAILED", double_passed ? "passed" : "FAILED");
+
+        failures += !float_passed + !double_passed;
+    }
+
+    return failures == 0 ? 0 : 1;
+}